@@ -40,10 +40,12 @@
 #define RTC_ADDRESS 0x68
 #define AHT21_ADDRESS 0x38
 // #define BMP280_ADDRESS 0x76  // Commented out to avoid conflict with library
+#define BMP280_I2C_ADDRESS 0x76   // SDO low - used for direct status register polls
 #define BH1750_ADDRESS 0x23
 #define DISPLAY_GREEN_ADDRESS 0x70
 #define DISPLAY_AMBER_ADDRESS 0x71
 #define DISPLAY_RED_ADDRESS 0x72
+#define EXT_EEPROM_ADDRESS 0x57      // AT24C32 on the DS3231 breakout (A0-A2 pulled high)
 
 // Display Brightness Compensation (compensates for LED color variations)
 #define DISPLAY_GREEN_BRIGHTNESS 1   // Green LEDs are very bright
@@ -55,6 +57,55 @@
 #define SENSOR_READ_INTERVAL 30000   // 30 seconds
 #define DISPLAY_UPDATE_INTERVAL 1000 // 1 second
 #define CHIME_CHECK_INTERVAL 60000   // 1 minute
+#define CHIME_FREQUENCY_DEFAULT 2    // Chimes per hour: 1, 2 (with the half hour) or 4
+
+// Ambient Light (BH1750)
+#define LIGHT_FAST_READ_INTERVAL 250   // Low-res (16ms) reads for display dimming
+#define LIGHT_PRECISE_LEAD_TIME 1000   // Start high-res one-shot this long before a logged read
+#define LIGHT_MTREG_TARGET_COUNTS 20000 // Auto-range aims the high-res raw count here
+#define LIGHT_MTREG_LOW_COUNTS 1000    // Below this, raise MTreg (dark room)
+#define LIGHT_MTREG_HIGH_COUNTS 50000  // Above this, lower MTreg (bright room)
+
+// I2C Bus
+#define I2C_TIMEOUT_US 5000UL             // Longest any single Wire transaction may block
+#define DISPLAY_SETUP_REFRESH_INTERVAL 10000 // Re-assert HT16K33 oscillator/brightness/display-on
+#define DISPLAY_SETUP_RETRY_BASE_MS 1000UL   // Re-assert delay while NACKs continue, doubled per retry up to the interval
+
+// Binary Telemetry (frame format in TelemetryProtocol.h)
+#define TELEMETRY_ENABLED 1                  // 0 silences telemetry and the log, leaving the console
+#define TELEMETRY_TX_BUFFER 128              // TX ring bytes, power of two
+#define TELEMETRY_PROFILE_INTERVAL 300000UL  // Loop profile message every 5 minutes
+#define HISTORY_TRANSFER_TIMEOUT_MS 2000UL   // Import gives up after this long without a frame
+#define LOG_LEVEL LOG_LEVEL_INFO             // Log sites above this level compile to nothing (Log.h)
+
+// Serial Console (command table in main.cpp)
+#define CONSOLE_NAME_LENGTH 10               // Longest command name + 1
+#define CONSOLE_USAGE_LENGTH 32              // Help text per command, in flash
+#define CONSOLE_MAX_ARGS 6                   // "time 2026-10-18 14:30:00" is six numbers
+
+// Settings Menu (item table in main.cpp)
+#define MENU_LABEL_LENGTH 13                 // List view, 12 characters + NUL
+#define MENU_TAG_LENGTH 5                    // Edit view, on the green display
+
+// Encoder acceleration: detents closer together than these move a menu value
+// by its row's curve (SettingsMenu.cpp) instead of one step
+#define ENCODER_INTERVAL_IDLE 0xFFFF         // Interval after a pause or a reversal
+#define ACCEL_SLOW_MS 50                     // About one turn a second (20 detents)
+#define ACCEL_FAST_MS 25
+#define ACCEL_FASTEST_MS 12
+
+// Sensor Fault Handling
+#define SENSOR_READ_ATTEMPTS 2         // Immediate attempts per device per read
+#define AHT21_MEASURE_TIMEOUT_MS 150   // Busy-poll limit for one AHT21 conversion (~80ms typical)
+#define SENSOR_OFFLINE_THRESHOLD 3     // Consecutive failed reads before a device is offline
+#define SENSOR_RETRY_BASE_MS 30000UL   // First retry delay, doubled per failure
+#define SENSOR_RETRY_MAX_MS 600000UL   // Backoff cap (10 minutes)
+
+// Barometric Pressure (BMP280)
+// Forced mode runs one conversion per sensor read and sleeps in between;
+// comment out to return to continuous normal mode (125ms standby).
+#define BMP280_FORCED_MODE
+#define BMP280_DEFAULT_PROFILE PRESSURE_PROFILE_STANDARD
 
 // Temperature Ranges for Four-Letter Words (Fahrenheit)
 #define TEMP_FROZ_MAX 19    // FROZ: <= 19°F
@@ -74,10 +125,98 @@
 #define COMFORT_RED_MIN 20    // COLD range start
 #define COMFORT_RED_MAX 34    // COLD range end, also HOT+ ranges
 
-// Data Storage - Optimized for Arduino Nano memory constraints
-#define MAX_HOURLY_RECORDS 24    // 24 hours of hourly data
-#define MAX_DAILY_RECORDS 7      // 7 days of daily data
+// Data Storage - round-robin tiers, each consolidated from the one below.
+// Records are packed to 9 bytes (see PackedRecord). The 5-minute and weekly
+// rings are in SRAM; hours and days are read from the EEPROM journal, so
+// their depths need the AT24C32 (without it: the newest 20 hours and 7 days).
+#define FIVE_MINUTE_RECORDS 24   // 2 hours of 5-minute data
+#define MAX_HOURLY_RECORDS 168   // 7 days of hourly data
+#define MAX_DAILY_RECORDS 28     // 4 weeks of daily data
+#define MAX_WEEKLY_RECORDS 8     // 8 weeks of weekly data
+#define LIGHT_CODES_PER_OCTAVE 14  // Light is stored on a log scale (~5% steps)
+#define WINDOW_STATS_HOURS 24    // Windows up to this long are answered from a table rebuilt each hour
+#define TREND_WINDOW_HOURS 4     // Hourly records in the least-squares trend fit (3 hour span)
+#define TREND_MIN_POINTS 3       // Fewer records than this leaves the trend at zero
+#define TREND_MIN_FIT 0.8        // R^2 below this is too noisy to raise an alert (one outlier in four hours fits 0.6)
+
+// Alert rates - defaults for the settings, where either can be changed or
+// set to 0 to turn that alert off. The hourly trend and the fast path both
+// raise past them.
+#define ALERT_PRESSURE_RATE 20     // Falling, 0.1 hPa/hour
+#define ALERT_TEMPERATURE_RATE 50  // 0.1 °F/hour, either direction
+
+// Fast alert path - a one-minute ring so sharp changes alert within minutes
+// instead of waiting for hourly records. Raise after FAST_ALERT_DEBOUNCE
+// consecutive minutes past the alert rate; clear once back inside the clear fraction of it.
+#define FAST_ALERT_MINUTES 30      // Minutes in the ring and the slope fit
+#define FAST_ALERT_MIN_POINTS 15   // Minutes of data before the fast path can fire
+#define FAST_ALERT_DEBOUNCE 3
+#define FAST_PRESSURE_CLEAR 0.5    // Of ALERT_PRESSURE_RATE (1 hPa/hour at the default)
+#define FAST_TEMP_CLEAR 0.6        // Of ALERT_TEMPERATURE_RATE (3 °F/hour)
+
+// Local forecast - Zambretti letters from sea-level pressure, 3-hour
+// tendency and season, plus a learned daily temperature curve
+#define STATION_ALTITUDE_M 0          // Height above sea level; Zambretti expects sea-level pressure
+#define SOUTHERN_HEMISPHERE 0         // Swaps the summer months used by the season correction
+#define FORECAST_TENDENCY_DHPA 16     // 3-hour change (0.1 hPa) beyond which pressure is rising/falling
+#define FORECAST_HORIZON_HOURS 3      // Temperature prediction shown on the trends screen
+#define FORECAST_CHANGE_HOURS 3       // detectWeatherChange compares against the forecast this long ago
+#define FORECAST_CHANGE_LETTERS 3     // ...and reports a shift of at least this many letters
+#define DIURNAL_WEIGHT 4              // Each day moves the temperature curve 1/N of the way (~last N days)
+
+// EEPROM History Journal - header + one self-checking 8-byte slot per record
+// (8 + 27 * 8 = 224 bytes, the settings take the last 32 of the ATmega4809's
+// 256). Holds the newest 20 hours and 7 days without light, and is the
+// hourly and daily tiers when there is no AT24C32.
 #define EEPROM_DATA_START 0
+#define EEPROM_LAYOUT_VERSION 3
+#define EEPROM_HEADER_SIZE 8
+#define EEPROM_RECORD_SIZE 8
+#define EEPROM_HOURLY_SLOTS 20
+#define EEPROM_DAILY_SLOTS 7
+
+// Persistent Settings - one small record after the journal, kept twice so a
+// torn write always leaves a good copy (see Settings.h)
+#define SETTINGS_EEPROM_START (EEPROM_DATA_START + EEPROM_HEADER_SIZE + (EEPROM_HOURLY_SLOTS + EEPROM_DAILY_SLOTS) * EEPROM_RECORD_SIZE)
+#define SETTINGS_COPY_SIZE 16
+#define SETTINGS_SCHEMA_VERSION 1
+
+// External History Store (AT24C32) - when the chip answers, the journal moves
+// there: a 32-byte header page, then 8-byte slots mapped by period (slot =
+// hour % EXT_HISTORY_HOURLY_SLOTS). The internal EEPROM then holds only
+// settings, and hourly and daily queries read the chip.
+#define EXT_EEPROM_SIZE 4096
+#define EXT_EEPROM_PAGE_SIZE 32
+#define EXT_EEPROM_WRITE_TIMEOUT_MS 20   // Longest write cycle (tWR is 10ms at 5V, 20ms at 2.7V)
+#define EXT_HISTORY_LAYOUT_VERSION 1
+#define EXT_HISTORY_HOURLY_SLOTS 480     // 20 days
+#define EXT_HISTORY_DAILY_SLOTS 28       // 4 weeks
+
+// History tiers, finest first
+enum HistoryTier {
+  TIER_FIVE_MINUTE,
+  TIER_HOURLY,
+  TIER_DAILY,
+  TIER_WEEKLY,
+  HISTORY_TIER_COUNT
+};
+
+// Channels kept by every history tier
+enum HistoryChannel {
+  CHANNEL_TEMPERATURE,
+  CHANNEL_HUMIDITY,
+  CHANNEL_PRESSURE,
+  CHANNEL_LIGHT,
+  HISTORY_CHANNEL_COUNT
+};
+
+// Percentiles tracked per channel for each hour and day
+enum Quantile {
+  QUANTILE_P10,
+  QUANTILE_MEDIAN,
+  QUANTILE_P90,
+  QUANTILE_COUNT
+};
 
 // Chime Types
 enum ChimeType {
@@ -98,6 +237,30 @@ enum MidiInstrument {
   INSTRUMENT_CHURCH_BELL = 14      // Same as tubular bells but clearer name
 };
 
+// Sensor devices on the I2C bus (index into per-device health)
+enum SensorDevice {
+  SENSOR_RTC = 0,
+  SENSOR_AHT21,
+  SENSOR_BMP280,
+  SENSOR_BH1750,
+  SENSOR_DEVICE_COUNT
+};
+
+// Device Health
+enum DeviceHealth {
+  DEVICE_OK = 0,
+  DEVICE_DEGRADED,   // Recent failures, re-initialized and retried with backoff
+  DEVICE_OFFLINE     // SENSOR_OFFLINE_THRESHOLD failures in a row
+};
+
+// BMP280 oversampling / IIR filter profiles
+// Max conversion time and average current at one forced read per 30s
+enum PressureProfile {
+  PRESSURE_PROFILE_FAST = 0,          // T x1,  P x1,  filter off:  6.4ms, ~0.25uA
+  PRESSURE_PROFILE_STANDARD,          // T x1,  P x4,  filter off: 13.3ms, ~0.42uA
+  PRESSURE_PROFILE_ULTRA_LOW_NOISE    // T x2,  P x16, filter x4:  43.2ms, ~1.1uA
+};
+
 // Display Modes
 enum DisplayMode {
   MODE_CLOCK = 0,
@@ -109,20 +272,6 @@ enum DisplayMode {
   MODE_SETTINGS
 };
 
-// Settings Menu Items
-enum SettingItem {
-  SETTING_TIME = 0,
-  SETTING_DATE,
-  SETTING_CHIME_TYPE,
-  SETTING_CHIME_INSTRUMENT,
-  SETTING_CHIME_FREQUENCY,
-  SETTING_SENSOR_SENSITIVITY,
-  SETTING_WEATHER_ALERTS,
-  SETTING_LIGHTING_EFFECTS,
-  SETTING_MOTOR_SETTINGS,
-  SETTING_EXIT
-};
-
 // Alert Types
 enum AlertType {
   ALERT_NONE = 0,
@@ -0,0 +1,77 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Telemetry.h"
+
+// ============================================================================
+// SERIAL CONSOLE
+// ============================================================================
+// Line commands over Serial: a name followed by up to CONSOLE_MAX_ARGS
+// integers, e.g. "bright 8" or "time 2026-10-18 14:30:00". Bytes are parsed
+// as they arrive, one per service() call, with numbers accumulated on the
+// fly - nothing but the name and the parsed values is kept, and the end of
+// the line dispatches straight from a command table in flash.
+// - Separators: space, tab, ',', ':', '/', and '-' after a digit
+// - Names are case-insensitive; a bad line is reported once at its end
+// - 0x00 (the telemetry frame delimiter) restarts the line, and a line
+//   with non-text bytes is dropped silently, so a host tool's frames never
+//   run as commands
+// - Replies are plain text, flushed around so they never split a frame
+// ============================================================================
+
+class Console;
+typedef void (*ConsoleHandler)(Console& console);
+
+// One entry of a PROGMEM command table
+struct ConsoleCommand {
+  char name[CONSOLE_NAME_LENGTH];
+  uint8_t minArgs;
+  uint8_t maxArgs;
+  ConsoleHandler handler;
+  char usage[CONSOLE_USAGE_LENGTH];  // Arguments and effect, for printHelp()
+};
+
+class Console {
+public:
+  void init(const ConsoleCommand* table, uint8_t count);  // table in PROGMEM
+  void service();  // Consume at most one received byte - call on every loop()
+  void setTelemetry(Telemetry* stream) { telemetry = stream; }
+  
+  // For handlers: the numbers on the line being dispatched
+  uint8_t getArgCount() { return argCount; }
+  int16_t getArg(uint8_t index) { return args[index]; }
+  
+  void printHelp();
+  void printUsage();  // Of the command being dispatched
+
+private:
+  enum State {
+    CONSOLE_NAME,    // Reading the command name
+    CONSOLE_GAP,     // Between tokens
+    CONSOLE_SIGN,    // After a leading '-'
+    CONSOLE_NUMBER,  // Reading digits
+    CONSOLE_ERROR,   // Skipping to the end of the line, then reporting it
+    CONSOLE_BINARY   // Skipping to the end of the line quietly
+  };
+  
+  const ConsoleCommand* commands;
+  uint8_t commandCount;
+  const ConsoleCommand* current;  // Entry being dispatched
+  Telemetry* telemetry;
+  
+  char name[CONSOLE_NAME_LENGTH];
+  uint8_t nameLength;
+  int16_t args[CONSOLE_MAX_ARGS];
+  uint8_t argCount;
+  uint8_t state;
+  bool negative;
+  
+  bool startNumber(bool isNegative);
+  void endLine();
+  void dispatch();
+  void reset();
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef CRC16_H
+#define CRC16_H
+
+#include <stdint.h>
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) - shared by the EEPROM
+// history image and anything else that needs to detect corrupted bytes
+
+#define CRC16_INIT 0xFFFF
+
+inline uint16_t crc16Update(uint16_t crc, uint8_t data) {
+  crc ^= (uint16_t)data << 8;
+  for (uint8_t i = 0; i < 8; i++) {
+    crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+  }
+  return crc;
+}
+
+#endif
@@ -2,22 +2,107 @@
 #define DATA_LOGGER_H
 
 #include <EEPROM.h>
+#include <string.h>
 #include "Sensors.h"  // This now includes our DateTime struct
 #include "Config.h"
+#include "ExternalEeprom.h"
 
-struct HourlyRecord {
-  DateTime timestamp;
-  float avgTemperature;
-  float avgHumidity;
-  float avgPressure;
-  float minTemperature;
-  float maxTemperature;
-  float minPressure;
-  float maxPressure;
+// O(1)-memory running statistics for one channel. Every sample is absorbed
+// as it arrives; mean and variance use Welford's update so long runs of
+// near-equal values (e.g. ~1000 hPa) don't lose precision to a float sum.
+struct ChannelAccumulator {
+  uint16_t count;
+  float mean;
+  float m2;        // Sum of squared deviations from the mean
+  float minValue;
+  float maxValue;
+  
+  void reset() {
+    count = 0;
+    mean = 0;
+    m2 = 0;
+    minValue = 0;
+    maxValue = 0;
+  }
+  
+  void add(float value) {
+    count++;
+    if (count == 1) {
+      minValue = value;
+      maxValue = value;
+    } else {
+      if (value < minValue) minValue = value;
+      if (value > maxValue) maxValue = value;
+    }
+    float delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+  }
+  
+  // Fold in another accumulator's samples (Chan et al. parallel update),
+  // as if they had been added one by one
+  void merge(const ChannelAccumulator& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+      *this = other;
+      return;
+    }
+    uint16_t total = count + other.count;
+    float delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * ((float)count * other.count / total);
+    if (other.minValue < minValue) minValue = other.minValue;
+    if (other.maxValue > maxValue) maxValue = other.maxValue;
+    count = total;
+  }
+  
+  float getSum() const { return mean * count; }
+  float getVariance() const { return count > 1 ? m2 / (count - 1) : 0; }
 };
 
-struct DailyRecord {
-  DateTime date;
+// Streaming 10th/50th/90th percentiles in constant memory: the extended P²
+// algorithm (Jain & Chlamtac, Raatikainen) keeps 9 markers at probabilities
+// 0, .05, .1, .3, .5, .7, .9, .95, 1 and nudges them with a parabolic fit as
+// samples arrive - 56 bytes per estimator. Heights stay float because the
+// per-sample nudges are often a fraction of any fixed-point step. The first
+// 9 samples are kept sorted and answered exactly.
+#define QUANTILE_MARKERS 9
+
+struct QuantileEstimator {
+  float height[QUANTILE_MARKERS];
+  uint16_t position[QUANTILE_MARKERS];  // 1-based sample rank of each marker
+  uint16_t count;
+  
+  void reset() { count = 0; }
+  void add(float value);
+  float get(Quantile quantile) const;  // NAN before any samples
+};
+
+// Stored form of a history record: a 16-bit offset from the tier's base
+// (hours, or 5-minute steps for TIER_FIVE_MINUTE), a 40-bit body of quantized
+// averages and min/max spreads, and a log-scale light average and spread
+// (layout in DataLogger.cpp). The first 7 bytes make up an EEPROM journal
+// slot, minus its commit marker.
+#define PACKED_RECORD_SIZE 9
+#define PACKED_EMPTY_OFFSET 0xFFFF
+#define PACKED_NO_LIGHT 0xFF
+
+struct PackedRecord {
+  uint8_t bytes[PACKED_RECORD_SIZE];
+  
+  uint16_t offset() const { return bytes[0] | (bytes[1] << 8); }
+  void setOffset(uint16_t offset) {
+    bytes[0] = offset & 0xFF;
+    bytes[1] = offset >> 8;
+  }
+  bool isEmpty() const { return offset() == PACKED_EMPTY_OFFSET; }
+  bool hasLight() const { return bytes[7] != PACKED_NO_LIGHT; }
+  void clear() { memset(bytes, 0xFF, sizeof(bytes)); }
+};
+
+// Decoded view returned by the getters, for any tier
+struct HistoryRecord {
+  DateTime timestamp;        // Start of the period
   float avgTemperature;
   float avgHumidity;
   float avgPressure;
@@ -25,68 +110,258 @@ struct DailyRecord {
   float maxTemperature;
   float minPressure;
   float maxPressure;
+  float avgLight;            // lux
+  float minLight;
+  float maxLight;
+  bool hasLight;             // False when no light reading landed in the period
+  
+  // Zeroed, with the month-0 timestamp that marks a missing period
+  void clear() {
+    *this = HistoryRecord();
+    timestamp = DateTime(2000, 0, 0);
+  }
+};
+
+typedef HistoryRecord HourlyRecord;
+typedef HistoryRecord DailyRecord;
+
+// Aggregates over the newest N hourly records in 0.01 fixed point, so the
+// table of every window up to WINDOW_STATS_HOURS stays small
+#define WINDOW_STATS_EMPTY 0xFFFF
+
+struct WindowStats {
+  uint16_t avgTemperature;   // (°F + 40) * 100, WINDOW_STATS_EMPTY = no records
+  uint16_t avgHumidity;      // % * 100
+  uint16_t avgPressure;      // (hPa - 800) * 100
+  uint16_t minTemperature;
+  uint16_t maxTemperature;
+  uint16_t minPressure;
+  uint16_t maxPressure;
 };
 
+// Least-squares slopes over the last TREND_WINDOW_HOURS of hourly records.
+// The fit values are R^2 (0 = noise, 1 = straight line); the flags are only
+// set when the fit reaches TREND_MIN_FIT.
 struct TrendData {
   float temperatureTrend;    // °F per hour
   float pressureTrend;       // hPa per hour
   float humidityTrend;       // % per hour
+  float temperatureFit;
+  float pressureFit;
+  float humidityFit;
+  uint8_t points;            // Records in the fit
   bool risingPressure;
   bool fallingPressure;
   bool rapidTempChange;
 };
 
+// Zambretti forecast letters A..Z as codes 0..25, settled fine to stormy
+#define FORECAST_NONE 0xFF
+
+struct ForecastData {
+  uint8_t code;                 // FORECAST_NONE until there is hourly data
+  int8_t tendency;              // -1 falling, 0 steady, 1 rising
+  float pressureTrend;          // hPa per hour
+  float temperatureTrend;       // °F per hour
+  float predictedTemperature;   // °F, FORECAST_HORIZON_HOURS ahead
+};
+
+// One-minute averages for the fast alert path, in 0.01 fixed point
+#define FAST_ALERT_MISSING (-32768)
+
+struct FastAlertState {
+  int16_t temperature[FAST_ALERT_MINUTES];  // °F * 100, slot = minute % FAST_ALERT_MINUTES
+  int16_t pressure[FAST_ALERT_MINUTES];     // (hPa - 1000) * 100
+  uint32_t minute;                          // Minute being accumulated
+  float temperatureSum;
+  float pressureSum;
+  uint8_t temperatureCount;
+  uint8_t pressureCount;
+  float temperatureTrend;                   // °F per hour over the ring
+  float pressureTrend;                      // hPa per hour over the ring
+  uint8_t temperatureDebounce;
+  uint8_t pressureDebounce;
+  bool temperatureAlert;
+  bool pressureAlert;
+  bool started;
+};
+
 class DataLogger {
 private:
-  HourlyRecord hourlyData[24];     // Reduced to 24 hours instead of 168
-  DailyRecord dailyData[7];        // Reduced to 7 days instead of 30
+  PackedRecord fiveMinuteData[FIVE_MINUTE_RECORDS];
+  PackedRecord weeklyData[MAX_WEEKLY_RECORDS];
+  PackedRecord newestRecord[2];                // Newest hour and day, with the light the journal doesn't keep
+  uint32_t newestPeriod[HISTORY_TIER_COUNT];  // Newest stored period; a period lives in slot period % size
+  uint32_t fiveMinuteBase;     // 5-minute ring offsets count 5-minute steps from this
+  uint32_t historyBaseHour;    // Other rings count hours from this
+  
+  // The period in progress for each tier. Samples land in the 5-minute
+  // accumulators; closing a period folds it into the tier above, so every
+  // roll-up costs O(1) per sample.
+  ChannelAccumulator pending[HISTORY_TIER_COUNT][HISTORY_CHANNEL_COUNT];
+  uint32_t pendingPeriod[HISTORY_TIER_COUNT];
+  bool periodsStarted;
+  
+  // windowStats[h - 1] covers the last h hours
+  WindowStats windowStats[WINDOW_STATS_HOURS];
+  
+  // Refitted when an hour closes; alert checks only read it
+  TrendData trends;
+  FastAlertState fast;
+  float pressureAlertRate;     // hPa/hour falling, 0 = off
+  float temperatureAlertRate;  // °F/hour either way, 0 = off
   
-  uint8_t currentHourlyIndex;
-  uint8_t currentDailyIndex;
+  // Percentiles for the hour and day in progress, and the last closed ones
+  QuantileEstimator pendingQuantiles[2][HISTORY_CHANNEL_COUNT];
+  float closedQuantiles[2][HISTORY_CHANNEL_COUNT][QUANTILE_COUNT];
   
-  SensorData currentHourSamples[12];  // Reduced to 12 samples per hour instead of 60
-  uint8_t currentSampleIndex;
+  // Forecast state, refreshed when an hour closes
+  int16_t diurnal[24];          // Each hour of day's offset from the 24 h mean, 0.1 °F
+  uint8_t forecastCode;
+  int8_t forecastTendency;
+  uint8_t pastForecast[FORECAST_CHANGE_HOURS];  // Oldest first
   
   unsigned long lastLogTime;
-  DateTime lastHourLogged;
-  DateTime lastDayLogged;
   
-  void logHourlyData();
-  void logDailyData();
-  void shiftArray();
-  void saveToEEPROM();
-  void loadFromEEPROM();
+  // EEPROM journal state
+  ExternalEeprom externalEeprom;
+  bool externalHistory;        // The journal lives on the AT24C32 instead
+  bool externalDailyPending;   // A closed day's slot waits for the next sample
+  uint32_t externalDailyLast;  // ...and empties abandoned days up to this one
+  uint8_t eepromHourlySlot;    // Next journal slot to overwrite in each ring
+  uint8_t eepromDailySlot;
+  bool eepromImageValid;       // For whichever store holds the journal
+  unsigned long restoreMicros;
+  uint8_t pageCache[EXT_EEPROM_PAGE_SIZE];  // Last AT24C32 page a history read fetched
+  uint16_t cachedPage;                      // ...and its address, EXT_EEPROM_SIZE for none
+  
+  void addSample(HistoryChannel channel, float value);
+  void closePeriod(HistoryTier tier);
+  void storePeriod(HistoryTier tier, const HistoryRecord& previous);
+  void resetPending(HistoryTier tier);
+  void clearClosedQuantiles();
+  
+  // Packed storage
+  PackedRecord* ringData(HistoryTier tier);
+  uint32_t tierBase(HistoryTier tier);
+  bool findRecord(HistoryTier tier, uint32_t period, PackedRecord& packed);
+  bool recordAt(HistoryTier tier, uint8_t ago, PackedRecord& packed);
+  bool hasRecord(HistoryTier tier, uint8_t ago);
+  bool getRecordValues(HistoryTier tier, uint8_t ago, HistoryRecord& record);
+  DateTime recordTime(HistoryTier tier, uint16_t offset);
+  void storeRecord(HistoryTier tier, uint32_t period, const HistoryRecord& record);
+  bool dropNewerThan(HistoryTier tier, uint32_t period);
+  bool ensureHistoryBase(uint32_t hour);
+  bool ensureFiveMinuteBase(uint32_t step);
+  
+  // Windowed statistics
+  void scanHourly(uint8_t hours, WindowStats* out, bool everyHour);
+  void rebuildWindowStats();
+  bool getWindowStats(uint8_t hours, WindowStats& stats);
+  void updateTrends();
+  void hourlyHistoryChanged(bool appended = false);
+  
+  // Forecast
+  uint8_t hourOfDay(uint8_t ago);
+  void learnDiurnal(uint8_t ago, int16_t temperature, int16_t mean);
+  void rebuildDiurnal();
+  void updateForecast(bool appended);
+  
+  // Fast alert path
+  void resetFastAlerts();
+  void updateFastAlerts(const SensorData& data, uint32_t minute);
+  void closeMinute();
+  float fastSlope(const int16_t* ring);
+  
+  // EEPROM journal
+  void saveToJournal(HistoryTier tier, const PackedRecord& packed);
+  void startStore();
+  void rebaseStore(uint32_t oldBase);
+  void writeSlot(uint8_t slot, const PackedRecord& packed);
+  void writeHeader();
+  void findNewestSlot(uint8_t firstSlot, uint8_t slotCount, HistoryTier tier, uint8_t& nextSlot);
+  void migrateLayout2();
+  bool loadFromEEPROM();
+  bool loadFromInternal();
+  
+  // External history store
+  bool writeExternal(uint16_t addr, const uint8_t* data, uint16_t length);
+  bool writeExternalHeader();
+  void writeExternalRange(HistoryTier tier, uint32_t first, uint32_t last);
+  void saveExternalRecords(HistoryTier tier, uint32_t period, uint32_t last);
+  void copyJournalToExternal(uint8_t hourlySlots);
+  bool loadFromExternal();
+  void findNewestExternal(HistoryTier tier);
+  bool readExternalRecord(HistoryTier tier, uint32_t period, PackedRecord& packed);
 
 public:
   bool init();
   void update(SensorData currentData);
   
-  // Data retrieval
-  HourlyRecord getHourlyRecord(uint8_t hoursAgo);
-  DailyRecord getDailyRecord(uint8_t daysAgo);
+  // Data retrieval - periods (5 minutes, hours, days, weeks) before the
+  // newest closed one. A period with no record (power off, RTC jump) comes
+  // back zeroed with a zero timestamp. Hours and days are read in place from
+  // the journal: the AT24C32 when fitted, else the internal EEPROM, which
+  // holds only the newest 20 hours and 7 days. The journal has no light, so
+  // only the newest hour and day carry it.
+  HistoryRecord getRecord(HistoryTier tier, uint8_t ago);
+  bool getRecordAt(HistoryTier tier, DateTime time, HistoryRecord& record);  // O(1) by timestamp; hourly goes back 20 days with the AT24C32
+  HourlyRecord getHourlyRecord(uint8_t hoursAgo) { return getRecord(TIER_HOURLY, hoursAgo); }
+  DailyRecord getDailyRecord(uint8_t daysAgo) { return getRecord(TIER_DAILY, daysAgo); }
+  uint8_t getTierSize(HistoryTier tier);
   
-  // Statistics
-  float getAverageTemperature(uint8_t hours);
-  float getAveragePressure(uint8_t hours);
-  float getAverageHumidity(uint8_t hours);
+  // Statistics over the last N hours. Windows up to WINDOW_STATS_HOURS are
+  // O(1) table lookups; longer ones scan the hourly journal, and anything past
+  // it falls back to the daily tier.
+  float getAverage(HistoryChannel channel, uint8_t hours);
+  float getAverageTemperature(uint8_t hours) { return getAverage(CHANNEL_TEMPERATURE, hours); }
+  float getAveragePressure(uint8_t hours) { return getAverage(CHANNEL_PRESSURE, hours); }
+  float getAverageHumidity(uint8_t hours) { return getAverage(CHANNEL_HUMIDITY, hours); }
+  float getAverageLight(uint8_t hours) { return getAverage(CHANNEL_LIGHT, hours); }
   
   float getMinTemperature(uint8_t hours);
   float getMaxTemperature(uint8_t hours);
   float getMinPressure(uint8_t hours);
   float getMaxPressure(uint8_t hours);
   
-  // Trend analysis
-  TrendData calculateTrends();
-  bool detectWeatherChange();
+  // Period in progress for a tier, including the unfinished periods below it
+  ChannelAccumulator getCurrentPeriod(HistoryTier tier, HistoryChannel channel);
+  
+  // Percentiles of the last closed (or, with current, the unfinished) hour
+  // or day. Robust to the single glitches that skew average/min/max.
+  // False for other tiers or when the period had no samples.
+  bool getQuantile(HistoryTier tier, HistoryChannel channel, Quantile quantile,
+                   float& value, bool current = false);
+  
+  // Trend analysis - cached, so these are field reads
+  TrendData calculateTrends() { return trends; }
+  bool detectWeatherChange();   // Forecast moved FORECAST_CHANGE_LETTERS in FORECAST_CHANGE_HOURS
   float predictTemperature(uint8_t hoursAhead);
+  ForecastData getForecast();
   
-  // Alerts
+  // Alerts - the fast one-minute path or the hourly trend, whichever fires
   bool checkPressureAlert();
   bool checkTemperatureAlert();
   bool checkRapidChange();
+  void setAlertRates(uint8_t pressure, uint8_t temperature);  // 0.1 hPa/hour and 0.1 °F/hour, 0 = off
+  float getFastPressureTrend() { return fast.pressureTrend; }
+  float getFastTemperatureTrend() { return fast.temperatureTrend; }
+  
+  // Persistence
+  bool hasExternalHistory() { return externalHistory; }
+  unsigned long getRestoreMicros() { return restoreMicros; }
+  
+  // Raw image of whichever store holds the journal, for bulk export and
+  // import (HistoryTransfer). Addresses are relative to the image start.
+  bool syncStore();             // Start an empty image if there is none, before export
+  uint8_t getStoreLayout();     // Journal layout version of the image
+  uint16_t getStoreSize();
+  bool readStore(uint16_t addr, uint8_t* data, uint8_t length);
+  bool writeStore(uint16_t addr, const uint8_t* data, uint8_t length);
+  void invalidateStore();       // Uncommit the header until an import completes
+  bool reloadFromStore();       // Drop RAM history and state, then take up the image
   
   // Data management
-  void seedCurrentData(const SensorData& data);  // Seed all history with current values to prevent false alerts on startup
   void clearAllData();
   bool isDataValid();
   uint8_t getDataAge();  // Hours since oldest data
@@ -4,6 +4,7 @@
 #include "HT16K33Disp.h"
 #include "Config.h"
 #include "Sensors.h"
+#include "DataLogger.h"
 
 class DisplayManager {
 private:
@@ -13,12 +14,23 @@ private:
   DisplayMode currentMode;
   uint8_t rollingIndex;
   unsigned long rollingTimer;
+  uint8_t currentBrightness;  // Last base level applied (1-15)
+  uint8_t brightnessOverride; // Fixed base level, 0 = follow ambient light
+  byte brightnessLevels[3];   // Per-display levels currently applied (Green, Amber, Red)
+  unsigned long lastSetupRefresh;
+  unsigned int lastErrorTotal;
+  uint8_t setupRetries;       // Re-asserts since the displays last ACKed everything
+  
+  void refreshDisplaySetup();
   
   // Alert display state
   bool displayingAlert;
   AlertType currentAlertType;
   unsigned long alertDisplayStart;
   
+  ForecastData forecast;  // Latest from DataLogger, shown on the trends screen
+  DataLogger* dataLogger;  // Percentiles for the history screen
+  
   void clearAllDisplays();
   void displayString(const char* text);
   void displayScrollingString(const char* text, int showDelay = 100, int scrollDelay = 100);
@@ -30,9 +42,6 @@ private:
   void displayRollingHistorical();
   void displayRollingTrends();
   void displaySettings();
-  void displaySettingsMenu(SettingItem currentSetting);
-  void displaySettingsInterface(SettingItem currentSetting, int settingTimeComponent, 
-                                int settingDateComponent, DateTime pendingDateTime);
   
   // Utility functions
   void formatTime(DateTime time, char* buffer);
@@ -42,9 +51,7 @@ private:
 public:
   bool init();
   void update(SensorData sensorData);
-  void updateSettings(SensorData sensorData, bool settingsMode, SettingItem currentSetting, 
-                      int settingTimeComponent, int settingDateComponent, DateTime pendingDateTime, 
-                      bool editingSettingValue);
+  void showMenu(const char* text);  // A SettingsMenu render, in place of the normal update
   void setMode(DisplayMode mode);
   DisplayMode getCurrentMode();
   bool isTimeToUpdate();
@@ -53,15 +60,23 @@ public:
   void displayTimeOnly(DateTime time);
   void displayDateOnly(DateTime time);
   
+  // Bus health
+  unsigned int getDisplayErrorCount(uint8_t display);  // 0=Green, 1=Amber, 2=Red
+  
   // Brightness control
   void setBrightness(uint8_t brightness);
   void adjustBrightnessForAmbientLight(float lightLevel);
+  void setBrightnessOverride(uint8_t brightness);  // 1-15 holds that level, 0 returns to ambient
+  uint8_t getBrightnessOverride() { return brightnessOverride; }
+  uint8_t getBrightness() { return currentBrightness; }
   
   // Special displays
   void showStartupMessage();
   void showError(const char* errorCode);
   void showInitFailure(const char* causes);  // Shows "F " + up to 10 chars of failure cause
-  void showSetting(SettingItem setting, int value);
+  
+  void setForecast(const ForecastData& data) { forecast = data; }
+  void setDataLogger(DataLogger* logger) { dataLogger = logger; }
   
   // Alert displays
   void showAlert(AlertType alertType);
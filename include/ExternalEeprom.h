@@ -0,0 +1,43 @@
+#ifndef EXTERNAL_EEPROM_H
+#define EXTERNAL_EEPROM_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "Config.h"
+
+// ============================================================================
+// AT24C32 EEPROM (DS3231 breakout, 4 KB)
+// ============================================================================
+// - Writes go out one 32-byte page per transaction; a write that crosses a
+//   page boundary is split, since the chip wraps inside the page
+// - After a write the chip NACKs its address for up to tWR; the next access
+//   ACK-polls for it instead of sleeping a fixed delay, and skips the poll
+//   entirely once tWR has certainly passed
+// - Reads are sequential, chunked to the Wire buffer
+// ============================================================================
+
+class ExternalEeprom {
+public:
+  ExternalEeprom();
+  
+  bool begin(uint8_t address = EXT_EEPROM_ADDRESS);  // Returns true if the chip ACKs
+  bool isPresent() { return present; }
+  
+  bool read(uint16_t addr, uint8_t* data, uint16_t length);
+  bool write(uint16_t addr, const uint8_t* data, uint16_t length);
+  bool waitReady();  // ACK-poll until the last write cycle has finished
+  
+  // Page write transactions since begin(), for checking the write budget
+  uint16_t getPageWrites() { return pageWrites; }
+
+private:
+  uint8_t address;
+  bool present;
+  bool writePending;
+  unsigned long lastWriteMillis;
+  uint16_t pageWrites;
+  
+  bool writePage(uint16_t addr, const uint8_t* data, uint8_t length);
+};
+
+#endif
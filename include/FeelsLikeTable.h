@@ -0,0 +1,57 @@
+#ifndef FEELS_LIKE_TABLE_H
+#define FEELS_LIKE_TABLE_H
+
+#include <Arduino.h>
+
+// NOAA heat index (Rothfusz regression, before the low/high humidity
+// adjustments) precomputed on a 1°F x 4% RH grid and stored in flash.
+// Values are hundredths of a degree Fahrenheit.
+//
+// Rows:    temperature 80..110°F in 1°F steps
+// Columns: relative humidity 0..100% in 4% steps
+//
+// Bilinear interpolation over this grid stays within 0.09°F of the
+// polynomial everywhere in the table's range. Temperatures above the
+// table fall back to evaluating the polynomial directly.
+
+#define FEELS_LIKE_TABLE_MIN_F 80
+#define FEELS_LIKE_TABLE_MAX_F 110
+#define FEELS_LIKE_TABLE_ROWS 31       // (MAX_F - MIN_F) / 1°F + 1
+#define FEELS_LIKE_TABLE_COLS 26       // 100% / 4% + 1
+#define FEELS_LIKE_TABLE_RH_SCALE 64   // 256 / 4% - humidity to 8.8 fixed-point column index
+
+const uint16_t feelsLikeTable[FEELS_LIKE_TABLE_ROWS][FEELS_LIKE_TABLE_COLS] PROGMEM = {
+  { 7778,  7790,  7804,  7820,  7838,  7859,  7881,  7906,  7933,  7962,  7993,  8026,  8062,  8099,  8139,  8181,  8225,  8271,  8320,  8370,  8423,  8478,  8535,  8594,  8655,  8719},  // 80 F
+  { 7873,  7875,  7880,  7890,  7904,  7921,  7942,  7967,  7996,  8029,  8065,  8106,  8150,  8198,  8250,  8306,  8366,  8429,  8497,  8568,  8643,  8722,  8805,  8892,  8982,  9077},  // 81 F
+  { 7966,  7959,  7958,  7962,  7971,  7986,  8007,  8033,  8065,  8102,  8145,  8194,  8248,  8307,  8372,  8443,  8519,  8601,  8688,  8781,  8879,  8983,  9092,  9207,  9328,  9454},  // 82 F
+  { 8058,  8043,  8036,  8035,  8042,  8056,  8077,  8105,  8140,  8183,  8233,  8291,  8355,  8427,  8506,  8592,  8685,  8786,  8893,  9008,  9131,  9260,  9397,  9541,  9692,  9850},  // 83 F
+  { 8149,  8127,  8114,  8110,  8114,  8128,  8150,  8182,  8222,  8271,  8329,  8396,  8472,  8556,  8650,  8752,  8864,  8984,  9113,  9251,  9398,  9554,  9719,  9892, 10075, 10266},  // 84 F
+  { 8238,  8210,  8193,  8186,  8190,  8204,  8228,  8264,  8309,  8366,  8433,  8510,  8598,  8696,  8806,  8925,  9055,  9196,  9347,  9509,  9681,  9864, 10057, 10261, 10476, 10701},  // 85 F
+  { 8326,  8293,  8272,  8264,  8267,  8283,  8311,  8351,  8403,  8467,  8544,  8633,  8734,  8847,  8972,  9110,  9259,  9421,  9595,  9782,  9980, 10191, 10413, 10648, 10896, 11155},  // 86 F
+  { 8413,  8376,  8353,  8343,  8347,  8366,  8397,  8443,  8503,  8576,  8663,  8764,  8879,  9008,  9150,  9306,  9476,  9660,  9858, 10069, 10295, 10534, 10787, 11053, 11334, 11628},  // 87 F
+  { 8498,  8458,  8433,  8424,  8430,  8451,  8488,  8541,  8609,  8692,  8790,  8904,  9034,  9179,  9339,  9515,  9706,  9913, 10135, 10372, 10625, 10893, 11177, 11476, 11791, 12121},  // 88 F
+  { 8582,  8540,  8515,  8506,  8515,  8541,  8584,  8644,  8720,  8814,  8925,  9053,  9198,  9360,  9539,  9735,  9948, 10179, 10426, 10690, 10971, 11269, 11585, 11917, 12266, 12633},  // 89 F
+  { 8665,  8621,  8596,  8590,  8603,  8634,  8683,  8751,  8838,  8944,  9068,  9211,  9372,  9552,  9751,  9968, 10204, 10458, 10731, 11023, 11333, 11662, 12009, 12376, 12760, 13164},  // 90 F
+  { 8746,  8702,  8679,  8676,  8693,  8730,  8787,  8865,  8962,  9080,  9219,  9377,  9555,  9754,  9973, 10212, 10471, 10751, 11051, 11371, 11711, 12071, 12451, 12852, 13273, 13714},  // 91 F
+  { 8826,  8783,  8762,  8762,  8785,  8829,  8895,  8983,  9093,  9224,  9377,  9552,  9748,  9967, 10207, 10468, 10752, 11057, 11384, 11733, 12104, 12496, 12910, 13346, 13804, 14283},  // 92 F
+  { 8904,  8863,  8845,  8851,  8880,  8932,  9008,  9107,  9229,  9374,  9543,  9735,  9951, 10189, 10451, 10737, 11045, 11377, 11733, 12111, 12513, 12938, 13387, 13858, 14354, 14872},  // 93 F
+  { 8981,  8943,  8929,  8941,  8977,  9038,  9124,  9235,  9371,  9532,  9717,  9927, 10162, 10422, 10707, 11017, 11351, 11711, 12095, 12504, 12938, 13397, 13880, 14389, 14922, 15480},  // 94 F
+  { 9057,  9022,  9014,  9032,  9077,  9148,  9246,  9369,  9520,  9696,  9899, 10128, 10384, 10666, 10974, 11309, 11670, 12058, 12472, 12912, 13378, 13871, 14391, 14936, 15509, 16107},  // 95 F
+  { 9131,  9101,  9099,  9125,  9179,  9261,  9371,  9509,  9674,  9867, 10089, 10338, 10615, 10920, 11252, 11613, 12002, 12418, 12862, 13335, 13835, 14363, 14919, 15502, 16114, 16753},  // 96 F
+  { 9204,  9180,  9185,  9220,  9284,  9378,  9501,  9653,  9835, 10046, 10286, 10556, 10855, 11184, 11542, 11929, 12346, 12792, 13268, 13772, 14307, 14870, 15464, 16086, 16738, 17419},  // 97 F
+  { 9275,  9258,  9272,  9316,  9391,  9498,  9635,  9802, 10001, 10231, 10491, 10783, 11105, 11458, 11842, 12257, 12703, 13179, 13687, 14225, 14795, 15395, 16026, 16688, 17380, 18104},  // 98 F
+  { 9346,  9336,  9359,  9414,  9501,  9621,  9773,  9957, 10174, 10423, 10705, 11018, 11365, 11743, 12154, 12597, 13073, 13580, 14121, 14693, 15298, 15935, 16605, 17307, 18041, 18808},  // 99 F
+  { 9414,  9413,  9446,  9513,  9613,  9747,  9915, 10117, 10353, 10622, 10926, 11263, 11633, 12038, 12477, 12949, 13455, 13995, 14569, 15176, 15817, 16493, 17202, 17944, 18721, 19531},  // 100 F
+  { 9482,  9490,  9534,  9613,  9728,  9877, 10062, 10282, 10538, 10828, 11154, 11516, 11912, 12344, 12811, 13313, 13850, 14423, 15031, 15674, 16352, 17066, 17815, 18599, 19419, 20274},  // 101 F
+  { 9548,  9567,  9623,  9716,  9845, 10011, 10213, 10453, 10729, 11042, 11391, 11777, 12200, 12659, 13156, 13688, 14258, 14864, 15507, 16187, 16903, 17656, 18446, 19272, 20136, 21035},  // 102 F
+  { 9613,  9643,  9712,  9819,  9964, 10148, 10369, 10628, 10926, 11262, 11635, 12047, 12497, 12986, 13512, 14076, 14679, 15319, 15998, 16715, 17470, 18263, 19094, 19963, 20871, 21816},  // 103 F
+  { 9676,  9719,  9802,  9925, 10086, 10288, 10529, 10809, 11129, 11489, 11888, 12326, 12804, 13322, 13879, 14476, 15112, 15788, 16503, 17258, 18052, 18886, 19759, 20672, 21625, 22617},  // 104 F
+  { 9738,  9795,  9893, 10031, 10211, 10431, 10693, 10995, 11338, 11723, 12148, 12614, 13121, 13669, 14258, 14887, 15558, 16270, 17022, 17816, 18650, 19525, 20442, 21399, 22397, 23436},  // 105 F
+  { 9799,  9870,  9984, 10140, 10338, 10578, 10861, 11186, 11554, 11964, 12416, 12910, 13447, 14026, 14647, 15311, 16017, 16765, 17556, 18389, 19264, 20181, 21141, 22143, 23188, 24275},  // 106 F
+  { 9858,  9945, 10075, 10249, 10467, 10729, 11034, 11383, 11775, 12212, 12691, 13215, 13782, 14393, 15048, 15746, 16488, 17274, 18104, 18977, 19893, 20854, 21858, 22906, 23997, 25132},  // 107 F
+  { 9916, 10019, 10167, 10361, 10599, 10882, 11211, 11584, 12003, 12466, 12975, 13529, 14127, 14771, 15460, 16194, 16973, 17797, 18666, 19580, 20539, 21543, 22592, 23686, 24825, 26010},  // 108 F
+  { 9972, 10093, 10260, 10473, 10733, 11040, 11392, 11791, 12237, 12728, 13266, 13851, 14482, 15159, 15883, 16653, 17470, 18333, 19242, 20198, 21200, 22248, 23343, 24484, 25672, 26906},  // 109 F
+  {10027, 10167, 10353, 10588, 10870, 11200, 11578, 12003, 12476, 12997, 13566, 14182, 14846, 15558, 16317, 17124, 17979, 18882, 19832, 20831, 21876, 22970, 24111, 25300, 26537, 27821}  // 110 F
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef HISTORY_TRANSFER_H
+#define HISTORY_TRANSFER_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "DataLogger.h"
+#include "Telemetry.h"
+
+// ============================================================================
+// HISTORY EXPORT / IMPORT
+// ============================================================================
+// Moves the raw history store image (AT24C32 or internal journal) over
+// Serial as telemetry frames (TelemetryProtocol.h), so history survives a
+// board swap or reflash. tools/history_transfer.cpp is the host side.
+// - Export streams INFO, every chunk and END back to back at full UART speed
+// - Import is host-driven: each frame is ACKed before the host sends the
+//   next, so the 64-byte RX buffer never overflows. Chunks are written as
+//   they arrive, one EEPROM page each; the header page is held back and
+//   written only after END and the whole-image CRC check, so an interrupted
+//   import leaves an image that boot ignores rather than a half-old one.
+// Both block loop() for the transfer: about 0.5 s out and 1.5 s in for the
+// AT24C32 at 115200 baud, bounded by the UART and the page write cycle.
+// ============================================================================
+
+class HistoryTransfer {
+public:
+  void init(DataLogger* logger, Telemetry* telemetry);
+  
+  bool exportHistory();
+  bool importHistory();  // Call once the host has sent the import command
+  
+private:
+  DataLogger* dataLogger;
+  Telemetry* telemetry;
+  
+  int16_t receiveFrame(uint8_t* raw);
+  void acknowledge(TelemetryHistoryStatus status, uint16_t next);
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "Config.h"
+
+// ============================================================================
+// I2C BUS GUARD
+// ============================================================================
+// Shared bus: DS3231, AHT21, BMP280, BH1750 and three HT16K33 displays.
+// - Bounds every Wire transaction with the core's TWI timeout (the build
+//   stops on a core without WIRE_HAS_TIMEOUT)
+// - Frees a bus whose SDA is held low by a slave stuck mid-byte, by
+//   clocking SCL manually and issuing a STOP
+// ============================================================================
+
+class I2CBus {
+public:
+  static void begin();     // Recover if stuck, start Wire, arm the timeout
+  static bool service();   // Call between transactions; returns true if a recovery ran
+  static bool recover();   // Force a recovery; returns true if SDA was released
+  
+  static bool isStuck();   // SDA low while the bus should be idle
+  
+  // Error counters
+  static uint16_t getTimeoutCount() { return timeoutCount; }
+  static uint16_t getRecoveryCount() { return recoveryCount; }
+
+private:
+  static uint16_t timeoutCount;
+  static uint16_t recoveryCount;
+  
+  static void startWire();
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Telemetry.h"
+
+// ============================================================================
+// TOKENIZED LOG
+// ============================================================================
+// LOG(LOG_SENSORS_READY) or LOG(LOG_BMP280_INIT_FAILED, status) queues a
+// TELEMETRY_LOG frame with the message's ID and up to three int16
+// arguments; the text stays in LogMessages.h and is put back by
+// tools/telemetry_decode.cpp. A site whose level is above LOG_LEVEL
+// compiles to nothing, arguments included. Frames go through the telemetry
+// TX ring, so a log call never waits on the UART - a full ring drops the
+// message and counts it with the other dropped frames.
+// ============================================================================
+
+enum LogId {
+#define LOG_MESSAGE(id, level, format) id,
+#include "LogMessages.h"
+#undef LOG_MESSAGE
+  LOG_MESSAGE_COUNT
+};
+
+static_assert(LOG_MESSAGE_COUNT <= 256, "Log IDs are sent as one byte");
+
+// Message levels, only ever indexed by constants in LOG() so the test folds away
+constexpr uint8_t logMessageLevels[] = {
+#define LOG_MESSAGE(id, level, format) level,
+#include "LogMessages.h"
+#undef LOG_MESSAGE
+};
+
+#define LOG(id, ...) do { \
+    if (logMessageLevels[id] <= LOG_LEVEL) Log::write(id, ##__VA_ARGS__); \
+  } while (0)
+
+class Log {
+public:
+  static void begin(Telemetry* stream) { telemetry = stream; }
+  
+  // Use LOG() rather than these, so the level check happens at compile time
+  static void write(LogId id) { send(id, NULL, 0); }
+  static void write(LogId id, int16_t a) { send(id, &a, 1); }
+  static void write(LogId id, int16_t a, int16_t b);
+  static void write(LogId id, int16_t a, int16_t b, int16_t c);
+  
+  // For IDs only known at run time (HybridClock's events)
+  static bool isEnabled(uint8_t id);
+  static void send(uint8_t id, const int16_t* args, uint8_t count);
+
+private:
+  static Telemetry* telemetry;  // NULL until begin() - messages are dropped
+};
+
+#endif
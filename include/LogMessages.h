@@ -0,0 +1,54 @@
+// ============================================================================
+// LOG MESSAGE CATALOG
+// ============================================================================
+// Every message the firmware logs, as LOG_MESSAGE(id, level, format).
+// No include guard: Log.h expands this list into the LogId enum and the
+// level table, and tools/telemetry_decode.cpp expands it into its string
+// table - the formats are never compiled into the firmware. IDs are list
+// positions, so decode with a decoder built from the same tree (the
+// LOG_STARTING message carries the catalog size to catch a mismatch).
+// Arguments are int16 values, printed by %d conversions in format.
+// ============================================================================
+
+// setup()
+LOG_MESSAGE(LOG_STARTING, LOG_LEVEL_INFO, "Weather Clock Starting... (%d log messages)")
+LOG_MESSAGE(LOG_SENSORS_DEGRADED, LOG_LEVEL_WARNING, "WARNING: Some sensors failed - continuing with partial data")
+LOG_MESSAGE(LOG_DISPLAY_INIT_FAILED, LOG_LEVEL_ERROR, "ERROR: Display initialization failed")
+LOG_MESSAGE(LOG_INPUT_INIT_FAILED, LOG_LEVEL_ERROR, "ERROR: User input initialization failed")
+LOG_MESSAGE(LOG_AUDIO_INIT_FAILED, LOG_LEVEL_ERROR, "ERROR: Audio initialization failed")
+LOG_MESSAGE(LOG_LOGGER_INIT_FAILED, LOG_LEVEL_ERROR, "ERROR: Data logger initialization failed")
+LOG_MESSAGE(LOG_MODULES_READY, LOG_LEVEL_INFO, "All modules initialized successfully")
+LOG_MESSAGE(LOG_CLOCK_INIT_START, LOG_LEVEL_DEBUG, "Initializing HybridClock...")
+LOG_MESSAGE(LOG_CLOCK_INIT_DONE, LOG_LEVEL_INFO, "HybridClock initialized successfully")
+LOG_MESSAGE(LOG_CLOCK_INIT_SKIPPED, LOG_LEVEL_WARNING, "Skipping HybridClock init due to earlier failure")
+LOG_MESSAGE(LOG_FIRST_READ_FAILED, LOG_LEVEL_WARNING, "WARNING: Initial sensor read failed")
+LOG_MESSAGE(LOG_INIT_FATAL, LOG_LEVEL_ERROR, "FATAL: System initialization failed")
+LOG_MESSAGE(LOG_READY, LOG_LEVEL_INFO, "Weather Clock Ready")
+
+// loop()
+LOG_MESSAGE(LOG_SENSOR_READ_FAILED, LOG_LEVEL_WARNING, "WARNING: Sensor read failed")
+
+// Sensors::init()
+LOG_MESSAGE(LOG_SENSORS_READY, LOG_LEVEL_INFO, "All sensors initialized successfully")
+LOG_MESSAGE(LOG_RTC_INIT_FAILED, LOG_LEVEL_ERROR, "RTC initialization failed (year register %d)")
+LOG_MESSAGE(LOG_RTC_READY, LOG_LEVEL_DEBUG, "DS3231 RTC initialized successfully")
+LOG_MESSAGE(LOG_AHT21_INIT_FAILED, LOG_LEVEL_ERROR, "AHT21 initialization failed")
+LOG_MESSAGE(LOG_BMP280_INIT_FAILED, LOG_LEVEL_ERROR, "BMP280 begin failed: status %d (1 error, 2 not detected, 3 bad parameter)")
+LOG_MESSAGE(LOG_BH1750_INIT_FAILED, LOG_LEVEL_ERROR, "BH1750 initialization failed")
+
+// Settings
+LOG_MESSAGE(LOG_SETTINGS_LOADED, LOG_LEVEL_INFO, "Settings loaded (copy %d)")
+LOG_MESSAGE(LOG_SETTINGS_DEFAULTS, LOG_LEVEL_WARNING, "WARNING: No stored settings - using defaults")
+LOG_MESSAGE(LOG_SETTINGS_SAVED, LOG_LEVEL_INFO, "Settings saved (%d EEPROM bytes written)")
+
+// UserInput::init()
+LOG_MESSAGE(LOG_INPUT_READY, LOG_LEVEL_INFO, "User input initialized")
+
+// AudioManager::init()
+LOG_MESSAGE(LOG_VS1053_INIT_FAILED, LOG_LEVEL_ERROR, "VS1053 initialization failed")
+
+// HybridClock's events (HYBRIDCLOCK_ENABLE_SERIAL), in the library's order.
+// Add new messages above this block.
+#define CLOCK_LOG_EVENT(name, level, format) LOG_MESSAGE(LOG_CLOCK_##name, LOG_LEVEL_##level, format)
+#include "ClockLogEvents.h"
+#undef CLOCK_LOG_EVENT
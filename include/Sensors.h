@@ -7,6 +7,12 @@
 #include <BH1750.h>
 #include "Config.h"
 
+// SensorData::validFlags - set when the channel was read successfully this time
+#define SENSOR_VALID_TIME     0x01  // DS3231
+#define SENSOR_VALID_CLIMATE  0x02  // AHT21 temperature and humidity
+#define SENSOR_VALID_PRESSURE 0x04  // BMP280
+#define SENSOR_VALID_LIGHT    0x08  // BH1750
+
 struct SensorData {
   DateTime currentTime;
   float temperature;      // Celsius
@@ -17,6 +23,17 @@ struct SensorData {
   float feelsLikeF;       // Feels like temperature in Fahrenheit
   char tempWord[5];       // Four-letter temperature word
   uint8_t displayColor;   // 0=Green, 1=Amber, 2=Red
+  uint8_t validFlags;     // SENSOR_VALID_* - stale channels keep their last good value
+};
+
+// Per-device health, updated on every init/read attempt
+struct DeviceStatus {
+  DeviceHealth health;
+  uint8_t consecutiveFailures;
+  uint16_t totalFailures;
+  unsigned long nextRetryTime;     // millis() when a degraded/offline device is retried
+  unsigned long firstFailureTime;  // millis() of the first failure in the current run
+  unsigned long lastRecoveryMs;    // Duration of the most recent outage
 };
 
 class Sensors {
@@ -30,17 +47,71 @@ private:
   unsigned long lastReadTime;
   SensorData currentData;
   
+  DeviceStatus deviceStatus[SENSOR_DEVICE_COUNT];
+  
+  bool initDevice(SensorDevice device);
+  bool isDeviceDue(SensorDevice device);
+  void recordSuccess(SensorDevice device);
+  void recordFailure(SensorDevice device);
+  bool readDevice(SensorDevice device);
+  bool readRTC();
+  bool readClimate();
+  bool readPressure();
+  bool readLight();
+  bool isLightReady();  // Finishes a one-shot that is done; false while one is integrating
+  
+  // Dual-mode light channel: continuous low-res for dimming, occasional
+  // high-res one-shot (with MTreg auto-ranging) for the logged value. Both
+  // run at preciseMTreg, so MTreg is only rewritten when the range changes.
+  float ambientLux;
+  float preciseLux;
+  bool preciseLightPending;
+  bool preciseLightFresh;
+  uint8_t preciseMTreg;
+  unsigned long lastLightPoll;
+  unsigned long lightReadMicros;
+  unsigned long maxLightReadMicros;
+  
+  // BMP280 forced-mode acquisition
+  PressureProfile pressureProfile;
+  unsigned long pressureWaitMicros;
+  
+  void applyPressureProfile();
+  void triggerPressureConversion();
+  bool isPressureConverting();
+  bool waitForPressureConversion();
+  
+  float timedLightRead();
+  void startPreciseLightRead();
+  void finishPreciseLightRead();
+  
+  float lookupHeatIndex(float tempF, float humidity);
   float calculateFeelsLike(float tempF, float humidity);
   void calculateTempWord(float feelsLikeF);
   uint8_t getDisplayColor(float feelsLikeF);
 
 public:
   Sensors();
-  bool init();
-  bool readSensors();
+  bool init();          // false if any device failed - the rest still run
+  bool readSensors();   // false only if no device could be read
   SensorData getCurrentData();
   bool isTimeToRead();
   
+  // Ambient light - call every loop; returns true when a new fast reading is available
+  bool updateLight();
+  float getAmbientLight() { return ambientLux; }
+  unsigned long getLightReadMicros() { return lightReadMicros; }
+  unsigned long getMaxLightReadMicros() { return maxLightReadMicros; }
+  
+  // Device health
+  DeviceHealth getDeviceHealth(SensorDevice device) { return deviceStatus[device].health; }
+  const DeviceStatus& getDeviceStatus(SensorDevice device) { return deviceStatus[device]; }
+  
+  // Pressure sensor profile
+  void setPressureProfile(PressureProfile profile);
+  PressureProfile getPressureProfile() { return pressureProfile; }
+  unsigned long getPressureWaitMicros() { return pressureWaitMicros; }  // Stall spent polling for conversion
+  
   // Time management
   bool setDateTime(DateTime newDateTime);
   DateTime getCurrentTime();
@@ -0,0 +1,57 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "Config.h"
+
+// ============================================================================
+// PERSISTENT SETTINGS
+// ============================================================================
+// The user's settings as one record in the internal EEPROM, after the
+// history journal (SETTINGS_EEPROM_START):
+//   0      schema version (SETTINGS_SCHEMA_VERSION)
+//   1      length of the SettingsData that follows
+//   2...   SettingsData
+//   then   CRC-16 (Crc16.h) over everything before it, high byte first
+// The record is stored twice, SETTINGS_COPY_SIZE bytes apart. A save writes
+// the first copy, then the second, so a power cut tears at most one, and
+// boot takes the first copy that checks.
+// - Edits only change the RAM copy; save() writes the bytes that differ
+//   from the EEPROM and is called when a settings screen is left
+// - Fields are only ever appended: a shorter record from older firmware
+//   loads over the defaults, so new fields start at theirs. Changing what
+//   an existing field means bumps the schema and adds a step to migrate().
+// ============================================================================
+
+struct SettingsData {
+  uint8_t chimeType;             // ChimeType
+  uint8_t chimeInstrument;       // MIDI program
+  uint8_t chimeFrequency;        // Chimes per hour: 1, 2 or 4
+  uint8_t brightness;            // Display level 1-15, 0 follows the ambient light
+  uint8_t quietStart;            // Quiet hours, 24-hour; start == end turns them off
+  uint8_t quietEnd;
+  uint8_t quietBrightness;       // Clock LED percent during quiet hours
+  uint8_t pressureAlertRate;     // Falling, 0.1 hPa/hour (0 = off)
+  uint8_t temperatureAlertRate;  // 0.1 °F/hour either way (0 = off)
+} __attribute__((packed));
+
+#define SETTINGS_HEADER_SIZE 2
+#define SETTINGS_CRC_SIZE 2
+#define SETTINGS_RECORD_SIZE (SETTINGS_HEADER_SIZE + sizeof(SettingsData) + SETTINGS_CRC_SIZE)
+
+class Settings {
+public:
+  bool init();  // Loads the stored record in one read; false if neither copy checked and the defaults apply
+  SettingsData& getData() { return data; }  // Edit freely, then save()
+  uint8_t save();  // Bytes written, 0 when nothing changed
+
+private:
+  SettingsData data;
+  
+  bool load(const uint8_t* record);
+  bool migrate(uint8_t schema);
+  void sanitize();
+};
+
+#endif
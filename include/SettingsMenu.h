@@ -0,0 +1,109 @@
+#ifndef SETTINGS_MENU_H
+#define SETTINGS_MENU_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+// ============================================================================
+// SETTINGS MENU
+// ============================================================================
+// One engine for every settings screen, driven by a table of MenuItem rows
+// in flash. Each row says what its value is and where it comes from; the
+// engine does the rest:
+// - List view: turning moves between items, wrapping at both ends; a press
+//   opens the item, or closes the menu on the MENU_EXIT row
+// - Edit view: turning changes the value by step, wrapping (MENU_WRAP) or
+//   stopping at the range; each change goes to the row's apply callback at
+//   once. Fast turns multiply the step by the row's MenuAccel curve. A
+//   press moves to the item's next field, a long press goes back to the
+//   list.
+// - An item can span several rows (MENU_FIELD on all but the first), one per
+//   field, e.g. hour, minute and second for the time
+// - render() fills 12 characters without printf, so every item costs about
+//   the same to draw
+// The leave callback runs whenever editing ends or the menu closes, so
+// changes can be committed once rather than per detent.
+// ============================================================================
+
+enum MenuFormat {
+  MENU_NUMBER,   // Integer; names, if given, is shown for 0 instead
+  MENU_TENTHS,   // value / 10 with one decimal; names as for MENU_NUMBER
+  MENU_HOUR,     // Hour of the day as "22:00"
+  MENU_CHOICE,   // names entry value - min
+  MENU_TIME,     // Fields as HH:MM:SS after the current field's tag
+  MENU_DATE,     // Fields as MM/DD/YY after the current field's tag
+  MENU_EXIT      // Not a value: selecting it closes the menu
+};
+
+// Step multipliers for quick turns, by how fast the detents come
+// (ACCEL_*_MS); slow turns are always single steps
+enum MenuAccel {
+  ACCEL_NONE,    // Short ranges and choices
+  ACCEL_LOW,     // Up to about 100 values: x2, x3, x5
+  ACCEL_HIGH     // Longer ranges: x2, x5, x10
+};
+
+#define MENU_WRAP 0x01    // Past one end of the range comes back at the other
+#define MENU_FIELD 0x02   // Another field of the item above
+
+#define MENU_NAME_LENGTH 4  // Each entry of a names string, e.g. "WESTWHITSTMI"
+
+typedef int16_t (*MenuGetter)(uint8_t arg);
+typedef void (*MenuSetter)(uint8_t arg, int16_t value);
+typedef void (*MenuHandler)();
+
+// One row of a PROGMEM menu table
+struct MenuItem {
+  char label[MENU_LABEL_LENGTH];  // List view text
+  char tag[MENU_TAG_LENGTH];      // Edit view, left of the value
+  uint8_t format;                 // MenuFormat
+  uint8_t flags;                  // MENU_WRAP, MENU_FIELD
+  int16_t min;
+  int16_t max;
+  uint8_t step;
+  uint8_t accel;                  // MenuAccel
+  uint8_t arg;                    // Passed to get and apply, e.g. a field offset
+  const char* names;              // PROGMEM, MENU_NAME_LENGTH characters per entry, or NULL
+  MenuGetter get;
+  MenuSetter apply;
+};
+
+class SettingsMenu {
+public:
+  void init(const MenuItem* table, uint8_t count, MenuHandler onLeave);  // table in PROGMEM
+  
+  void open();
+  bool isOpen() { return opened; }
+  bool isEditing() { return editing; }
+  
+  // Input, one call per event
+  void press();
+  void back();             // Long press
+  void turn(int delta, uint16_t interval = ENCODER_INTERVAL_IDLE);  // Detents, either direction, and ms between the last two
+  
+  // 12 characters and a NUL into text. Clears needsRedraw().
+  void render(char* text);
+  bool needsRedraw() { return redraw; }
+  uint16_t getRenderMicros() { return renderMicros; }  // Slowest render() so far
+
+private:
+  const MenuItem* items;
+  uint8_t itemCount;
+  MenuHandler leave;
+  
+  uint8_t current;   // First row of the selected item
+  uint8_t field;     // Row offset of the field being edited
+  bool opened;
+  bool editing;
+  bool redraw;
+  uint16_t renderMicros;
+  
+  void readItem(uint8_t index, MenuItem& item);
+  uint8_t fieldCount(uint8_t first);
+  uint8_t multiplier(uint8_t curve, uint16_t interval);
+  void close();
+  void renderValue(const MenuItem& item, char* text);
+  void renderFields(const MenuItem& item, char separator, char* text);
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Sensors.h"
+#include "DataLogger.h"
+#include "TelemetryProtocol.h"
+
+// ============================================================================
+// BINARY TELEMETRY
+// ============================================================================
+// Frames (TelemetryProtocol.h) are encoded whole into a TX ring and drained
+// into Serial only as far as its buffer has room, so sending never waits on
+// the UART. A frame that doesn't fit in the ring is dropped and counted.
+// Also profiles the main loop for the TELEMETRY_PROFILE message.
+// ============================================================================
+
+class Telemetry {
+public:
+  bool init();
+  void service();  // Drain the TX ring without blocking - call on every loop()
+  
+  // Main loop profiler: bracket each pass
+  void loopStarted() { loopStart = micros(); }
+  void loopFinished();
+  
+  void sendSnapshot(const SensorData& data);
+  void sendHourly(const HistoryRecord& record);  // Once per closed hour; repeats are ignored
+  void checkFaults(Sensors& sensors);            // Event for each health change or bus recovery
+  void sendLog(uint8_t id, const int16_t* args, uint8_t count);  // Log.h
+  
+  // Bulk transfers (HistoryTransfer): drain the ring, then write a frame
+  // straight to Serial, waiting on the UART like any other print
+  void flush();
+  void sendNow(uint8_t type, uint8_t version, const void* body, uint8_t length);
+  
+  // Text replies (Console): flush() first so no frame is split, then
+  // endText() so the text isn't taken as the start of the next frame
+  void endText();
+  
+  uint16_t getDropped() { return dropped; }
+  uint16_t getMaxServiceMicros() { return maxServiceMicros; }
+  void getProfile(TelemetryProfile& profile);  // The current interval so far
+
+private:
+  uint8_t ring[TELEMETRY_TX_BUFFER];
+  uint8_t head;               // Next byte written
+  uint8_t tail;               // Next byte sent
+  uint8_t sequence;
+  uint16_t dropped;
+  bool enabled;
+  
+  uint32_t lastHourlyTime;
+  DeviceHealth lastHealth[SENSOR_DEVICE_COUNT];
+  uint16_t lastRecoveries;
+  
+  // Profiler state for the current interval
+  unsigned long loopStart;
+  unsigned long profileStart;
+  uint16_t loops;
+  uint32_t loopMicrosSum;
+  uint32_t maxLoopMicros;
+  uint16_t maxServiceMicros;
+  
+  bool send(uint8_t type, uint8_t version, const void* body, uint8_t length);
+  void sendProfile();
+};
+
+#endif
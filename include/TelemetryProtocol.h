@@ -0,0 +1,248 @@
+#ifndef TELEMETRY_PROTOCOL_H
+#define TELEMETRY_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "Crc16.h"
+
+// ============================================================================
+// BINARY TELEMETRY PROTOCOL
+// ============================================================================
+// Shared by the firmware (Telemetry, HistoryTransfer) and the host tools
+// (tools/), so it depends on nothing but stdint and Crc16.h.
+//
+// Frame on the wire:  COBS( type | version | sequence | body | CRC-16 ) 0x00
+// - The CRC (Crc16.h) covers type through body and is sent high byte first
+// - sequence counts every frame sent, so gaps show dropped frames
+// - Bodies are the packed structs below, little endian on both ends
+// - A decoder skips frames with a type or version it doesn't know; a new
+//   field means a new version, never a reinterpreted old one
+// ============================================================================
+
+enum TelemetryType {
+  TELEMETRY_SNAPSHOT = 1,   // Each sensor read (30s)
+  TELEMETRY_HOURLY,         // Each closed hourly record
+  TELEMETRY_PROFILE,        // Main loop timing, every TELEMETRY_PROFILE_INTERVAL
+  TELEMETRY_FAULT,          // Device health change or I2C bus recovery
+  
+  // History store transfer (HistoryTransfer). Export streams INFO, the
+  // CHUNKs in order, then END. Import is the same sequence from the host,
+  // one frame at a time, each answered with an ACK.
+  TELEMETRY_HISTORY_INFO,
+  TELEMETRY_HISTORY_CHUNK,
+  TELEMETRY_HISTORY_END,
+  TELEMETRY_HISTORY_ACK,
+  
+  TELEMETRY_LOG             // Tokenized log message (Log.h)
+};
+
+#define TELEMETRY_SNAPSHOT_VERSION 1
+#define TELEMETRY_HOURLY_VERSION 1
+#define TELEMETRY_PROFILE_VERSION 1
+#define TELEMETRY_FAULT_VERSION 1
+#define TELEMETRY_HISTORY_VERSION 1   // All four history types
+#define TELEMETRY_LOG_VERSION 1
+
+#define TELEMETRY_HEADER_SIZE 3
+#define TELEMETRY_CRC_SIZE 2
+#define TELEMETRY_MAX_BODY 34
+#define TELEMETRY_MAX_RAW (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_BODY + TELEMETRY_CRC_SIZE)
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_RAW + 2)  // COBS overhead byte + delimiter
+
+// Field scales
+#define TELEMETRY_TEMPERATURE_SCALE 100   // °F * 100
+#define TELEMETRY_HUMIDITY_SCALE 100      // % * 100
+#define TELEMETRY_PRESSURE_SCALE 100      // (hPa - offset) * 100
+#define TELEMETRY_PRESSURE_OFFSET 500
+#define TELEMETRY_NO_LIGHT 0xFFFF         // Light field when there was no reading
+#define TELEMETRY_FAULT_I2C 0x10          // Fault source for bus recoveries (others are SensorDevice)
+
+// Timestamps pack like FAT dates: years since 2000 (6 bits), month (4),
+// day (5), hour (5), minute (6), second (6)
+inline uint32_t telemetryPackTime(uint16_t year, uint8_t month, uint8_t day,
+                                  uint8_t hour, uint8_t minute, uint8_t second) {
+  return ((uint32_t)((year - 2000) & 0x3F) << 26) | ((uint32_t)(month & 0x0F) << 22) |
+         ((uint32_t)(day & 0x1F) << 17) | ((uint32_t)(hour & 0x1F) << 12) |
+         ((uint32_t)(minute & 0x3F) << 6) | (second & 0x3F);
+}
+
+struct TelemetrySnapshot {
+  uint32_t time;
+  uint8_t validFlags;       // SENSOR_VALID_*
+  int16_t temperature;
+  uint16_t humidity;
+  uint16_t pressure;
+  uint16_t light;           // lux, saturating
+} __attribute__((packed));
+
+struct TelemetryHourly {
+  uint32_t time;            // Start of the hour
+  int16_t avgTemperature;
+  int16_t minTemperature;
+  int16_t maxTemperature;
+  uint16_t avgHumidity;
+  uint16_t avgPressure;
+  uint16_t minPressure;
+  uint16_t maxPressure;
+  uint16_t avgLight;
+} __attribute__((packed));
+
+struct TelemetryProfile {
+  uint16_t loops;              // Main loop passes in the interval
+  uint16_t meanLoopMicros;
+  uint32_t maxLoopMicros;
+  uint16_t maxServiceMicros;   // Longest TX ring drain - the stall telemetry adds
+  uint16_t dropped;            // Frames dropped on a full TX ring, since boot
+  uint16_t i2cTimeouts;        // Since boot
+  uint16_t i2cRecoveries;
+} __attribute__((packed));
+
+struct TelemetryFault {
+  uint32_t time;
+  uint8_t source;              // SensorDevice or TELEMETRY_FAULT_I2C
+  uint8_t health;              // DeviceHealth after the change
+  uint16_t totalFailures;      // Recoveries for TELEMETRY_FAULT_I2C
+  uint32_t lastRecoveryMs;     // Length of the outage that just ended
+} __attribute__((packed));
+
+// History store image: the raw bytes of whichever EEPROM holds the journal,
+// in its own self-checking layout (DataLogger.cpp), sent in page-sized chunks
+#define TELEMETRY_HISTORY_CHUNK_SIZE 32
+#define TELEMETRY_HISTORY_INTERNAL 0     // TelemetryHistoryInfo::store
+#define TELEMETRY_HISTORY_EXTERNAL 1     // AT24C32
+
+struct TelemetryHistoryInfo {
+  uint8_t store;               // TELEMETRY_HISTORY_INTERNAL or _EXTERNAL
+  uint8_t layout;              // Journal layout version of that store
+  uint16_t size;               // Image bytes, a multiple of the chunk size
+} __attribute__((packed));
+
+struct TelemetryHistoryChunk {
+  uint16_t offset;
+  uint8_t data[TELEMETRY_HISTORY_CHUNK_SIZE];
+} __attribute__((packed));
+
+struct TelemetryHistoryEnd {
+  uint16_t crc;                // CRC-16 over the whole image
+} __attribute__((packed));
+
+enum TelemetryHistoryStatus {
+  HISTORY_OK,
+  HISTORY_BAD_FRAME,           // Failed COBS/CRC or unexpected type - resend
+  HISTORY_OUT_OF_ORDER,        // Not the chunk at next - resend from there
+  HISTORY_INCOMPATIBLE,        // Store, layout or size differ from this board's
+  HISTORY_WRITE_FAILED,
+  HISTORY_CRC_MISMATCH,        // The image as received fails END's CRC
+  HISTORY_TIMEOUT
+};
+
+struct TelemetryHistoryAck {
+  uint8_t status;              // TelemetryHistoryStatus
+  uint16_t next;               // Offset of the next chunk expected
+} __attribute__((packed));
+
+// Log messages: an ID into the catalog (LogMessages.h) and that message's
+// arguments, so the body is 1 + 2 * arguments bytes. The level and text come
+// from the decoder's copy of the catalog.
+#define TELEMETRY_LOG_MAX_ARGS 3
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+struct TelemetryLog {
+  uint8_t id;                  // LogId
+  int16_t args[TELEMETRY_LOG_MAX_ARGS];
+} __attribute__((packed));
+
+static_assert(sizeof(TelemetrySnapshot) <= TELEMETRY_MAX_BODY && sizeof(TelemetryHourly) <= TELEMETRY_MAX_BODY &&
+              sizeof(TelemetryProfile) <= TELEMETRY_MAX_BODY && sizeof(TelemetryFault) <= TELEMETRY_MAX_BODY &&
+              sizeof(TelemetryHistoryChunk) <= TELEMETRY_MAX_BODY && sizeof(TelemetryLog) <= TELEMETRY_MAX_BODY,
+              "Telemetry body too large");
+
+// Consistent Overhead Byte Stuffing: rewrites a frame with no zero bytes so
+// 0x00 can delimit frames. out needs length + 1 bytes (frames stay under 254).
+// Returns the encoded length.
+inline uint8_t cobsEncode(const uint8_t* in, uint8_t length, uint8_t* out) {
+  uint8_t code = 1;
+  uint8_t codeIndex = 0;
+  uint8_t o = 1;
+  for (uint8_t i = 0; i < length; i++) {
+    if (in[i] == 0) {
+      out[codeIndex] = code;
+      codeIndex = o++;
+      code = 1;
+    } else {
+      out[o++] = in[i];
+      code++;
+    }
+  }
+  out[codeIndex] = code;
+  return o;
+}
+
+// Inverse of cobsEncode for one frame without its delimiter. Returns the
+// decoded length, or 0 if the bytes aren't valid COBS.
+inline size_t cobsDecode(const uint8_t* in, size_t length, uint8_t* out) {
+  size_t i = 0;
+  size_t o = 0;
+  while (i < length) {
+    uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > length) {
+      return 0;
+    }
+    for (uint8_t j = 1; j < code; j++) {
+      out[o++] = in[i++];
+    }
+    if (code < 0xFF && i < length) {
+      out[o++] = 0;
+    }
+  }
+  return o;
+}
+
+// Builds a complete frame, delimiter included, into frame (at least
+// TELEMETRY_MAX_FRAME bytes). Returns its length.
+inline uint8_t telemetryEncodeFrame(uint8_t type, uint8_t version, uint8_t sequence,
+                                    const void* body, uint8_t length, uint8_t* frame) {
+  uint8_t raw[TELEMETRY_MAX_RAW];
+  raw[0] = type;
+  raw[1] = version;
+  raw[2] = sequence;
+  memcpy(raw + TELEMETRY_HEADER_SIZE, body, length);
+  uint8_t rawLength = TELEMETRY_HEADER_SIZE + length;
+  uint16_t crc = CRC16_INIT;
+  for (uint8_t i = 0; i < rawLength; i++) {
+    crc = crc16Update(crc, raw[i]);
+  }
+  raw[rawLength++] = crc >> 8;
+  raw[rawLength++] = crc & 0xFF;
+  
+  uint8_t frameLength = cobsEncode(raw, rawLength, frame);
+  frame[frameLength++] = 0;  // Delimiter
+  return frameLength;
+}
+
+// Checks one received frame (without its delimiter) and decodes it into raw
+// (at least length bytes). Returns the length of header plus body, or 0 if
+// the frame is malformed or fails its CRC.
+inline size_t telemetryDecodeFrame(const uint8_t* encoded, size_t length, uint8_t* raw) {
+  size_t rawLength = length > 0 ? cobsDecode(encoded, length, raw) : 0;
+  if (rawLength < TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE) {
+    return 0;
+  }
+  rawLength -= TELEMETRY_CRC_SIZE;
+  uint16_t crc = CRC16_INIT;
+  for (size_t i = 0; i < rawLength; i++) {
+    crc = crc16Update(crc, raw[i]);
+  }
+  if (raw[rawLength] != (crc >> 8) || raw[rawLength + 1] != (crc & 0xFF)) {
+    return 0;
+  }
+  return rawLength;
+}
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef USER_INPUT_H
 #define USER_INPUT_H
 
-#include <Encoder.h>
+#include <Arduino.h>
 #include "Config.h"
 
 enum ButtonState {
@@ -11,12 +11,14 @@ enum ButtonState {
   BUTTON_RELEASED
 };
 
+// The encoder is decoded in its pin-change interrupts, which also time each
+// detent, so the turn speed is right however long a loop() pass takes.
+// update() copies the count and the latest interval out for the main loop.
 class UserInput {
 private:
-  Encoder rotaryEncoder;
-  
   int lastEncoderPosition;
   int currentEncoderPosition;
+  uint16_t encoderInterval;
   
   uint8_t buttonPin;
   ButtonState buttonState;
@@ -36,6 +38,7 @@ public:
   // Encoder functions
   int getEncoderDelta();
   int getEncoderPosition();
+  uint16_t getEncoderInterval();  // ms between the last two detents, ENCODER_INTERVAL_IDLE after a pause or reversal
   void resetEncoderPosition();
   
   // Button functions
@@ -47,7 +50,6 @@ public:
   
   // Mode switching
   DisplayMode handleModeChange(DisplayMode currentMode, int encoderDelta);
-  SettingItem handleSettingChange(SettingItem currentSetting, int encoderDelta);
 };
 
 #endif
@@ -6,6 +6,8 @@
 HT16K33Disp::HT16K33Disp(byte address, byte num_displays){
 	set_address(address, num_displays);
 	_loop_running = false;
+	for(byte i = 0; i < MAX_DISPLAYS; i++)
+		_errors[i] = 0;
 }
 
 void HT16K33Disp::set_address(byte address, byte num_displays){
@@ -30,6 +32,39 @@ void HT16K33Disp::init(const byte *brightLevels){
 	}
 }
 
+// change brightness only - leaves display memory untouched
+void HT16K33Disp::set_brightness(const byte *brightLevels){
+	for(byte i = 0; i < _num_displays; i++)
+		send_command(i, 0xE0 + *(brightLevels + i));
+}
+
+// re-assert oscillator on, brightness and display on without clearing
+// restores a display that reset (e.g. brown-out) and came back blank
+// returns false if any display did not acknowledge
+bool HT16K33Disp::refresh_setup(const byte *brightLevels){
+	bool ok = true;
+	for(byte i = 0; i < _num_displays; i++){
+		ok &= send_command(i, 0x21); //normal operation mode
+		ok &= send_command(i, 0xE0 + *(brightLevels + i));
+		ok &= send_command(i, 0x81); //display ON, blinking OFF
+	}
+	return ok;
+}
+
+unsigned int HT16K33Disp::error_count(byte display){
+	return display < MAX_DISPLAYS ? _errors[display] : 0;
+}
+
+bool HT16K33Disp::send_command(byte display, byte command){
+	Wire.beginTransmission(_address + display);
+	Wire.write(command);
+	if(Wire.endTransmission() != 0){
+		_errors[display]++;
+		return false;
+	}
+	return true;
+}
+
 void HT16K33Disp::write(byte digit, unsigned int data){
 	int display = digit / NUM_DIGITS_PER_DISPLAY;
 	digit -= (display * NUM_DIGITS_PER_DISPLAY);
@@ -37,7 +72,8 @@ void HT16K33Disp::write(byte digit, unsigned int data){
 	Wire.write(digit*2);
 	Wire.write(data);
 	Wire.write(data >> 8);
-	Wire.endTransmission();
+	if(Wire.endTransmission() != 0)
+		_errors[display]++;
 }
 
 void HT16K33Disp::segments_test(){
@@ -11,6 +11,7 @@
 #define DECIMAL_PT_SEGMENT 0x4000
 
 #define NUM_DIGITS_PER_DISPLAY 4
+#define MAX_DISPLAYS 8  // HT16K33 address range 0x70-0x77
 
 #define DEFAULT_SHOW_DELAY 750  // Restored to original value
 #define DEFAULT_SCROLL_DELAY 200
@@ -162,6 +163,10 @@ public:
 	uint16_t char_to_segments(char c, bool decimal_point = false);
 
 	void init(const byte *brightLevels);
+	void set_brightness(const byte *brightLevels);
+	bool refresh_setup(const byte *brightLevels);
+
+	unsigned int error_count(byte display);
 
 	static const int DEFAULT_ADDRESS = DEFAULT_ADDRESS_;
 
@@ -179,6 +184,9 @@ private:
 	bool _short_string;
 	bool _loop_running;
 	int _loop_times;
+	unsigned int _errors[MAX_DISPLAYS];
+
+	bool send_command(byte display, byte command);
 
 };
 
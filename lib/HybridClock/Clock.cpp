@@ -1,17 +1,16 @@
 #include "Clock.h"
+#include "ClockLog.h"
 
-// Uncomment to enable Serial debugging output from the library
+// Uncomment to report the library's log events (ClockLog.h)
 // #define HYBRIDCLOCK_ENABLE_SERIAL
 
 // Uncomment to enable hour-change animations (saves ~600 bytes Flash)
 // #define HYBRIDCLOCK_ENABLE_ANIMATIONS
 
 #ifdef HYBRIDCLOCK_ENABLE_SERIAL
-  #define SERIAL_PRINT(x) Serial.print(x)
-  #define SERIAL_PRINTLN(x) Serial.println(x)
+  #define CLOCK_LOG(...) clockLog(__VA_ARGS__)
 #else
-  #define SERIAL_PRINT(x)
-  #define SERIAL_PRINTLN(x)
+  #define CLOCK_LOG(...)
 #endif
 
 Clock::Clock(int stepsPerRev, int firstMotorPin,
@@ -37,7 +36,7 @@ Clock::Clock(int stepsPerRev, int firstMotorPin,
 }
 
 void Clock::begin() {
-    SERIAL_PRINTLN(F("=== Clock System Starting ==="));
+    CLOCK_LOG(CLOCK_LOG_STARTING);
     
     // Initialize components
     clockTime.begin();
@@ -55,12 +54,7 @@ void Clock::begin() {
 #endif
     
 #ifdef HYBRIDCLOCK_ENABLE_SERIAL
-    if (verboseLogging) {
-        SERIAL_PRINT(F("Clock: Initial time - "));
-        SERIAL_PRINT(clockTime.getHour());
-        SERIAL_PRINT(F(":"));
-        SERIAL_PRINTLN(initialMinute);
-    }
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_INITIAL_TIME, clockTime.getHour(), initialMinute);
 #endif
     
     // Set initial brightness based on quiet hours
@@ -71,25 +65,21 @@ void Clock::begin() {
 #ifdef HYBRIDCLOCK_ENABLE_ANIMATIONS
     // Show hour change animation on startup if enabled
     if (testAnimationOnStartup && hourChangeAnimationEnabled) {
-        if (verboseLogging) SERIAL_PRINTLN(F("Clock: Testing hour change animation on startup..."));
         int testHour = (initialHour + 1) % 24;
-        if (verboseLogging) {
-            SERIAL_PRINT(F("Clock: Showing animation for hour "));
-            SERIAL_PRINTLN(testHour);
-        }
+        if (verboseLogging) CLOCK_LOG(CLOCK_LOG_ANIMATION_TEST, testHour);
         animationManager.playHourChangeAnimation(clockDisplay, testHour);
-        if (verboseLogging) SERIAL_PRINTLN(F("Clock: Hour change animation test complete"));
+        if (verboseLogging) CLOCK_LOG(CLOCK_LOG_ANIMATION_TEST_DONE);
     }
 #endif
     
     // Move to current minute position
     clockMotor.moveToMinute(initialMinute);
     
-    SERIAL_PRINTLN(F("=== Clock System Ready ==="));
+    CLOCK_LOG(CLOCK_LOG_READY);
 }
 
 void Clock::performCalibration() {
-    if (verboseLogging) SERIAL_PRINTLN(F("Clock: Starting calibration..."));
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_CALIBRATION_START);
     
     // Show calibration indicator
     clockDisplay.clear();
@@ -105,14 +95,14 @@ void Clock::performCalibration() {
         clockDisplay.getPixels().setPixelColor(0, clockDisplay.getPixels().Color(0, 255, 0));
         clockDisplay.show();
         delay(2000);
-        if (verboseLogging) SERIAL_PRINTLN(F("Clock: Calibration successful"));
+        if (verboseLogging) CLOCK_LOG(CLOCK_LOG_CALIBRATION_OK);
     } else {
         // Show failure
         clockDisplay.clear();
         clockDisplay.getPixels().setPixelColor(0, clockDisplay.getPixels().Color(255, 0, 0));
         clockDisplay.show();
         delay(2000);
-        SERIAL_PRINTLN(F("Clock: Calibration FAILED!")); // CRITICAL - always show
+        CLOCK_LOG(CLOCK_LOG_CALIBRATION_FAILED); // CRITICAL - always show
     }
 }
 
@@ -125,15 +115,9 @@ void Clock::enableQuietHours(bool enable, int start, int end, int percent) {
     
     if (verboseLogging) {
         if (enable) {
-            SERIAL_PRINT(F("Clock: Quiet hours enabled ("));
-            SERIAL_PRINT(start);
-            SERIAL_PRINT(F(":00 - "));
-            SERIAL_PRINT(end);
-            SERIAL_PRINT(F(":00, "));
-            SERIAL_PRINT(percent);
-            SERIAL_PRINTLN(F("% brightness)"));
+            CLOCK_LOG(CLOCK_LOG_QUIET_HOURS_ON, start, end, percent);
         } else {
-            SERIAL_PRINTLN(F("Clock: Quiet hours disabled"));
+            CLOCK_LOG(CLOCK_LOG_QUIET_HOURS_OFF);
         }
     }
 }
@@ -171,13 +155,7 @@ void Clock::update(bool force) {
         int nextHour = (hour + 1) % 24;
         if (nextHour != lastHourForAnimation) {
 #ifdef HYBRIDCLOCK_ENABLE_SERIAL
-            if (verboseLogging) {
-                SERIAL_PRINT(F("Clock: Hour transition animation ("));
-                SERIAL_PRINT(hour);
-                SERIAL_PRINT(F(" -> "));
-                SERIAL_PRINT(nextHour);
-                SERIAL_PRINTLN(F(")"));
-            }
+            if (verboseLogging) CLOCK_LOG(CLOCK_LOG_HOUR_ANIMATION, hour, nextHour);
 #endif
             
             // Animation runs for exactly 2 seconds (59:58 -> 00:00)
@@ -189,7 +167,7 @@ void Clock::update(bool force) {
             // Perform micro-calibration if enabled
             if (microCalibrationEnabled && nextHour % microCalibrationInterval == 0) {
 #ifdef HYBRIDCLOCK_ENABLE_SERIAL
-                if (verboseLogging) SERIAL_PRINTLN(F("Clock: Performing micro-calibration"));
+                if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MICRO_CALIBRATION);
 #endif
                 clockMotor.powerOn();
                 clockMotor.microCalibrate(centeringAdjustment, slowDelay);
@@ -224,7 +202,7 @@ void Clock::update(bool force) {
         // Perform micro-calibration if enabled at the appropriate hours
         if (microCalibrationEnabled && currentHour % microCalibrationInterval == 0 && minute == 0) {
 #ifdef HYBRIDCLOCK_ENABLE_SERIAL
-            if (verboseLogging) SERIAL_PRINTLN(F("Clock: Performing micro-calibration"));
+            if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MICRO_CALIBRATION);
 #endif
             clockMotor.powerOn();
             clockMotor.microCalibrate(centeringAdjustment, slowDelay);
@@ -248,15 +226,7 @@ void Clock::update(bool force) {
     if (patternManager.shouldRotate(hour)) {
         randomSeed(analogRead(A7) + hour);
         patternManager.selectRandomPattern();
-        if (verboseLogging) {
-#ifdef DEBUG_PATTERN_NAMES
-            SERIAL_PRINT(F("Clock: Pattern changed to "));
-            SERIAL_PRINTLN(patternManager.getPatternName(patternManager.getPattern()));
-#else
-            SERIAL_PRINT(F("Clock: Pattern changed to "));
-            SERIAL_PRINTLN(patternManager.getPattern());
-#endif
-        }
+        if (verboseLogging) CLOCK_LOG(CLOCK_LOG_PATTERN_CHANGED, patternManager.getPattern());
     }
     
     // Update display
@@ -266,10 +236,7 @@ void Clock::update(bool force) {
 void Clock::handleMinuteChange() {
     int minute = clockTime.getMinute();
     
-    if (verboseLogging) {
-        SERIAL_PRINT(F("Clock: Minute changed to "));
-        SERIAL_PRINTLN(minute);
-    }
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MINUTE_CHANGED, minute);
     
     // Move hand to new position
     clockMotor.moveToMinute(minute);
@@ -277,11 +244,7 @@ void Clock::handleMinuteChange() {
 
 void Clock::handleHourChange() {
 #ifdef HYBRIDCLOCK_ENABLE_SERIAL
-    if (verboseLogging) {
-        int hour = clockTime.getHour();
-        SERIAL_PRINT(F("Clock: Hour changed to "));
-        SERIAL_PRINTLN(hour);
-    }
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_HOUR_CHANGED, clockTime.getHour());
 #endif
     
     // Update brightness if quiet hours changed
@@ -326,12 +289,6 @@ void Clock::updateQuietHoursBrightness() {
     
     if (clockDisplay.getBrightness() != targetBrightness) {
         clockDisplay.setBrightness(targetBrightness);
-        if (verboseLogging) {
-            SERIAL_PRINT(F("Clock: Brightness changed to "));
-            SERIAL_PRINT(targetBrightness);
-            SERIAL_PRINT(F(" ("));
-            SERIAL_PRINT(isQuiet ? F("QUIET") : F("ACTIVE"));
-            SERIAL_PRINTLN(F(" mode)"));
-        }
+        if (verboseLogging) CLOCK_LOG(CLOCK_LOG_BRIGHTNESS_CHANGED, targetBrightness, isQuiet);
     }
 }
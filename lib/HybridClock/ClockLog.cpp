@@ -0,0 +1,31 @@
+#include "ClockLog.h"
+
+static ClockLogHandler logHandler = NULL;
+
+void setClockLogHandler(ClockLogHandler handler) {
+    logHandler = handler;
+}
+
+static void report(ClockLogEvent event, const int16_t* values, uint8_t count) {
+    if (logHandler != NULL) {
+        logHandler(event, values, count);
+    }
+}
+
+void clockLog(ClockLogEvent event) {
+    report(event, NULL, 0);
+}
+
+void clockLog(ClockLogEvent event, int16_t a) {
+    report(event, &a, 1);
+}
+
+void clockLog(ClockLogEvent event, int16_t a, int16_t b) {
+    int16_t values[] = {a, b};
+    report(event, values, 2);
+}
+
+void clockLog(ClockLogEvent event, int16_t a, int16_t b, int16_t c) {
+    int16_t values[] = {a, b, c};
+    report(event, values, 3);
+}
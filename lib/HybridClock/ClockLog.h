@@ -0,0 +1,37 @@
+#ifndef CLOCK_LOG_H
+#define CLOCK_LOG_H
+
+#include <Arduino.h>
+
+/**
+ * ClockLog - Library log events
+ * 
+ * The library doesn't print its own messages. With HYBRIDCLOCK_ENABLE_SERIAL
+ * defined (Clock.cpp, ClockMotor.cpp), each one is reported as an event
+ * number plus up to three values to the handler installed with
+ * setClockLogHandler(), so it joins whatever log the application keeps.
+ * The texts are in ClockLogEvents.h and never reach flash.
+ * 
+ * Usage:
+ *   void onClockLog(uint8_t event, const int16_t* values, uint8_t count) { ... }
+ *   
+ *   setClockLogHandler(onClockLog);
+ */
+
+enum ClockLogEvent {
+#define CLOCK_LOG_EVENT(name, level, format) CLOCK_LOG_##name,
+#include "ClockLogEvents.h"
+#undef CLOCK_LOG_EVENT
+    CLOCK_LOG_EVENT_COUNT
+};
+
+typedef void (*ClockLogHandler)(uint8_t event, const int16_t* values, uint8_t count);
+
+void setClockLogHandler(ClockLogHandler handler);
+
+void clockLog(ClockLogEvent event);
+void clockLog(ClockLogEvent event, int16_t a);
+void clockLog(ClockLogEvent event, int16_t a, int16_t b);
+void clockLog(ClockLogEvent event, int16_t a, int16_t b, int16_t c);
+
+#endif
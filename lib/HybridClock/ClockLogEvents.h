@@ -0,0 +1,31 @@
+// HybridClock log events: CLOCK_LOG_EVENT(name, level, format)
+//
+// No include guard - this list is expanded into ClockLogEvent (ClockLog.h)
+// and again by an application that wants the texts, e.g. to decode a
+// tokenized log on a host. level is ERROR, WARNING, INFO or DEBUG; the
+// event's values are printed by %d conversions in format, in order.
+
+CLOCK_LOG_EVENT(STARTING, INFO, "=== Clock System Starting ===")
+CLOCK_LOG_EVENT(READY, INFO, "=== Clock System Ready ===")
+CLOCK_LOG_EVENT(INITIAL_TIME, DEBUG, "Clock: Initial time - %d:%02d")
+CLOCK_LOG_EVENT(ANIMATION_TEST, DEBUG, "Clock: Showing startup animation for hour %d")
+CLOCK_LOG_EVENT(ANIMATION_TEST_DONE, DEBUG, "Clock: Hour change animation test complete")
+CLOCK_LOG_EVENT(CALIBRATION_START, DEBUG, "Clock: Starting calibration...")
+CLOCK_LOG_EVENT(CALIBRATION_OK, INFO, "Clock: Calibration successful")
+CLOCK_LOG_EVENT(CALIBRATION_FAILED, ERROR, "Clock: Calibration FAILED!")
+CLOCK_LOG_EVENT(QUIET_HOURS_ON, DEBUG, "Clock: Quiet hours enabled (%d:00 - %d:00, %d%% brightness)")
+CLOCK_LOG_EVENT(QUIET_HOURS_OFF, DEBUG, "Clock: Quiet hours disabled")
+CLOCK_LOG_EVENT(HOUR_ANIMATION, DEBUG, "Clock: Hour transition animation (%d -> %d)")
+CLOCK_LOG_EVENT(MICRO_CALIBRATION, DEBUG, "Clock: Performing micro-calibration")
+CLOCK_LOG_EVENT(PATTERN_CHANGED, DEBUG, "Clock: Pattern changed to %d")
+CLOCK_LOG_EVENT(MINUTE_CHANGED, DEBUG, "Clock: Minute changed to %d")
+CLOCK_LOG_EVENT(HOUR_CHANGED, DEBUG, "Clock: Hour changed to %d")
+CLOCK_LOG_EVENT(BRIGHTNESS_CHANGED, DEBUG, "Clock: Brightness changed to %d (quiet mode %d)")
+CLOCK_LOG_EVENT(MOTOR_CALIBRATION_START, DEBUG, "ClockMotor: Starting calibration...")
+CLOCK_LOG_EVENT(MOTOR_FORWARD_STEPS, DEBUG, "ClockMotor: Fwd Steps: %d")
+CLOCK_LOG_EVENT(MOTOR_BACK_STEPS, DEBUG, "ClockMotor: Bak Steps: %d")
+CLOCK_LOG_EVENT(MOTOR_CENTER_STEPS, DEBUG, "ClockMotor: Center Steps: %d")
+CLOCK_LOG_EVENT(MOTOR_CALIBRATION_DONE, DEBUG, "ClockMotor: Calibration complete")
+CLOCK_LOG_EVENT(MOTOR_MICRO_CALIBRATION_START, DEBUG, "ClockMotor: Starting micro-calibration...")
+CLOCK_LOG_EVENT(MOTOR_MICRO_CALIBRATION_SKIPPED, WARNING, "ClockMotor: Micro-calibration skipped (magnet not found)")
+CLOCK_LOG_EVENT(MOTOR_MICRO_CALIBRATION_DONE, DEBUG, "ClockMotor: Micro-calibration complete")
@@ -1,15 +1,14 @@
 #include "ClockMotor.h"
+#include "ClockLog.h"
 #include <math.h>
 
-// Uncomment to enable Serial debugging output from the library
+// Uncomment to report the library's log events (ClockLog.h)
 // #define HYBRIDCLOCK_ENABLE_SERIAL
 
 #ifdef HYBRIDCLOCK_ENABLE_SERIAL
-  #define SERIAL_PRINT(x) Serial.print(x)
-  #define SERIAL_PRINTLN(x) Serial.println(x)
+  #define CLOCK_LOG(...) clockLog(__VA_ARGS__)
 #else
-  #define SERIAL_PRINT(x)
-  #define SERIAL_PRINTLN(x)
+  #define CLOCK_LOG(...)
 #endif
 
 ClockMotor::ClockMotor(int stepsPerRev, int pin1, int pin2, int pin3, int pin4, 
@@ -61,7 +60,7 @@ void ClockMotor::powerOff() {
 }
 
 bool ClockMotor::calibrate(int centeringAdjustment, int slowDelay) {
-    if (verboseLogging) SERIAL_PRINTLN(F("ClockMotor: Starting calibration..."));
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MOTOR_CALIBRATION_START);
     
     handPosition = 0.0;
     int cal_steps1 = 0;
@@ -93,10 +92,7 @@ bool ClockMotor::calibrate(int centeringAdjustment, int slowDelay) {
         if (slowDelay > 0) delay(slowDelay);
     }
     
-    if (verboseLogging) {
-        SERIAL_PRINT(F("ClockMotor: Fwd Steps: "));
-        SERIAL_PRINTLN(cal_steps1);
-    }
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MOTOR_FORWARD_STEPS, cal_steps1);
     
     // Roll back until the sensor is found
     for (int i = 0; i < stepsPerRevolution; i++) {
@@ -115,16 +111,10 @@ bool ClockMotor::calibrate(int centeringAdjustment, int slowDelay) {
         if (slowDelay > 0) delay(slowDelay);
     }
     
-    if (verboseLogging) {
-        SERIAL_PRINT(F("ClockMotor: Bak Steps: "));
-        SERIAL_PRINTLN(cal_steps2);
-    }
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MOTOR_BACK_STEPS, cal_steps2);
     
     int cal_steps = (cal_steps1 + cal_steps2) / 2;
-    if (verboseLogging) {
-        SERIAL_PRINT(F("ClockMotor: Center Steps: "));
-        SERIAL_PRINTLN(cal_steps);
-    }
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MOTOR_CENTER_STEPS, cal_steps);
     
     // Roll forward slowly the average of the counted steps
     for (int i = 0; i < cal_steps; i++) {
@@ -139,14 +129,14 @@ bool ClockMotor::calibrate(int centeringAdjustment, int slowDelay) {
     }
     
     handPosition = 0.0;
-    if (verboseLogging) SERIAL_PRINTLN(F("ClockMotor: Calibration complete"));
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MOTOR_CALIBRATION_DONE);
     
     // for now always return true (change later if the value needs to be checked)
     return true;
 }
 
 void ClockMotor::microCalibrate(int centeringAdjustment, int slowDelay) {
-    if (verboseLogging) SERIAL_PRINTLN(F("ClockMotor: Starting micro-calibration..."));
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MOTOR_MICRO_CALIBRATION_START);
     
     int cal_steps1 = 0;
     int cal_steps2 = 0;
@@ -193,7 +183,7 @@ void ClockMotor::microCalibrate(int centeringAdjustment, int slowDelay) {
                 stepper.step(1);
             }
         }
-        if (verboseLogging) SERIAL_PRINTLN(F("ClockMotor: Micro-calibration skipped (magnet not found)"));
+        if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MOTOR_MICRO_CALIBRATION_SKIPPED);
         return;
     }
     
@@ -233,7 +223,7 @@ void ClockMotor::microCalibrate(int centeringAdjustment, int slowDelay) {
     }
     
     handPosition = 0.0;
-    if (verboseLogging) SERIAL_PRINTLN(F("ClockMotor: Micro-calibration complete"));
+    if (verboseLogging) CLOCK_LOG(CLOCK_LOG_MOTOR_MICRO_CALIBRATION_DONE);
 }
 
 void ClockMotor::moveToMinute(int minute) {
@@ -39,4 +39,7 @@
 // Main orchestrator
 #include "Clock.h"
 
+// Log events (reported only with HYBRIDCLOCK_ENABLE_SERIAL)
+#include "ClockLog.h"
+
 #endif // HYBRIDCLOCK_H
@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include <SPI.h>
 #include "AudioManager.h"
+#include "Log.h"
 
 // Constructor - initialize VS1053_MIDI with pin definitions
 AudioManager::AudioManager() : musicPlayer(VS1053_CS, VS1053_DCS, VS1053_DREQ, VS1053_RESET) {
@@ -57,14 +58,14 @@ bool AudioManager::init() {
   
   // Initialize VS1053 MIDI player with MIDI plugin (exactly like working example)
   if (!musicPlayer.begin(true)) {
-    Serial.println(F("VS1053 initialization failed"));
+    LOG(LOG_VS1053_INIT_FAILED);
     return false;
   }
   
   // Set default settings
   currentChimeType = CHIME_WESTMINSTER;
   currentInstrument = INSTRUMENT_TUBULAR_BELLS;
-  chimeFrequency = 2; // Half-hourly (includes hour and half-hour chimes)
+  chimeFrequency = CHIME_FREQUENCY_DEFAULT;
   
   isPlaying = false;
   playStartTime = 0;
@@ -0,0 +1,167 @@
+#include <Arduino.h>
+#include "Console.h"
+
+void Console::init(const ConsoleCommand* table, uint8_t count) {
+  commands = table;
+  commandCount = count;
+  current = NULL;
+  telemetry = NULL;
+  reset();
+}
+
+void Console::reset() {
+  nameLength = 0;
+  argCount = 0;
+  negative = false;
+  state = CONSOLE_NAME;
+}
+
+void Console::service() {
+  if (Serial.available() <= 0) {
+    return;
+  }
+  char c = Serial.read();
+  
+  if (c == '\r' || c == '\n') {
+    endLine();
+    return;
+  }
+  if (c == 0) {
+    reset();  // End of a binary frame, not a command
+    return;
+  }
+  if ((c < ' ' && c != '\t') || c > '~') {
+    state = CONSOLE_BINARY;
+    return;
+  }
+  
+  bool digit = c >= '0' && c <= '9';
+  bool separator = c == ' ' || c == '\t' || c == ',' || c == ':' || c == '/';
+  switch (state) {
+    case CONSOLE_NAME:
+      if (separator) {
+        if (nameLength > 0) state = CONSOLE_GAP;
+      } else if (nameLength < CONSOLE_NAME_LENGTH - 1) {
+        name[nameLength++] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+      } else {
+        state = CONSOLE_ERROR;  // Longer than any command
+      }
+      return;
+    
+    case CONSOLE_GAP:
+      if (separator) {
+        return;
+      }
+      if (c == '-') {
+        state = startNumber(true) ? CONSOLE_SIGN : CONSOLE_ERROR;
+        return;
+      }
+      if (!digit || !startNumber(false)) {
+        state = CONSOLE_ERROR;
+        return;
+      }
+      break;  // First digit
+    
+    case CONSOLE_SIGN:
+      if (!digit) {
+        state = CONSOLE_ERROR;
+        return;
+      }
+      break;
+    
+    case CONSOLE_NUMBER:
+      if (separator || c == '-') {
+        // '-' here is a date separator, never a minus
+        if (negative) args[argCount] = -args[argCount];
+        argCount++;
+        state = CONSOLE_GAP;
+        return;
+      }
+      if (!digit) {
+        state = CONSOLE_ERROR;
+        return;
+      }
+      break;
+    
+    default:
+      return;  // Wait for the end of the line
+  }
+  
+  // Accumulate a digit, rejecting anything beyond int16_t
+  uint8_t value = c - '0';
+  if (args[argCount] > (32767 - value) / 10) {
+    state = CONSOLE_ERROR;
+    return;
+  }
+  args[argCount] = args[argCount] * 10 + value;
+  state = CONSOLE_NUMBER;
+}
+
+bool Console::startNumber(bool isNegative) {
+  if (argCount >= CONSOLE_MAX_ARGS) {
+    return false;
+  }
+  args[argCount] = 0;
+  negative = isNegative;
+  return true;
+}
+
+void Console::endLine() {
+  if (state == CONSOLE_NUMBER) {
+    if (negative) args[argCount] = -args[argCount];
+    argCount++;
+  } else if (state == CONSOLE_SIGN) {
+    state = CONSOLE_ERROR;
+  }
+  if (state == CONSOLE_BINARY || (nameLength == 0 && state != CONSOLE_ERROR)) {
+    reset();  // Frame bytes, a blank line or the LF of a CR LF
+    return;
+  }
+  
+  // Let a half-sent frame finish first, and delimit the reply after, so
+  // text never corrupts a frame
+  if (telemetry != NULL) telemetry->flush();
+  if (state == CONSOLE_ERROR) {
+    Serial.println(F("? bad line - try help"));
+  } else {
+    dispatch();
+  }
+  if (telemetry != NULL) telemetry->endText();
+  reset();
+}
+
+void Console::dispatch() {
+  name[nameLength] = '\0';
+  for (uint8_t i = 0; i < commandCount; i++) {
+    if (strcmp_P(name, commands[i].name) != 0) {
+      continue;
+    }
+    current = &commands[i];
+    if (argCount < pgm_read_byte(&current->minArgs) || argCount > pgm_read_byte(&current->maxArgs)) {
+      printUsage();
+      return;
+    }
+    ConsoleHandler handler;
+    memcpy_P(&handler, &current->handler, sizeof(handler));
+    handler(*this);
+    return;
+  }
+  Serial.print(F("? unknown command "));
+  Serial.print(name);
+  Serial.println(F(" - try help"));
+}
+
+void Console::printUsage() {
+  Serial.print(F("usage: "));
+  Serial.print((const __FlashStringHelper*)current->name);
+  Serial.print(' ');
+  Serial.println((const __FlashStringHelper*)current->usage);
+}
+
+void Console::printHelp() {
+  for (uint8_t i = 0; i < commandCount; i++) {
+    Serial.print((const __FlashStringHelper*)commands[i].name);
+    Serial.print(' ');
+    Serial.println((const __FlashStringHelper*)commands[i].usage);
+  }
+}
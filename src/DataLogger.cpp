@@ -1,302 +1,1777 @@
 #include <Arduino.h>
 #include "DataLogger.h"
+#include "Crc16.h"
 #include <string.h>  // For memset
 
+#if defined(E2END)
+static_assert(EEPROM_HEADER_SIZE + (EEPROM_HOURLY_SLOTS + EEPROM_DAILY_SLOTS) * EEPROM_RECORD_SIZE <= E2END + 1,
+              "History journal does not fit in EEPROM");
+#endif
+static_assert(MAX_HOURLY_RECORDS >= EEPROM_HOURLY_SLOTS && MAX_DAILY_RECORDS >= EEPROM_DAILY_SLOTS,
+              "Tier depths must cover the journal rings");
+static_assert(EXT_EEPROM_PAGE_SIZE + (EXT_HISTORY_HOURLY_SLOTS + EXT_HISTORY_DAILY_SLOTS) * EEPROM_RECORD_SIZE <= EXT_EEPROM_SIZE,
+              "External history does not fit in the AT24C32");
+static_assert(EXT_HISTORY_HOURLY_SLOTS >= MAX_HOURLY_RECORDS && EXT_HISTORY_DAILY_SLOTS >= MAX_DAILY_RECORDS,
+              "External store must hold the whole hourly and daily tiers");
+static_assert(FIVE_MINUTE_RECORDS <= 255 && MAX_HOURLY_RECORDS <= 255 &&
+              MAX_DAILY_RECORDS <= 255 && MAX_WEEKLY_RECORDS <= 255, "Ring indices are uint8_t");
+
+// Packed record (PackedRecord, 9 bytes)
+//   0-1    offset from the tier's base (0xFFFF = empty)
+//   2-6    40-bit body, least significant bit first:
+//            temperature (11 bits, 0.1°F from -40.0)
+//            pressure (12 bits, 0.1 hPa from 800.0)
+//            humidity (7 bits, 1% RH)
+//            temperature min/max below/above average (3 bits each)
+//            pressure min/max below/above average (2 bits each)
+//   7      light average, LIGHT_CODES_PER_OCTAVE * log2(1 + lux) (0xFF = none)
+//   8      light min/max below/above average (4 bits each)
+// Spread units depend on the tier (tierConfig) and saturate.
+//
+// EEPROM journal layout
+//   Header (written only when the base hour moves)
+//     0      version
+//     1-3    base hour (hours since 2000-01-01, 24-bit little endian)
+//     4      check byte over bytes 0-3
+//   Slots 8..., hourly then daily, EEPROM_RECORD_SIZE bytes each
+//     0-6    packed record bytes 0-6 (light is not journaled)
+//     7      commit marker: check byte over the base and bytes 0-6, never 0xFF
+//
+// There are no ring indices to rewrite: the newest offset in each ring marks
+// the write position, so each hourly cell is written once per day. The
+// journal is the hourly and daily tiers - there is no copy in SRAM - so a
+// lookup scans a ring's offsets in place and checks only the slot that matches.
+//
+// A slot is written by clearing its commit byte to 0xFF, then writing the body,
+// then writing the commit byte. A power cut anywhere in between leaves a slot
+// that fails the check on boot and is dropped. The rest of the ring is untouched.
+// Every slot is 8-byte aligned, so it never straddles a 32-byte EEPROM page.
+//
+// External store layout (AT24C32, when fitted)
+//   0-4    header as above, with EXT_HISTORY_LAYOUT_VERSION
+//   32...  hourly slots, then daily slots, in the same 8-byte format
+// A period always goes to slot period % slot count, so there is no write
+// position: an hour is one 8-byte page write, and each slot's offset says
+// whether it still belongs to its position. Reads go through a one-page
+// cache, so walking back through the hours costs one transfer per 4 records.
+#define EEPROM_HEADER_CHECK 4
+#define EEPROM_COMMIT_BYTE 7
+#define EEPROM_UNCOMMITTED 0xFF
+#define LAYOUT_2_VERSION 2             // Read once and migrated (loadFromInternal)
+#define LAYOUT_2_HOURLY_SLOTS 24
+#define HISTORY_BASE_LEAD_HOURS 1536   // New base sits this far back so the oldest weekly records still fit
+#define FIVE_MINUTE_BASE_LEAD 256
+#define LIGHT_CODE_MAX 254
+
+// Per-tier depth (ring size, or how far back by age for the journaled hours
+// and days) and min/max spread units
+struct TierConfig {
+  uint8_t size;
+  float temperatureUnit;  // °F per spread step
+  float pressureUnit;     // hPa per spread step
+  uint8_t lightUnit;      // Light codes per spread step
+};
+
+static const TierConfig tierConfig[HISTORY_TIER_COUNT] PROGMEM = {
+  {FIVE_MINUTE_RECORDS, 0.25f, 0.1f, 1},
+  {MAX_HOURLY_RECORDS,  0.5f,  0.3f, 4},
+  {MAX_DAILY_RECORDS,   2.5f,  2.0f, 8},
+  {MAX_WEEKLY_RECORDS,  4.0f,  4.0f, 8},
+};
+
+static TierConfig readTierConfig(HistoryTier tier) {
+  TierConfig config;
+  memcpy_P(&config, &tierConfig[tier], sizeof(config));
+  return config;
+}
+
+static const uint16_t daysBeforeMonth[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+// Hours since 2000-01-01 00:00 (valid for 2000-2099)
+static uint32_t hourNumber(const DateTime& time) {
+  if (time.getYear() < 2000 || time.getMonth() == 0) return 0;  // Empty slot
+  uint16_t years = time.getYear() - 2000;
+  uint8_t month = time.getMonth();
+  uint32_t days = years * 365UL + (years + 3) / 4 + daysBeforeMonth[month - 1] + time.getDay() - 1;
+  if (month > 2 && (years % 4) == 0) days++;
+  return days * 24 + time.getHour();
+}
+
+static DateTime hourNumberToDateTime(uint32_t hours, uint8_t minute = 0) {
+  uint32_t days = hours / 24;
+  uint16_t year = 2000;
+  while (true) {
+    uint16_t yearDays = (year % 4 == 0) ? 366 : 365;
+    if (days < yearDays) break;
+    days -= yearDays;
+    year++;
+  }
+  bool leap = (year % 4 == 0);
+  uint8_t month = 12;
+  while (month > 1) {
+    uint16_t before = daysBeforeMonth[month - 1] + ((leap && month > 2) ? 1 : 0);
+    if (days >= before) {
+      days -= before;
+      break;
+    }
+    month--;
+  }
+  return DateTime(year, month, days + 1, hours % 24, minute, 0);
+}
+
+// Period numbers: 5-minute steps, hours, days and Monday-based weeks since 2000-01-01
+static uint32_t periodOf(HistoryTier tier, uint32_t hour, uint8_t minute) {
+  switch (tier) {
+    case TIER_FIVE_MINUTE: return hour * 12 + minute / 5;
+    case TIER_HOURLY:      return hour;
+    case TIER_DAILY:       return hour / 24;
+    default:               return (hour / 24 + 5) / 7;  // 2000-01-01 was a Saturday
+  }
+}
+
+// Record stamp in the tier's offset unit (5-minute steps or hours)
+static uint32_t periodStamp(HistoryTier tier, uint32_t period) {
+  switch (tier) {
+    case TIER_FIVE_MINUTE: return period;
+    case TIER_HOURLY:      return period;
+    case TIER_DAILY:       return period * 24;
+    default:               return period * 7 >= 5 ? (period * 7 - 5) * 24 : 0;
+  }
+}
+
+static uint8_t quantize(float value, float unit, uint8_t maxCode) {
+  int16_t code = (int16_t)(value / unit + 0.5f);
+  return constrain(code, 0, maxCode);
+}
+
+static uint8_t lightCode(float lux) {
+  if (lux <= 0) return 0;
+  int16_t code = (int16_t)(log(1.0f + lux) * (LIGHT_CODES_PER_OCTAVE / M_LN2) + 0.5f);
+  return constrain(code, 0, LIGHT_CODE_MAX);
+}
+
+static float lightFromCode(int16_t code) {
+  if (code <= 0) return 0;
+  return exp(code * (M_LN2 / LIGHT_CODES_PER_OCTAVE)) - 1.0f;
+}
+
+static void packValues(const HistoryRecord& r, HistoryTier tier, uint8_t* body) {
+  TierConfig config = readTierConfig(tier);
+  
+  int16_t temp = (int16_t)((r.avgTemperature + 40.0f) * 10.0f + 0.5f);
+  int16_t press = (int16_t)((r.avgPressure - 800.0f) * 10.0f + 0.5f);
+  int16_t humid = (int16_t)(r.avgHumidity + 0.5f);
+  temp = constrain(temp, 0, 2047);
+  press = constrain(press, 0, 4095);
+  humid = constrain(humid, 0, 100);
+  
+  uint16_t ranges = quantize(r.avgTemperature - r.minTemperature, config.temperatureUnit, 7) |
+                    (quantize(r.maxTemperature - r.avgTemperature, config.temperatureUnit, 7) << 3) |
+                    (quantize(r.avgPressure - r.minPressure, config.pressureUnit, 3) << 6) |
+                    (quantize(r.maxPressure - r.avgPressure, config.pressureUnit, 3) << 8);
+  
+  uint32_t low = temp | ((uint32_t)press << 11) | ((uint32_t)humid << 23) | ((uint32_t)(ranges & 0x03) << 30);
+  body[0] = low & 0xFF;
+  body[1] = (low >> 8) & 0xFF;
+  body[2] = (low >> 16) & 0xFF;
+  body[3] = low >> 24;
+  body[4] = ranges >> 2;
+  
+  if (r.hasLight) {
+    uint8_t avg = lightCode(r.avgLight);
+    body[5] = avg;
+    body[6] = (quantize(avg - lightCode(r.minLight), config.lightUnit, 15) << 4) |
+              quantize(lightCode(r.maxLight) - avg, config.lightUnit, 15);
+  } else {
+    body[5] = PACKED_NO_LIGHT;
+    body[6] = 0;
+  }
+}
+
+static void unpackValues(const uint8_t* body, HistoryTier tier, HistoryRecord& r) {
+  TierConfig config = readTierConfig(tier);
+  
+  uint32_t low = body[0] | ((uint32_t)body[1] << 8) | ((uint32_t)body[2] << 16) | ((uint32_t)body[3] << 24);
+  uint16_t ranges = (low >> 30) | (body[4] << 2);
+  
+  r.avgTemperature = (low & 0x7FF) * 0.1f - 40.0f;
+  r.avgPressure = ((low >> 11) & 0xFFF) * 0.1f + 800.0f;
+  r.avgHumidity = (low >> 23) & 0x7F;
+  r.minTemperature = r.avgTemperature - (ranges & 0x07) * config.temperatureUnit;
+  r.maxTemperature = r.avgTemperature + ((ranges >> 3) & 0x07) * config.temperatureUnit;
+  r.minPressure = r.avgPressure - ((ranges >> 6) & 0x03) * config.pressureUnit;
+  r.maxPressure = r.avgPressure + ((ranges >> 8) & 0x03) * config.pressureUnit;
+  
+  r.hasLight = body[5] != PACKED_NO_LIGHT;
+  if (r.hasLight) {
+    int16_t avg = body[5];
+    r.avgLight = lightFromCode(avg);
+    r.minLight = lightFromCode(avg - (body[6] >> 4) * config.lightUnit);
+    r.maxLight = lightFromCode(avg + (body[6] & 0x0F) * config.lightUnit);
+  }
+}
+
+// Moves every record of a ring to a new base, dropping any that no longer fit
+static void rebaseRing(PackedRecord* ring, uint8_t size, uint32_t oldBase, uint32_t newBase) {
+  for (uint8_t i = 0; i < size; i++) {
+    if (ring[i].isEmpty()) continue;
+    uint32_t stamp = oldBase + ring[i].offset();
+    if (stamp < newBase || stamp - newBase >= PACKED_EMPTY_OFFSET) {
+      ring[i].clear();
+    } else {
+      ring[i].setOffset(stamp - newBase);
+    }
+  }
+}
+
+// Low byte of the CRC-16, kept clear of the uncommitted marker
+static uint8_t checkByte(uint32_t base, const uint8_t* data, uint8_t length) {
+  uint16_t crc = CRC16_INIT;
+  crc = crc16Update(crc, base & 0xFF);
+  crc = crc16Update(crc, (base >> 8) & 0xFF);
+  crc = crc16Update(crc, (base >> 16) & 0xFF);
+  for (uint8_t i = 0; i < length; i++) {
+    crc = crc16Update(crc, data[i]);
+  }
+  uint8_t check = crc & 0xFF;
+  return check == EEPROM_UNCOMMITTED ? 0xFE : check;
+}
+
+static int slotAddress(uint8_t slot) {
+  return EEPROM_DATA_START + EEPROM_HEADER_SIZE + slot * EEPROM_RECORD_SIZE;
+}
+
+// Typed views of the journal. The ATmega4809 maps its EEPROM into data space
+// at MAPPED_EEPROM_START, so there a view points straight at the stored bytes
+// and reading it is a plain load; other targets copy into the caller's scratch.
+struct JournalHeader {
+  uint8_t version;
+  uint8_t base[3];      // Base hour, little endian
+  uint8_t check;        // Over the bytes above
+};
+
+struct JournalSlot {
+  uint8_t body[EEPROM_COMMIT_BYTE];  // Packed record bytes 0-6
+  uint8_t commit;
+};
+
+static_assert(sizeof(JournalHeader) == EEPROM_HEADER_CHECK + 1 && sizeof(JournalSlot) == EEPROM_RECORD_SIZE,
+              "Journal views don't match the layout");
+
+static const JournalHeader* journalHeader(JournalHeader& scratch) {
+#ifdef MAPPED_EEPROM_START
+  (void)scratch;
+  return (const JournalHeader*)(uintptr_t)(MAPPED_EEPROM_START + EEPROM_DATA_START);
+#else
+  return &EEPROM.get(EEPROM_DATA_START, scratch);
+#endif
+}
+
+static const JournalSlot* journalSlot(uint8_t slot, JournalSlot& scratch) {
+#ifdef MAPPED_EEPROM_START
+  (void)scratch;
+  return (const JournalSlot*)(uintptr_t)(MAPPED_EEPROM_START + slotAddress(slot));
+#else
+  return &EEPROM.get(slotAddress(slot), scratch);
+#endif
+}
+
+// Offset of a committed slot, PACKED_EMPTY_OFFSET for an empty or torn one
+static uint16_t committedOffset(const JournalSlot* slot, uint32_t base) {
+  uint16_t offset = slot->body[0] | (slot->body[1] << 8);
+  if (offset == PACKED_EMPTY_OFFSET || slot->commit == EEPROM_UNCOMMITTED ||
+      slot->commit != checkByte(base, slot->body, EEPROM_COMMIT_BYTE)) {
+    return PACKED_EMPTY_OFFSET;
+  }
+  return offset;
+}
+
+// The slot in a journal ring holding the committed record at offset, or -1.
+// Offsets are compared in place; only a match pays for the check byte.
+static int8_t journalIndex(HistoryTier tier, uint16_t offset, uint32_t base) {
+  uint8_t first = tier == TIER_HOURLY ? 0 : EEPROM_HOURLY_SLOTS;
+  uint8_t count = tier == TIER_HOURLY ? EEPROM_HOURLY_SLOTS : EEPROM_DAILY_SLOTS;
+  for (uint8_t slot = first; slot < first + count; slot++) {
+    JournalSlot scratch;
+    const JournalSlot *stored = journalSlot(slot, scratch);
+    if ((stored->body[0] | (stored->body[1] << 8)) == offset && committedOffset(stored, base) == offset) {
+      return slot;
+    }
+  }
+  return -1;
+}
+
+static void fillHeader(JournalHeader& header, uint8_t version, uint32_t base) {
+  header.version = version;
+  header.base[0] = base & 0xFF;
+  header.base[1] = (base >> 8) & 0xFF;
+  header.base[2] = (base >> 16) & 0xFF;
+  header.check = checkByte(0, &header.version, EEPROM_HEADER_CHECK);
+}
+
+// False for a blank, torn, or other-layout header
+static bool readHeader(const JournalHeader* header, uint8_t version, uint32_t& base) {
+  if (header->version != version || header->check != checkByte(0, &header->version, EEPROM_HEADER_CHECK)) {
+    return false;
+  }
+  base = header->base[0] | ((uint32_t)header->base[1] << 8) | ((uint32_t)header->base[2] << 16);
+  return true;
+}
+
 bool DataLogger::init() {
-  currentHourlyIndex = 0;
-  currentDailyIndex = 0;
-  currentSampleIndex = 0;
   lastLogTime = 0;
+  setAlertRates(ALERT_PRESSURE_RATE, ALERT_TEMPERATURE_RATE);
   
-  // Initialize arrays
-  memset(hourlyData, 0, sizeof(hourlyData));
-  memset(dailyData, 0, sizeof(dailyData));
-  memset(currentHourSamples, 0, sizeof(currentHourSamples));
-  
-  // Load existing data from EEPROM
-  loadFromEEPROM();
+  // Restore history from the AT24C32 if fitted, else the internal EEPROM
+  // (see restoreMicros for the boot cost)
+  externalHistory = externalEeprom.begin();
+  reloadFromStore();
   
   // Serial.println(F("Data logger initialized"));
   return true;
 }
 
+// Index into the arrays kept for the hourly and daily tiers only (percentile
+// estimators, newestRecord), or -1
+static int8_t hourlyOrDaily(HistoryTier tier) {
+  return tier == TIER_HOURLY ? 0 : (tier == TIER_DAILY ? 1 : -1);
+}
+
+// Marker probabilities in twentieths: 0, .05, .1, .3, .5, .7, .9, .95, 1
+static const uint8_t quantileMarkerTwentieths[QUANTILE_MARKERS] PROGMEM = {0, 1, 2, 6, 10, 14, 18, 19, 20};
+
+void QuantileEstimator::add(float value) {
+  // Warm-up: insertion sort into the marker heights
+  if (count < QUANTILE_MARKERS) {
+    uint8_t i = count;
+    while (i > 0 && height[i - 1] > value) {
+      height[i] = height[i - 1];
+      i--;
+    }
+    height[i] = value;
+    count++;
+    if (count == QUANTILE_MARKERS) {
+      for (uint8_t m = 0; m < QUANTILE_MARKERS; m++) {
+        position[m] = m + 1;
+      }
+    }
+    return;
+  }
+  if (count == UINT16_MAX) {
+    return;  // Saturated - far beyond a day of 30 s samples
+  }
+  count++;
+  
+  // Cell the sample falls in; the extremes track min and max exactly
+  uint8_t cell;
+  if (value < height[0]) {
+    height[0] = value;
+    cell = 0;
+  } else if (value >= height[QUANTILE_MARKERS - 1]) {
+    height[QUANTILE_MARKERS - 1] = value;
+    cell = QUANTILE_MARKERS - 2;
+  } else {
+    cell = 0;
+    while (value >= height[cell + 1]) {
+      cell++;
+    }
+  }
+  for (uint8_t m = cell + 1; m < QUANTILE_MARKERS; m++) {
+    position[m]++;
+  }
+  
+  // Move interior markers that drifted a whole rank from where they should be
+  for (uint8_t m = 1; m < QUANTILE_MARKERS - 1; m++) {
+    float desired = 1.0f + (count - 1) * pgm_read_byte(&quantileMarkerTwentieths[m]) / 20.0f;
+    float drift = desired - position[m];
+    int8_t step;
+    if (drift >= 1.0f && position[m + 1] - position[m] > 1) {
+      step = 1;
+    } else if (drift <= -1.0f && position[m - 1] - position[m] < -1) {
+      step = -1;
+    } else {
+      continue;
+    }
+    
+    // Piecewise-parabolic prediction, falling back to linear if it would
+    // leave the markers out of order
+    float below = position[m] - position[m - 1];
+    float above = position[m + 1] - position[m];
+    float h = height[m] + step / (below + above) *
+              ((below + step) * (height[m + 1] - height[m]) / above +
+               (above - step) * (height[m] - height[m - 1]) / below);
+    if (!(h > height[m - 1] && h < height[m + 1])) {
+      uint8_t n = m + step;
+      h = height[m] + step * (height[n] - height[m]) / ((int16_t)position[n] - (int16_t)position[m]);
+    }
+    height[m] = h;
+    position[m] += step;
+  }
+}
+
+float QuantileEstimator::get(Quantile quantile) const {
+  if (count == 0) {
+    return NAN;
+  }
+  uint8_t twentieths = quantile == QUANTILE_P10 ? 2 : (quantile == QUANTILE_MEDIAN ? 10 : 18);
+  if (count < QUANTILE_MARKERS) {
+    return height[((count - 1) * twentieths + 10) / 20];  // Exact, nearest rank
+  }
+  return height[quantile * 2 + 2];
+}
+
+void DataLogger::addSample(HistoryChannel channel, float value) {
+  pending[TIER_FIVE_MINUTE][channel].add(value);
+  pendingQuantiles[0][channel].add(value);
+  pendingQuantiles[1][channel].add(value);
+}
+
+void DataLogger::clearClosedQuantiles() {
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    for (uint8_t channel = 0; channel < HISTORY_CHANNEL_COUNT; channel++) {
+      for (uint8_t q = 0; q < QUANTILE_COUNT; q++) {
+        closedQuantiles[slot][channel][q] = NAN;
+      }
+    }
+  }
+}
+
+bool DataLogger::getQuantile(HistoryTier tier, HistoryChannel channel, Quantile quantile,
+                             float& value, bool current) {
+  int8_t slot = hourlyOrDaily(tier);
+  if (slot < 0) {
+    return false;
+  }
+  float estimate = current ? pendingQuantiles[slot][channel].get(quantile)
+                           : closedQuantiles[slot][channel][quantile];
+  if (isnan(estimate)) {
+    return false;
+  }
+  value = estimate;
+  return true;
+}
+
+void DataLogger::resetPending(HistoryTier tier) {
+  int8_t slot = hourlyOrDaily(tier);
+  for (uint8_t channel = 0; channel < HISTORY_CHANNEL_COUNT; channel++) {
+    pending[tier][channel].reset();
+    if (slot >= 0) {
+      pendingQuantiles[slot][channel].reset();
+    }
+  }
+}
+
 void DataLogger::update(SensorData currentData) {
   unsigned long currentTime = millis();
   
-  // Store current sample
-  currentHourSamples[currentSampleIndex] = currentData;
-  currentSampleIndex = (currentSampleIndex + 1) % 12;  // Reduced from 60 to 12
+  if (externalDailyPending) {
+    externalDailyPending = false;
+    saveExternalRecords(TIER_DAILY, newestPeriod[TIER_DAILY], externalDailyLast);
+  }
+  
+  // Without a valid timestamp the sample can't be placed in history
+  if (!(currentData.validFlags & SENSOR_VALID_TIME)) {
+    return;
+  }
+  
+  uint32_t hour = hourNumber(currentData.currentTime);
+  uint8_t minute = currentData.currentTime.getMinute();
   
-  // Check if it's time to log hourly data
-  DateTime now = currentData.currentTime;
-  if (now.getHour() != lastHourLogged.getHour() || 
-      (lastHourLogged.getYear() == 0)) { // First run
-    logHourlyData();
-    lastHourLogged = now;
+  // Close finished periods finest first, so each one folds into the tier
+  // above before that tier is checked
+  for (uint8_t tier = 0; tier < HISTORY_TIER_COUNT; tier++) {
+    uint32_t period = periodOf((HistoryTier)tier, hour, minute);
+    if (periodsStarted && period != pendingPeriod[tier]) {
+      closePeriod((HistoryTier)tier);
+    }
+    pendingPeriod[tier] = period;
   }
+  periodsStarted = true;
   
-  // Check if it's time to log daily data
-  if (now.getDay() != lastDayLogged.getDay() || 
-      (lastDayLogged.getYear() == 0)) { // First run
-    logDailyData();
-    lastDayLogged = now;
+  updateFastAlerts(currentData, hour * 60 + minute);
+  
+  // Absorb the sample - stale channels are skipped
+  if (currentData.validFlags & SENSOR_VALID_CLIMATE) {
+    addSample(CHANNEL_TEMPERATURE, currentData.temperatureF);
+    addSample(CHANNEL_HUMIDITY, currentData.humidity);
+  }
+  if (currentData.validFlags & SENSOR_VALID_PRESSURE) {
+    addSample(CHANNEL_PRESSURE, currentData.pressure);
+  }
+  if (currentData.validFlags & SENSOR_VALID_LIGHT) {
+    addSample(CHANNEL_LIGHT, currentData.lightLevel);
   }
   
   lastLogTime = currentTime;
 }
 
-void DataLogger::logHourlyData() {
-  if (currentSampleIndex == 0) return; // No samples yet
+void DataLogger::closePeriod(HistoryTier tier) {
+  ChannelAccumulator *acc = pending[tier];
+  if (acc[CHANNEL_TEMPERATURE].count == 0 && acc[CHANNEL_PRESSURE].count == 0 &&
+      acc[CHANNEL_LIGHT].count == 0) {
+    return; // No samples in this period
+  }
   
-  HourlyRecord record;
-  record.timestamp = currentHourSamples[0].currentTime;
+  // A channel with no good samples carries the previous period forward,
+  // so trends see zero change instead of a jump to zero. With no previous
+  // record there is nothing to carry - zeros would read as 0°F and 800 hPa
+  // - so the period is not stored, but its samples still roll up.
+  HistoryRecord previous;
+  bool hasPrevious = getRecordValues(tier, 0, previous);
+  if (hasPrevious || (acc[CHANNEL_TEMPERATURE].count > 0 && acc[CHANNEL_PRESSURE].count > 0)) {
+    storePeriod(tier, previous);
+  }
   
-  // Calculate averages
-  float tempSum = 0, humSum = 0, pressSum = 0;
-  float minTemp = 999, maxTemp = -999;
-  float minPress = 9999, maxPress = 0;
-  
-  uint8_t validSamples = 0;
-  for (int i = 0; i < currentSampleIndex && i < 12; i++) {  // Limited to 12 samples
-    if (currentHourSamples[i].currentTime.getYear() > 0) { // Valid sample
-      tempSum += currentHourSamples[i].temperatureF;
-      humSum += currentHourSamples[i].humidity;
-      pressSum += currentHourSamples[i].pressure;
-      
-      if (currentHourSamples[i].temperatureF < minTemp) {
-        minTemp = currentHourSamples[i].temperatureF;
-      }
-      if (currentHourSamples[i].temperatureF > maxTemp) {
-        maxTemp = currentHourSamples[i].temperatureF;
-      }
-      if (currentHourSamples[i].pressure < minPress) {
-        minPress = currentHourSamples[i].pressure;
-      }
-      if (currentHourSamples[i].pressure > maxPress) {
-        maxPress = currentHourSamples[i].pressure;
+  // Roll the raw statistics up into the next tier
+  if (tier + 1 < HISTORY_TIER_COUNT) {
+    for (uint8_t channel = 0; channel < HISTORY_CHANNEL_COUNT; channel++) {
+      pending[tier + 1][channel].merge(acc[channel]);
+    }
+  }
+  resetPending(tier);
+}
+
+// Builds and stores the record for the pending period; channels without
+// samples take the previous record's average
+void DataLogger::storePeriod(HistoryTier tier, const HistoryRecord& previous) {
+  ChannelAccumulator *acc = pending[tier];
+  
+  int8_t slot = hourlyOrDaily(tier);
+  if (slot >= 0) {
+    for (uint8_t channel = 0; channel < HISTORY_CHANNEL_COUNT; channel++) {
+      for (uint8_t q = 0; q < QUANTILE_COUNT; q++) {
+        closedQuantiles[slot][channel][q] = pendingQuantiles[slot][channel].get((Quantile)q);
       }
-      
-      validSamples++;
     }
   }
   
-  if (validSamples > 0) {
-    record.avgTemperature = tempSum / validSamples;
-    record.avgHumidity = humSum / validSamples;
-    record.avgPressure = pressSum / validSamples;
-    record.minTemperature = minTemp;
-    record.maxTemperature = maxTemp;
-    record.minPressure = minPress;
-    record.maxPressure = maxPress;
-    
-    // Store in circular buffer
-    hourlyData[currentHourlyIndex] = record;
-    currentHourlyIndex = (currentHourlyIndex + 1) % MAX_HOURLY_RECORDS;
-    
-    // Save to EEPROM
-    saveToEEPROM();
-    
-    // Serial.println(F("Hourly data logged"));
+  HistoryRecord record;
+  
+  if (acc[CHANNEL_TEMPERATURE].count > 0) {
+    record.avgTemperature = acc[CHANNEL_TEMPERATURE].mean;
+    record.avgHumidity = acc[CHANNEL_HUMIDITY].mean;
+    record.minTemperature = acc[CHANNEL_TEMPERATURE].minValue;
+    record.maxTemperature = acc[CHANNEL_TEMPERATURE].maxValue;
+  } else {
+    record.avgTemperature = previous.avgTemperature;
+    record.avgHumidity = previous.avgHumidity;
+    record.minTemperature = previous.avgTemperature;
+    record.maxTemperature = previous.avgTemperature;
   }
   
-  // Reset sample buffer
-  currentSampleIndex = 0;
+  if (acc[CHANNEL_PRESSURE].count > 0) {
+    record.avgPressure = acc[CHANNEL_PRESSURE].mean;
+    record.minPressure = acc[CHANNEL_PRESSURE].minValue;
+    record.maxPressure = acc[CHANNEL_PRESSURE].maxValue;
+  } else {
+    record.avgPressure = previous.avgPressure;
+    record.minPressure = previous.avgPressure;
+    record.maxPressure = previous.avgPressure;
+  }
+  
+  record.hasLight = acc[CHANNEL_LIGHT].count > 0;
+  record.avgLight = acc[CHANNEL_LIGHT].mean;
+  record.minLight = acc[CHANNEL_LIGHT].minValue;
+  record.maxLight = acc[CHANNEL_LIGHT].maxValue;
+  
+  storeRecord(tier, pendingPeriod[tier], record);
+  if (tier == TIER_HOURLY) {
+    hourlyHistoryChanged(true);
+  }
 }
 
-void DataLogger::logDailyData() {
-  // Calculate daily averages from hourly data
-  DailyRecord record;
-  record.date = lastDayLogged;
+// 5-minute and weekly records are direct-mapped in SRAM: a period always
+// lives in slot period % size, so lookups by time are O(1) and a gap simply
+// leaves slots that no longer match their expected period. Hours and days
+// go straight to the journal.
+void DataLogger::storeRecord(HistoryTier tier, uint32_t period, const HistoryRecord& record) {
+  uint32_t stamp = periodStamp(tier, period);
+  if (tier == TIER_FIVE_MINUTE) {
+    ensureFiveMinuteBase(stamp);
+  } else {
+    ensureHistoryBase(stamp);
+  }
+  uint32_t base = tierBase(tier);
   
-  float tempSum = 0, humSum = 0, pressSum = 0;
-  float minTemp = 999, maxTemp = -999;
-  float minPress = 9999, maxPress = 0;
-  int validHours = 0;
-  
-  // Look at last 24 hours of data
-  for (int i = 0; i < 24 && i < MAX_HOURLY_RECORDS; i++) {
-    int index = (currentHourlyIndex - 1 - i + MAX_HOURLY_RECORDS) % MAX_HOURLY_RECORDS;
-    HourlyRecord &hourly = hourlyData[index];
-    
-    if (hourly.timestamp.getYear() > 0) { // Valid record
-      tempSum += hourly.avgTemperature;
-      humSum += hourly.avgHumidity;
-      pressSum += hourly.avgPressure;
-      
-      if (hourly.minTemperature < minTemp) minTemp = hourly.minTemperature;
-      if (hourly.maxTemperature > maxTemp) maxTemp = hourly.maxTemperature;
-      if (hourly.minPressure < minPress) minPress = hourly.minPressure;
-      if (hourly.maxPressure > maxPress) maxPress = hourly.maxPressure;
-      
-      validHours++;
-    }
-  }
-  
-  if (validHours > 0) {
-    record.avgTemperature = tempSum / validHours;
-    record.avgHumidity = humSum / validHours;
-    record.avgPressure = pressSum / validHours;
-    record.minTemperature = minTemp;
-    record.maxTemperature = maxTemp;
-    record.minPressure = minPress;
-    record.maxPressure = maxPress;
-    
-    // Store in circular buffer
-    dailyData[currentDailyIndex] = record;
-    currentDailyIndex = (currentDailyIndex + 1) % MAX_DAILY_RECORDS;
-    
-    // Serial.println(F("Daily data logged"));
+  // The clock was set back: records "after" this one are from the old
+  // timeline and would otherwise read as newer than anything logged next
+  uint32_t previous = newestPeriod[tier];
+  bool rewound = period < previous && dropNewerThan(tier, period);
+  
+  PackedRecord packed;
+  packed.clear();  // Older than the base can express stays empty
+  if (stamp >= base) {
+    packed.setOffset(stamp - base);
+    packValues(record, tier, packed.bytes + 2);
+  }
+  newestPeriod[tier] = period;
+  
+  int8_t slot = hourlyOrDaily(tier);
+  if (slot < 0) {
+    ringData(tier)[period % getTierSize(tier)] = packed;
+    return;
+  }
+  newestRecord[slot] = packed;
+  
+  if (!externalHistory) {
+    if (!packed.isEmpty()) {
+      saveToJournal(tier, packed);
+    }
+  } else if (tier == TIER_DAILY) {
+    // A day closes together with an hour; its slot goes out with the next
+    // sample, after that hour's write cycle, so neither waits on the other
+    externalDailyLast = max(externalDailyPending ? externalDailyLast : period, rewound ? previous : period);
+    externalDailyPending = true;
+  } else {
+    saveExternalRecords(tier, period, rewound ? previous : period);
   }
 }
 
-HourlyRecord DataLogger::getHourlyRecord(uint8_t hoursAgo) {
-  if (hoursAgo >= MAX_HOURLY_RECORDS) {
-    return HourlyRecord(); // Return empty record
+// Clears every record stamped after period. Returns true if any was. On the
+// AT24C32 the slots are emptied by saveExternalRecords, together with the
+// new record.
+bool DataLogger::dropNewerThan(HistoryTier tier, uint32_t period) {
+  uint32_t stamp = periodStamp(tier, period);
+  uint32_t base = tierBase(tier);
+  bool dropped = false;
+  
+  int8_t slot = hourlyOrDaily(tier);
+  if (slot < 0) {
+    PackedRecord *ring = ringData(tier);
+    for (uint8_t i = 0; i < getTierSize(tier); i++) {
+      if (!ring[i].isEmpty() && (stamp < base || ring[i].offset() > stamp - base)) {
+        ring[i].clear();
+        dropped = true;
+      }
+    }
+    return dropped;
   }
   
-  int index = (currentHourlyIndex - 1 - hoursAgo + MAX_HOURLY_RECORDS) % MAX_HOURLY_RECORDS;
-  return hourlyData[index];
+  newestRecord[slot].clear();
+  if (externalHistory) {
+    return true;
+  }
+  PackedRecord missing;
+  missing.clear();
+  uint8_t first = tier == TIER_HOURLY ? 0 : EEPROM_HOURLY_SLOTS;
+  uint8_t count = tier == TIER_HOURLY ? EEPROM_HOURLY_SLOTS : EEPROM_DAILY_SLOTS;
+  for (uint8_t i = first; i < first + count; i++) {
+    JournalSlot scratch;
+    uint16_t offset = committedOffset(journalSlot(i, scratch), historyBaseHour);
+    if (offset != PACKED_EMPTY_OFFSET && (stamp < base || offset > stamp - base)) {
+      writeSlot(i, missing);
+      dropped = true;
+    }
+  }
+  return dropped;
+}
+
+uint8_t DataLogger::getTierSize(HistoryTier tier) {
+  return pgm_read_byte(&tierConfig[tier].size);
 }
 
-DailyRecord DataLogger::getDailyRecord(uint8_t daysAgo) {
-  if (daysAgo >= MAX_DAILY_RECORDS) {
-    return DailyRecord(); // Return empty record
+PackedRecord* DataLogger::ringData(HistoryTier tier) {
+  return tier == TIER_FIVE_MINUTE ? fiveMinuteData : weeklyData;
+}
+
+uint32_t DataLogger::tierBase(HistoryTier tier) {
+  return tier == TIER_FIVE_MINUTE ? fiveMinuteBase : historyBaseHour;
+}
+
+// The stored form of a period's record, if the tier holds it. Hours and days
+// come from the journal, checked where they lie; the newest of each, which
+// most queries start from, is answered from newestRecord.
+bool DataLogger::findRecord(HistoryTier tier, uint32_t period, PackedRecord& packed) {
+  uint32_t stamp = periodStamp(tier, period);
+  uint32_t base = tierBase(tier);
+  if (stamp < base || stamp - base >= PACKED_EMPTY_OFFSET) {
+    return false;
   }
+  uint16_t offset = stamp - base;
   
-  int index = (currentDailyIndex - 1 - daysAgo + MAX_DAILY_RECORDS) % MAX_DAILY_RECORDS;
-  return dailyData[index];
+  int8_t slot = hourlyOrDaily(tier);
+  if (slot < 0) {
+    packed = ringData(tier)[period % getTierSize(tier)];
+    return packed.offset() == offset;
+  }
+  if (!eepromImageValid) {
+    return false;  // No image, or one being imported
+  }
+  if (newestRecord[slot].offset() == offset) {
+    packed = newestRecord[slot];
+    return true;
+  }
+  if (externalHistory) {
+    return readExternalRecord(tier, period, packed);
+  }
+  
+  int8_t index = journalIndex(tier, offset, historyBaseHour);
+  if (index < 0) {
+    return false;
+  }
+  JournalSlot scratch;
+  packed.clear();  // Light isn't journaled
+  memcpy(packed.bytes, journalSlot(index, scratch)->body, EEPROM_COMMIT_BYTE);
+  return true;
 }
 
-float DataLogger::getAverageTemperature(uint8_t hours) {
-  float sum = 0;
-  int count = 0;
+bool DataLogger::recordAt(HistoryTier tier, uint8_t ago, PackedRecord& packed) {
+  if (ago >= getTierSize(tier) || ago > newestPeriod[tier]) {
+    return false;
+  }
+  return findRecord(tier, newestPeriod[tier] - ago, packed);
+}
+
+bool DataLogger::hasRecord(HistoryTier tier, uint8_t ago) {
+  PackedRecord packed;
+  return recordAt(tier, ago, packed);
+}
+
+// Decodes everything but the timestamp, which is the costly part.
+// Returns false (and a zeroed record) for a missing period.
+bool DataLogger::getRecordValues(HistoryTier tier, uint8_t ago, HistoryRecord& record) {
+  record.clear();
+  PackedRecord packed;
+  if (!recordAt(tier, ago, packed)) {
+    return false;
+  }
+  unpackValues(packed.bytes + 2, tier, record);
+  return true;
+}
+
+DateTime DataLogger::recordTime(HistoryTier tier, uint16_t offset) {
+  if (tier == TIER_FIVE_MINUTE) {
+    uint32_t step = fiveMinuteBase + offset;
+    return hourNumberToDateTime(step / 12, (step % 12) * 5);
+  }
+  return hourNumberToDateTime(historyBaseHour + offset);
+}
+
+HistoryRecord DataLogger::getRecord(HistoryTier tier, uint8_t ago) {
+  HistoryRecord record;
+  record.clear();
+  PackedRecord packed;
+  if (recordAt(tier, ago, packed)) {
+    unpackValues(packed.bytes + 2, tier, record);
+    record.timestamp = recordTime(tier, packed.offset());
+  }
+  return record;
+}
+
+// Any period the tier still holds, however far back: on the AT24C32 the
+// hourly tier reaches EXT_HISTORY_HOURLY_SLOTS hours
+bool DataLogger::getRecordAt(HistoryTier tier, DateTime time, HistoryRecord& record) {
+  record.clear();
+  uint32_t period = periodOf(tier, hourNumber(time), time.getMinute());
+  PackedRecord packed;
+  if (period > newestPeriod[tier] || !findRecord(tier, period, packed)) {
+    return false;  // Not yet closed, or no longer stored
+  }
+  unpackValues(packed.bytes + 2, tier, record);
+  record.timestamp = recordTime(tier, packed.offset());
+  return true;
+}
+
+// Moves the base forward when an hour no longer fits in a 16-bit offset
+// (every ~7 years). Records that fall behind the new base are dropped.
+// Returns true if the base moved.
+bool DataLogger::ensureHistoryBase(uint32_t hour) {
+  if (hour < historyBaseHour || hour - historyBaseHour < PACKED_EMPTY_OFFSET) {
+    return false;  // Fits, or predates the base and is stored as empty
+  }
   
-  for (uint8_t i = 0; i < hours && i < MAX_HOURLY_RECORDS; i++) {
-    HourlyRecord record = getHourlyRecord(i);
-    if (record.timestamp.getYear() > 0) {
-      sum += record.avgTemperature;
+  uint32_t oldBase = historyBaseHour;
+  historyBaseHour = hour > HISTORY_BASE_LEAD_HOURS ? hour - HISTORY_BASE_LEAD_HOURS : 0;
+  rebaseRing(weeklyData, MAX_WEEKLY_RECORDS, oldBase, historyBaseHour);
+  rebaseRing(newestRecord, 2, oldBase, historyBaseHour);
+  rebaseStore(oldBase);
+  return true;
+}
+
+// Same for the 5-minute ring, which has its own base (every ~227 days)
+bool DataLogger::ensureFiveMinuteBase(uint32_t step) {
+  if (step < fiveMinuteBase || step - fiveMinuteBase < PACKED_EMPTY_OFFSET) {
+    return false;
+  }
+  
+  uint32_t newBase = step > FIVE_MINUTE_BASE_LEAD ? step - FIVE_MINUTE_BASE_LEAD : 0;
+  rebaseRing(fiveMinuteData, FIVE_MINUTE_RECORDS, fiveMinuteBase, newBase);
+  fiveMinuteBase = newBase;
+  return true;
+}
+
+static uint16_t toFixed(float value, float offset) {
+  int32_t fixed = (int32_t)((value + offset) * 100.0f + 0.5f);
+  return constrain(fixed, 0, WINDOW_STATS_EMPTY - 1);
+}
+
+static float fromFixed(uint16_t fixed, float offset) {
+  return fixed * 0.01f - offset;
+}
+
+// One pass from the newest hourly record back. With everyHour set, out[h - 1]
+// receives the aggregate of the newest h records for every h; otherwise only
+// out[0] receives the full window.
+void DataLogger::scanHourly(uint8_t hours, WindowStats* out, bool everyHour) {
+  float tempSum = 0, humSum = 0, pressSum = 0;
+  float minTemp = 0, maxTemp = 0, minPress = 0, maxPress = 0;
+  uint8_t count = 0;
+  
+  for (uint8_t i = 0; i < hours; i++) {
+    HistoryRecord record;
+    if (getRecordValues(TIER_HOURLY, i, record)) {
+      if (count == 0 || record.minTemperature < minTemp) minTemp = record.minTemperature;
+      if (count == 0 || record.maxTemperature > maxTemp) maxTemp = record.maxTemperature;
+      if (count == 0 || record.minPressure < minPress) minPress = record.minPressure;
+      if (count == 0 || record.maxPressure > maxPress) maxPress = record.maxPressure;
+      tempSum += record.avgTemperature;
+      humSum += record.avgHumidity;
+      pressSum += record.avgPressure;
       count++;
     }
+    
+    if (!everyHour && i + 1 < hours) continue;
+    WindowStats &stats = everyHour ? out[i] : out[0];
+    if (count == 0) {
+      stats.avgTemperature = WINDOW_STATS_EMPTY;
+      continue;
+    }
+    stats.avgTemperature = toFixed(tempSum / count, 40.0f);
+    stats.avgHumidity = toFixed(humSum / count, 0);
+    stats.avgPressure = toFixed(pressSum / count, -800.0f);
+    stats.minTemperature = toFixed(minTemp, 40.0f);
+    stats.maxTemperature = toFixed(maxTemp, 40.0f);
+    stats.minPressure = toFixed(minPress, -800.0f);
+    stats.maxPressure = toFixed(maxPress, -800.0f);
   }
-  
-  return count > 0 ? sum / count : 0;
 }
 
-float DataLogger::getAveragePressure(uint8_t hours) {
+// Called whenever the hourly ring changes - one scan of WINDOW_STATS_HOURS
+// records per hour keeps every window query O(1)
+void DataLogger::rebuildWindowStats() {
+  scanHourly(WINDOW_STATS_HOURS, windowStats, true);
+}
+
+bool DataLogger::getWindowStats(uint8_t hours, WindowStats& stats) {
+  if (hours == 0) {
+    return false;
+  }
+  if (hours <= WINDOW_STATS_HOURS) {
+    stats = windowStats[hours - 1];
+  } else {
+    scanHourly(min(hours, (uint8_t)MAX_HOURLY_RECORDS), &stats, false);
+  }
+  return stats.avgTemperature != WINDOW_STATS_EMPTY;
+}
+
+float DataLogger::getAverage(HistoryChannel channel, uint8_t hours) {
+  WindowStats stats;
+  if (channel != CHANNEL_LIGHT && hours <= MAX_HOURLY_RECORDS) {
+    if (!getWindowStats(hours, stats)) return 0;
+    switch (channel) {
+      case CHANNEL_TEMPERATURE: return fromFixed(stats.avgTemperature, 40.0f);
+      case CHANNEL_HUMIDITY:    return fromFixed(stats.avgHumidity, 0);
+      default:                  return fromFixed(stats.avgPressure, -800.0f);
+    }
+  }
+  
+  // Light, and windows past the hourly ring, average whole records
+  HistoryTier tier;
+  uint8_t periods;
+  if (hours <= MAX_HOURLY_RECORDS) {
+    tier = TIER_HOURLY;
+    periods = hours;
+  } else {
+    tier = TIER_DAILY;
+    periods = (hours + 23) / 24;
+  }
+  
   float sum = 0;
   int count = 0;
   
-  for (uint8_t i = 0; i < hours && i < MAX_HOURLY_RECORDS; i++) {
-    HourlyRecord record = getHourlyRecord(i);
-    if (record.timestamp.getYear() > 0) {
-      sum += record.avgPressure;
-      count++;
+  for (uint8_t i = 0; i < periods; i++) {
+    HistoryRecord record;
+    if (!getRecordValues(tier, i, record)) continue;
+    
+    switch (channel) {
+      case CHANNEL_TEMPERATURE: sum += record.avgTemperature; break;
+      case CHANNEL_HUMIDITY:    sum += record.avgHumidity; break;
+      case CHANNEL_PRESSURE:    sum += record.avgPressure; break;
+      default:
+        if (!record.hasLight) continue;
+        sum += record.avgLight;
+        break;
     }
+    count++;
   }
   
   return count > 0 ? sum / count : 0;
 }
 
-TrendData DataLogger::calculateTrends() {
-  TrendData trends;
+float DataLogger::getMinTemperature(uint8_t hours) {
+  WindowStats stats;
+  return getWindowStats(hours, stats) ? fromFixed(stats.minTemperature, 40.0f) : 0;
+}
+
+float DataLogger::getMaxTemperature(uint8_t hours) {
+  WindowStats stats;
+  return getWindowStats(hours, stats) ? fromFixed(stats.maxTemperature, 40.0f) : 0;
+}
+
+float DataLogger::getMinPressure(uint8_t hours) {
+  WindowStats stats;
+  return getWindowStats(hours, stats) ? fromFixed(stats.minPressure, -800.0f) : 0;
+}
+
+float DataLogger::getMaxPressure(uint8_t hours) {
+  WindowStats stats;
+  return getWindowStats(hours, stats) ? fromFixed(stats.maxPressure, -800.0f) : 0;
+}
+
+ChannelAccumulator DataLogger::getCurrentPeriod(HistoryTier tier, HistoryChannel channel) {
+  ChannelAccumulator total = pending[tier][channel];
+  for (uint8_t finer = 0; finer < tier; finer++) {
+    total.merge(pending[finer][channel]);
+  }
+  return total;
+}
+
+// Slope of y over x and its R^2, from running sums over n points
+static float fitLine(uint8_t n, float sumX, float sumXX, float sumY, float sumXY, float sumYY, float& fit) {
+  float sxx = sumXX - sumX * sumX / n;
+  float sxy = sumXY - sumX * sumY / n;
+  float syy = sumYY - sumY * sumY / n;
+  if (sxx <= 0) {
+    fit = 0;
+    return 0;
+  }
+  float slope = sxy / sxx;
+  // A flat series is a perfect (zero) fit
+  fit = syy > 1e-6f ? constrain(slope * sxy / syy, 0.0f, 1.0f) : 1.0f;
+  return slope;
+}
+
+// Fits a line to each channel over the last TREND_WINDOW_HOURS hours.
+// Missing hours are skipped and x is each record's own hour, so gaps in
+// the log don't skew the slope. Values are taken relative to the newest record to keep the float
+// sums well conditioned at ~1000 hPa.
+void DataLogger::updateTrends() {
+  memset(&trends, 0, sizeof(trends));
+  
+  HistoryRecord newest;
+  if (!getRecordValues(TIER_HOURLY, 0, newest)) {
+    return;
+  }
+  float sumX = 0, sumXX = 0;
+  float sumY[3] = {0, 0, 0}, sumXY[3] = {0, 0, 0}, sumYY[3] = {0, 0, 0};
+  uint8_t n = 0;
+  
+  for (uint8_t i = 0; i < TREND_WINDOW_HOURS; i++) {
+    HistoryRecord record;
+    if (!getRecordValues(TIER_HOURLY, i, record)) continue;
+    
+    float x = -(float)i;
+    float y[3] = {
+      record.avgTemperature - newest.avgTemperature,
+      record.avgPressure - newest.avgPressure,
+      record.avgHumidity - newest.avgHumidity
+    };
+    sumX += x;
+    sumXX += x * x;
+    for (uint8_t c = 0; c < 3; c++) {
+      sumY[c] += y[c];
+      sumXY[c] += x * y[c];
+      sumYY[c] += y[c] * y[c];
+    }
+    n++;
+  }
+  
+  trends.points = n;
+  if (n < TREND_MIN_POINTS) {
+    return;
+  }
+  
+  trends.temperatureTrend = fitLine(n, sumX, sumXX, sumY[0], sumXY[0], sumYY[0], trends.temperatureFit);
+  trends.pressureTrend = fitLine(n, sumX, sumXX, sumY[1], sumXY[1], sumYY[1], trends.pressureFit);
+  trends.humidityTrend = fitLine(n, sumX, sumXX, sumY[2], sumXY[2], sumYY[2], trends.humidityFit);
+  
+  bool pressureReliable = trends.pressureFit >= TREND_MIN_FIT;
+  trends.risingPressure = pressureReliable && trends.pressureTrend > 1.0; // Rising > 1 hPa/hour
+  trends.fallingPressure = pressureReliable && trends.pressureTrend < -1.0; // Falling > 1 hPa/hour
+  trends.rapidTempChange = trends.temperatureFit >= TREND_MIN_FIT &&
+                           abs(trends.temperatureTrend) > 2.0; // > 2°F/hour
+}
+
+// Everything derived from the hourly ring is recomputed here, once per
+// change. appended means one new record; otherwise the ring was replaced.
+void DataLogger::hourlyHistoryChanged(bool appended) {
+  rebuildWindowStats();
+  updateTrends();
   
-  // Get current and 3-hour-ago data for trend calculation
-  HourlyRecord current = getHourlyRecord(0);
-  HourlyRecord threeHoursAgo = getHourlyRecord(3);
+  if (appended) {
+    // The 24-hour mean is already in the window table
+    if (hasRecord(TIER_HOURLY, 23)) {
+      HistoryRecord newest;
+      getRecordValues(TIER_HOURLY, 0, newest);
+      learnDiurnal(0, (int16_t)lroundf(newest.avgTemperature * 10),
+                   ((int16_t)windowStats[23].avgTemperature - 4000) / 10);
+    }
+  } else {
+    rebuildDiurnal();
+  }
+  updateForecast(appended);
+}
+
+// Zambretti letter for each tendency over 22 pressure bands from 950 to
+// 1050 hPa (sea level), low pressure first
+#define ZAMBRETTI_BANDS 22
+#define ZAMBRETTI_LOW_DHPA 9500
+#define ZAMBRETTI_RANGE_DHPA 1000
+#define ZAMBRETTI_SEASON_DHPA 70   // Summer rises and winter falls shift by 7% of the range
+
+static const uint8_t zambrettiTable[3][ZAMBRETTI_BANDS] PROGMEM = {
+  {25, 25, 25, 25, 25, 25, 25, 25, 23, 23, 21, 20, 17, 14, 7, 3, 1, 1, 1, 0, 0, 0},  // Falling
+  {25, 25, 25, 25, 25, 25, 23, 23, 22, 18, 15, 13, 10, 4, 1, 1, 0, 0, 0, 0, 0, 0},   // Steady
+  {25, 25, 25, 24, 24, 19, 16, 12, 11, 9, 8, 6, 5, 2, 1, 1, 0, 0, 0, 0, 0, 0}        // Rising
+};
+
+uint8_t DataLogger::hourOfDay(uint8_t ago) {
+  return (newestPeriod[TIER_HOURLY] - ago) % 24;
+}
+
+// Pulls the curve at the record's hour of day toward its offset from the
+// mean of the 24 hours ending there. All values in 0.1 °F.
+void DataLogger::learnDiurnal(uint8_t ago, int16_t temperature, int16_t mean) {
+  int16_t &slot = diurnal[hourOfDay(ago)];
+  slot += (temperature - mean - slot) / DIURNAL_WEIGHT;
+}
+
+// Replays the hourly tier oldest first with a sliding 24-hour sum, so a
+// restored history trains the curve the same way live data
+// does. As live, an hour only teaches the curve when the hour 23 before it
+// is present too. Each record is read once; the window keeps the last 24.
+void DataLogger::rebuildDiurnal() {
+  memset(diurnal, 0, sizeof(diurnal));
   
-  if (current.timestamp.getYear() > 0 && threeHoursAgo.timestamp.getYear() > 0) {
-    // Calculate trends per hour
-    trends.temperatureTrend = (current.avgTemperature - threeHoursAgo.avgTemperature) / 3.0;
-    trends.pressureTrend = (current.avgPressure - threeHoursAgo.avgPressure) / 3.0;
-    trends.humidityTrend = (current.avgHumidity - threeHoursAgo.avgHumidity) / 3.0;
+  int16_t window[24];    // 0.1 °F, cell = ago % 24
+  uint32_t present = 0;  // Bit per cell
+  int32_t sum = 0;
+  uint8_t count = 0;
+  for (int16_t ago = MAX_HOURLY_RECORDS - 1; ago >= 0; ago--) {
+    // The cell last held the hour 24 before this one
+    uint8_t cell = ago % 24;
+    if (present & (1UL << cell)) {
+      sum -= window[cell];
+      count--;
+      present &= ~(1UL << cell);
+    }
     
-    // Determine pressure trends
-    trends.risingPressure = trends.pressureTrend > 1.0; // Rising > 1 hPa/hour
-    trends.fallingPressure = trends.pressureTrend < -1.0; // Falling > 1 hPa/hour
-    trends.rapidTempChange = abs(trends.temperatureTrend) > 2.0; // > 2°F/hour
+    HistoryRecord record;
+    if (!getRecordValues(TIER_HOURLY, ago, record)) continue;
+    window[cell] = (int16_t)lroundf(record.avgTemperature * 10);
+    sum += window[cell];
+    count++;
+    present |= 1UL << cell;
+    if (present & (1UL << ((ago + 23) % 24))) {
+      learnDiurnal(ago, window[cell], sum / count);
+    }
+  }
+}
+
+// Classifies the newest hour. Integer and table driven; the only float
+// work is reading the record and the cached trend.
+void DataLogger::updateForecast(bool appended) {
+  if (appended) {
+    memmove(pastForecast, pastForecast + 1, FORECAST_CHANGE_HOURS - 1);
+    pastForecast[FORECAST_CHANGE_HOURS - 1] = forecastCode;
   } else {
-    memset(&trends, 0, sizeof(trends));
+    memset(pastForecast, FORECAST_NONE, sizeof(pastForecast));
   }
   
-  return trends;
+  HistoryRecord newest;
+  if (!getRecordValues(TIER_HOURLY, 0, newest)) {
+    forecastCode = FORECAST_NONE;
+    forecastTendency = 0;
+    return;
+  }
+  
+  int16_t pressure = (int16_t)lroundf(newest.avgPressure * 10) + STATION_ALTITUDE_M * 6 / 5;  // ~0.12 hPa/m
+  int16_t change = (int16_t)lroundf(trends.pressureTrend * 30);  // 0.1 hPa over 3 hours
+  forecastTendency = change > FORECAST_TENDENCY_DHPA ? 1 : (change < -FORECAST_TENDENCY_DHPA ? -1 : 0);
+  
+  uint8_t month = hourNumberToDateTime(newestPeriod[TIER_HOURLY]).getMonth();
+  bool summer = (month >= 4 && month <= 9) != (SOUTHERN_HEMISPHERE != 0);
+  if (forecastTendency > 0 && summer) pressure += ZAMBRETTI_SEASON_DHPA;
+  if (forecastTendency < 0 && !summer) pressure -= ZAMBRETTI_SEASON_DHPA;
+  
+  int16_t band = (int32_t)(pressure - ZAMBRETTI_LOW_DHPA) * ZAMBRETTI_BANDS / ZAMBRETTI_RANGE_DHPA;
+  band = constrain(band, 0, ZAMBRETTI_BANDS - 1);
+  forecastCode = pgm_read_byte(&zambrettiTable[forecastTendency + 1][band]);
+}
+
+bool DataLogger::detectWeatherChange() {
+  uint8_t past = pastForecast[0];
+  if (past == FORECAST_NONE || forecastCode == FORECAST_NONE) {
+    return false;
+  }
+  return abs((int)forecastCode - (int)past) >= FORECAST_CHANGE_LETTERS;
+}
+
+// Newest hourly average moved along the learned daily curve
+float DataLogger::predictTemperature(uint8_t hoursAhead) {
+  HistoryRecord newest;
+  if (!getRecordValues(TIER_HOURLY, 0, newest)) {
+    return 0;
+  }
+  uint8_t hour = hourOfDay(0);
+  int16_t predicted = (int16_t)lroundf(newest.avgTemperature * 10) +
+                      diurnal[(hour + hoursAhead) % 24] - diurnal[hour];
+  return predicted / 10.0f;
+}
+
+ForecastData DataLogger::getForecast() {
+  ForecastData forecast;
+  forecast.code = forecastCode;
+  forecast.tendency = forecastTendency;
+  forecast.pressureTrend = trends.pressureTrend;
+  forecast.temperatureTrend = trends.temperatureTrend;
+  forecast.predictedTemperature = predictTemperature(FORECAST_HORIZON_HOURS);
+  return forecast;
 }
 
 bool DataLogger::checkPressureAlert() {
-  TrendData trends = calculateTrends();
-  return trends.fallingPressure && trends.pressureTrend < -2.0; // Rapid pressure drop
+  return pressureAlertRate > 0 &&
+         (fast.pressureAlert ||
+          (trends.fallingPressure && trends.pressureTrend < -pressureAlertRate)); // Rapid pressure drop
 }
 
 bool DataLogger::checkTemperatureAlert() {
-  TrendData trends = calculateTrends();
-  return trends.rapidTempChange && abs(trends.temperatureTrend) > 5.0; // Very rapid temp change
+  return temperatureAlertRate > 0 &&
+         (fast.temperatureAlert ||
+          (trends.rapidTempChange && abs(trends.temperatureTrend) > temperatureAlertRate)); // Very rapid temp change
 }
 
 bool DataLogger::checkRapidChange() {
-  TrendData trends = calculateTrends();
-  return trends.rapidTempChange || abs(trends.pressureTrend) > 3.0;
+  return trends.rapidTempChange ||
+         (trends.pressureFit >= TREND_MIN_FIT && abs(trends.pressureTrend) > 3.0);
+}
+
+void DataLogger::setAlertRates(uint8_t pressure, uint8_t temperature) {
+  pressureAlertRate = pressure / 10.0f;
+  temperatureAlertRate = temperature / 10.0f;
+}
+
+void DataLogger::resetFastAlerts() {
+  memset(&fast, 0, sizeof(fast));
+  for (uint8_t i = 0; i < FAST_ALERT_MINUTES; i++) {
+    fast.temperature[i] = FAST_ALERT_MISSING;
+    fast.pressure[i] = FAST_ALERT_MISSING;
+  }
 }
 
-void DataLogger::saveToEEPROM() {
-  // Save key data to EEPROM for persistence
-  // This is a simplified implementation
-  int addr = EEPROM_DATA_START;
-  EEPROM.put(addr, currentHourlyIndex);
-  addr += sizeof(currentHourlyIndex);
-  EEPROM.put(addr, currentDailyIndex);
+static int16_t toMinuteFixed(float sum, uint8_t count, float offset) {
+  if (count == 0) {
+    return FAST_ALERT_MISSING;
+  }
+  return constrain((int32_t)((sum / count - offset) * 100.0f), -32767, 32767);
 }
 
-void DataLogger::loadFromEEPROM() {
-  // Load key data from EEPROM
-  int addr = EEPROM_DATA_START;
-  EEPROM.get(addr, currentHourlyIndex);
-  addr += sizeof(currentHourlyIndex);
-  EEPROM.get(addr, currentDailyIndex);
+void DataLogger::updateFastAlerts(const SensorData& data, uint32_t minute) {
+  if (fast.started && minute != fast.minute) {
+    closeMinute();
+    // Minutes with no samples at all (or a clock jump back) leave gaps
+    uint32_t skipped = minute > fast.minute ? minute - fast.minute - 1 : FAST_ALERT_MINUTES;
+    for (uint32_t i = 1; i <= skipped && i <= FAST_ALERT_MINUTES; i++) {
+      uint8_t slot = (fast.minute + i) % FAST_ALERT_MINUTES;
+      fast.temperature[slot] = FAST_ALERT_MISSING;
+      fast.pressure[slot] = FAST_ALERT_MISSING;
+    }
+  }
+  fast.minute = minute;
+  fast.started = true;
   
-  // Validate loaded values
-  if (currentHourlyIndex >= MAX_HOURLY_RECORDS) currentHourlyIndex = 0;
-  if (currentDailyIndex >= MAX_DAILY_RECORDS) currentDailyIndex = 0;
+  if (data.validFlags & SENSOR_VALID_CLIMATE) {
+    fast.temperatureSum += data.temperatureF;
+    fast.temperatureCount++;
+  }
+  if (data.validFlags & SENSOR_VALID_PRESSURE) {
+    fast.pressureSum += data.pressure;
+    fast.pressureCount++;
+  }
+}
+
+// Least-squares slope over the ring in units per hour, or 0 with fewer
+// than FAST_ALERT_MIN_POINTS minutes. x is minutes before the newest slot.
+float DataLogger::fastSlope(const int16_t* ring) {
+  int32_t sumY = 0;
+  int32_t sumX = 0, sumXX = 0;
+  float sumXY = 0;
+  uint8_t n = 0;
+  for (uint8_t age = 0; age < FAST_ALERT_MINUTES; age++) {
+    int16_t y = ring[(fast.minute - age) % FAST_ALERT_MINUTES];
+    if (y == FAST_ALERT_MISSING) continue;
+    sumX -= age;
+    sumXX += age * age;
+    sumY += y;
+    sumXY -= (float)age * y;
+    n++;
+  }
+  if (n < FAST_ALERT_MIN_POINTS) {
+    return 0;
+  }
+  float sxx = sumXX - (float)sumX * sumX / n;
+  float sxy = sumXY - (float)sumX * sumY / n;
+  return sxx > 0 ? sxy / sxx * 60.0f / 100.0f : 0;
 }
 
-void DataLogger::seedCurrentData(const SensorData& data) {
-  // Fill all hourly records with the current sensor values so that trend
-  // calculations start from a zero-delta baseline, preventing false alerts.
-  HourlyRecord seed;
-  seed.timestamp = data.currentTime;
-  seed.avgTemperature = data.temperatureF;
-  seed.avgHumidity = data.humidity;
-  seed.avgPressure = data.pressure;
-  seed.minTemperature = data.temperatureF;
-  seed.maxTemperature = data.temperatureF;
-  seed.minPressure = data.pressure;
-  seed.maxPressure = data.pressure;
+// Runs once a minute: store the minute's average, refit both slopes and
+// step the hysteresis. A rate must hold for FAST_ALERT_DEBOUNCE minutes in
+// a row to raise, so a single disturbed minute never alerts.
+void DataLogger::closeMinute() {
+  uint8_t slot = fast.minute % FAST_ALERT_MINUTES;
+  fast.temperature[slot] = toMinuteFixed(fast.temperatureSum, fast.temperatureCount, 0);
+  fast.pressure[slot] = toMinuteFixed(fast.pressureSum, fast.pressureCount, 1000.0f);
+  fast.temperatureSum = 0;
+  fast.pressureSum = 0;
+  fast.temperatureCount = 0;
+  fast.pressureCount = 0;
+  
+  fast.pressureTrend = fastSlope(fast.pressure);
+  fast.temperatureTrend = fastSlope(fast.temperature);
+  
+  if (!fast.pressureAlert) {
+    fast.pressureDebounce = fast.pressureTrend < -pressureAlertRate ? fast.pressureDebounce + 1 : 0;
+    fast.pressureAlert = fast.pressureDebounce >= FAST_ALERT_DEBOUNCE;
+  } else if (fast.pressureTrend > -pressureAlertRate * FAST_PRESSURE_CLEAR) {
+    fast.pressureAlert = false;
+    fast.pressureDebounce = 0;
+  }
+  
+  float tempRate = abs(fast.temperatureTrend);
+  if (!fast.temperatureAlert) {
+    fast.temperatureDebounce = tempRate > temperatureAlertRate ? fast.temperatureDebounce + 1 : 0;
+    fast.temperatureAlert = fast.temperatureDebounce >= FAST_ALERT_DEBOUNCE;
+  } else if (tempRate < temperatureAlertRate * FAST_TEMP_CLEAR) {
+    fast.temperatureAlert = false;
+    fast.temperatureDebounce = 0;
+  }
+}
 
-  for (uint8_t i = 0; i < MAX_HOURLY_RECORDS; i++) {
-    hourlyData[i] = seed;
+// Writes a closed hour or day to the internal journal: over the slot that
+// already holds its period (the hour closed again after a reboot), else the
+// next one round the ring
+void DataLogger::saveToJournal(HistoryTier tier, const PackedRecord& packed) {
+  if (!eepromImageValid) {
+    startStore();  // No journal yet
+  }
+  uint8_t first = tier == TIER_HOURLY ? 0 : EEPROM_HOURLY_SLOTS;
+  uint8_t count = tier == TIER_HOURLY ? EEPROM_HOURLY_SLOTS : EEPROM_DAILY_SLOTS;
+  uint8_t &next = tier == TIER_HOURLY ? eepromHourlySlot : eepromDailySlot;
+  int8_t slot = journalIndex(tier, packed.offset(), historyBaseHour);
+  if (slot < 0) {
+    slot = first + next;
+    next = (next + 1) % count;
   }
-  currentHourlyIndex = 0;
-  currentSampleIndex = 0;
+  writeSlot(slot, packed);
+}
+
+// Begins an empty image at the current base in whichever store holds the
+// journal. Slots are emptied before the header commits the base, so records
+// left by a cleared or half-imported image can't pass its check. On the
+// AT24C32 only pages that hold anything are rewritten.
+void DataLogger::startStore() {
+  if (externalHistory) {
+    uint8_t page[EXT_EEPROM_PAGE_SIZE];
+    for (uint16_t addr = EXT_EEPROM_PAGE_SIZE; addr < EXT_EEPROM_SIZE; addr += EXT_EEPROM_PAGE_SIZE) {
+      bool blank = externalEeprom.read(addr, page, sizeof(page));
+      for (uint8_t at = 0; blank && at < sizeof(page); at += EEPROM_RECORD_SIZE) {
+        blank = (page[at] & page[at + 1]) == 0xFF;
+      }
+      if (!blank) {
+        memset(page, 0xFF, sizeof(page));
+        writeExternal(addr, page, sizeof(page));
+      }
+    }
+    eepromImageValid = writeExternalHeader();
+    return;
+  }
+  
+  PackedRecord missing;
+  missing.clear();
+  for (uint8_t slot = 0; slot < EEPROM_HOURLY_SLOTS + EEPROM_DAILY_SLOTS; slot++) {
+    writeSlot(slot, missing);
+  }
+  writeHeader();
+  eepromImageValid = true;
+  eepromHourlySlot = 0;
+  eepromDailySlot = 0;
+}
+
+// Re-stamps every journal record from oldBase onto historyBaseHour, dropping
+// any that no longer fit, then commits the new base. Slots that were torn
+// are emptied so the new base can't pass them. A power cut part way loses
+// the slots not yet re-stamped, which fail against whichever base the header
+// holds.
+void DataLogger::rebaseStore(uint32_t oldBase) {
+  if (!eepromImageValid) {
+    return;  // Nothing stored; the first save starts the image at the new base
+  }
+  
+  if (externalHistory) {
+    uint8_t page[EXT_EEPROM_PAGE_SIZE];
+    for (uint16_t addr = EXT_EEPROM_PAGE_SIZE; addr < EXT_EEPROM_SIZE; addr += EXT_EEPROM_PAGE_SIZE) {
+      if (!externalEeprom.read(addr, page, sizeof(page))) continue;
+      bool changed = false;
+      for (uint8_t at = 0; at < sizeof(page); at += EEPROM_RECORD_SIZE) {
+        JournalSlot *slot = (JournalSlot*)(page + at);
+        if ((slot->body[0] & slot->body[1]) == 0xFF) continue;  // Empty
+        PackedRecord packed;
+        packed.clear();
+        if (committedOffset(slot, oldBase) != PACKED_EMPTY_OFFSET) {
+          memcpy(packed.bytes, slot->body, EEPROM_COMMIT_BYTE);
+          rebaseRing(&packed, 1, oldBase, historyBaseHour);
+        }
+        memcpy(slot->body, packed.bytes, EEPROM_COMMIT_BYTE);
+        slot->commit = packed.isEmpty() ? EEPROM_UNCOMMITTED : checkByte(historyBaseHour, slot->body, EEPROM_COMMIT_BYTE);
+        changed = true;
+      }
+      if (changed) {
+        writeExternal(addr, page, sizeof(page));
+      }
+    }
+    eepromImageValid = writeExternalHeader();
+    return;
+  }
+  
+  for (uint8_t slot = 0; slot < EEPROM_HOURLY_SLOTS + EEPROM_DAILY_SLOTS; slot++) {
+    JournalSlot scratch;
+    const JournalSlot *stored = journalSlot(slot, scratch);
+    if ((stored->body[0] & stored->body[1]) == 0xFF) continue;  // Empty
+    PackedRecord packed;
+    packed.clear();
+    if (committedOffset(stored, oldBase) != PACKED_EMPTY_OFFSET) {
+      memcpy(packed.bytes, stored->body, EEPROM_COMMIT_BYTE);
+      rebaseRing(&packed, 1, oldBase, historyBaseHour);
+    }
+    writeSlot(slot, packed);
+  }
+  writeHeader();
+}
+
+void DataLogger::writeSlot(uint8_t slot, const PackedRecord& packed) {
+  int addr = slotAddress(slot);
+  
+  // Uncommit, write the body, commit. update() skips bytes that already match.
+  EEPROM.update(addr + EEPROM_COMMIT_BYTE, EEPROM_UNCOMMITTED);
+  if (packed.isEmpty()) {
+    EEPROM.update(addr, 0xFF);
+    EEPROM.update(addr + 1, 0xFF);
+    return;
+  }
+  for (uint8_t i = 0; i < EEPROM_COMMIT_BYTE; i++) {
+    EEPROM.update(addr + i, packed.bytes[i]);
+  }
+  EEPROM.update(addr + EEPROM_COMMIT_BYTE, checkByte(historyBaseHour, packed.bytes, EEPROM_COMMIT_BYTE));
+}
+
+void DataLogger::writeHeader() {
+  JournalHeader header;
+  fillHeader(header, EEPROM_LAYOUT_VERSION, historyBaseHour);
+  
+  // Uncommit, write the body, commit - as for slots
+  const uint8_t *bytes = &header.version;
+  EEPROM.update(EEPROM_DATA_START + EEPROM_HEADER_CHECK, EEPROM_UNCOMMITTED);
+  for (uint8_t i = 0; i <= EEPROM_HEADER_CHECK; i++) {
+    EEPROM.update(EEPROM_DATA_START + i, bytes[i]);
+  }
+}
+
+// Finds the newest committed record in a journal ring, read in place: sets
+// the tier's newestPeriod, and nextSlot to the journal slot after it
+void DataLogger::findNewestSlot(uint8_t firstSlot, uint8_t slotCount, HistoryTier tier, uint8_t& nextSlot) {
+  bool any = false;
+  nextSlot = 0;
+  for (uint8_t slot = 0; slot < slotCount; slot++) {
+    JournalSlot scratch;
+    uint16_t offset = committedOffset(journalSlot(firstSlot + slot, scratch), historyBaseHour);
+    if (offset == PACKED_EMPTY_OFFSET) {
+      continue;  // Empty or torn
+    }
+    uint32_t period = periodOf(tier, historyBaseHour + offset, 0);
+    if (!any || period >= newestPeriod[tier]) {
+      newestPeriod[tier] = period;
+      nextSlot = (slot + 1) % slotCount;
+    }
+    any = true;
+  }
+}
+
+// Layout 2 is the same slots with 24 hourly ones, running on into what is
+// now the settings record. The newest 20 hours go back oldest first from
+// slot 0 and the days move down behind them, before a settings save can
+// land on the old daily slots. The hours are held on the stack meanwhile
+// (192 bytes, once).
+void DataLogger::migrateLayout2() {
+  JournalSlot hours[LAYOUT_2_HOURLY_SLOTS];
+  uint32_t newest = 0;
+  for (uint8_t slot = 0; slot < LAYOUT_2_HOURLY_SLOTS; slot++) {
+    JournalSlot scratch;
+    hours[slot] = *journalSlot(slot, scratch);
+    uint16_t offset = committedOffset(&hours[slot], historyBaseHour);
+    if (offset != PACKED_EMPTY_OFFSET && offset > newest) {
+      newest = offset;
+    }
+  }
+  
+  PackedRecord packed;
+  for (uint8_t day = 0; day < EEPROM_DAILY_SLOTS; day++) {
+    JournalSlot scratch;
+    const JournalSlot *stored = journalSlot(LAYOUT_2_HOURLY_SLOTS + day, scratch);
+    packed.clear();
+    if (committedOffset(stored, historyBaseHour) != PACKED_EMPTY_OFFSET) {
+      memcpy(packed.bytes, stored->body, EEPROM_COMMIT_BYTE);
+    }
+    writeSlot(EEPROM_HOURLY_SLOTS + day, packed);
+  }
+  for (uint8_t slot = 0; slot < EEPROM_HOURLY_SLOTS; slot++) {
+    uint32_t offset = newest + 1 + slot - EEPROM_HOURLY_SLOTS;
+    packed.clear();
+    for (uint8_t i = 0; i < LAYOUT_2_HOURLY_SLOTS; i++) {
+      if (committedOffset(&hours[i], historyBaseHour) == offset) {
+        memcpy(packed.bytes, hours[i].body, EEPROM_COMMIT_BYTE);
+      }
+    }
+    writeSlot(slot, packed);
+  }
+  writeHeader();
+}
+
+bool DataLogger::loadFromEEPROM() {
+  unsigned long start = micros();
+  
+  eepromImageValid = false;
+  bool loaded = (externalHistory && loadFromExternal()) || loadFromInternal();
+  
+  // The newest hour and day are answered from RAM from here on
+  for (uint8_t tier = TIER_HOURLY; tier <= TIER_DAILY; tier++) {
+    PackedRecord packed;
+    int8_t slot = hourlyOrDaily((HistoryTier)tier);
+    if (!findRecord((HistoryTier)tier, newestPeriod[tier], packed)) {
+      packed.clear();
+    }
+    newestRecord[slot] = packed;
+  }
+  
+  restoreMicros = micros() - start;
+  return loaded;
+}
+
+bool DataLogger::loadFromInternal() {
+  JournalHeader scratch;
+  const JournalHeader *header = journalHeader(scratch);
+  uint8_t hourlySlots = EEPROM_HOURLY_SLOTS;
+  if (!readHeader(header, EEPROM_LAYOUT_VERSION, historyBaseHour)) {
+    if (!readHeader(header, LAYOUT_2_VERSION, historyBaseHour)) {
+      return false;  // Blank, torn, or written by an older layout
+    }
+    hourlySlots = LAYOUT_2_HOURLY_SLOTS;
+  }
+  
+  if (externalHistory) {
+    // No external image yet: the journal moves across to the chip once
+    copyJournalToExternal(hourlySlots);
+    findNewestExternal(TIER_HOURLY);
+    findNewestExternal(TIER_DAILY);
+    return true;
+  }
+  if (hourlySlots != EEPROM_HOURLY_SLOTS) {
+    migrateLayout2();
+  }
+  eepromImageValid = true;
+  findNewestSlot(0, EEPROM_HOURLY_SLOTS, TIER_HOURLY, eepromHourlySlot);
+  findNewestSlot(EEPROM_HOURLY_SLOTS, EEPROM_DAILY_SLOTS, TIER_DAILY, eepromDailySlot);
+  return true;
+}
+
+// ============================================================================
+// EXTERNAL HISTORY STORE
+// ============================================================================
+
+static uint16_t externalSlots(HistoryTier tier) {
+  return tier == TIER_HOURLY ? EXT_HISTORY_HOURLY_SLOTS : EXT_HISTORY_DAILY_SLOTS;
+}
+
+static uint16_t externalSlotAddress(HistoryTier tier, uint32_t period) {
+  uint16_t slot = period % externalSlots(tier);
+  if (tier == TIER_DAILY) {
+    slot += EXT_HISTORY_HOURLY_SLOTS;
+  }
+  return EXT_EEPROM_PAGE_SIZE + slot * EEPROM_RECORD_SIZE;
+}
+
+// The period a committed slot holds, if it is the one its position maps to
+static bool externalSlotPeriod(const JournalSlot* slot, HistoryTier tier, uint32_t base,
+                               uint16_t position, uint32_t& period) {
+  uint16_t offset = committedOffset(slot, base);
+  if (offset == PACKED_EMPTY_OFFSET) {
+    return false;  // Empty or torn
+  }
+  period = periodOf(tier, base + offset, 0);
+  return period % externalSlots(tier) == position;
+}
+
+// Every write to the chip goes through here, so the read cache never goes stale
+bool DataLogger::writeExternal(uint16_t addr, const uint8_t* data, uint16_t length) {
+  cachedPage = EXT_EEPROM_SIZE;
+  return externalEeprom.write(addr, data, length);
+}
+
+bool DataLogger::writeExternalHeader() {
+  JournalHeader header;
+  fillHeader(header, EXT_HISTORY_LAYOUT_VERSION, historyBaseHour);
+  return writeExternal(0, &header.version, sizeof(header));
+}
+
+// Writes the slots for periods first..last: the newest period's record, the
+// others empty. Adjacent slots share a page write, so a single hour is one
+// transaction.
+void DataLogger::writeExternalRange(HistoryTier tier, uint32_t first, uint32_t last) {
+  if (last - first >= externalSlots(tier)) {
+    first = last - externalSlots(tier) + 1;
+  }
+  const PackedRecord &newest = newestRecord[hourlyOrDaily(tier)];
+  
+  uint8_t page[EXT_EEPROM_PAGE_SIZE];
+  uint16_t pageAddr = 0;
+  uint8_t used = 0;
+  for (uint32_t period = first; ; period++) {
+    uint16_t addr = externalSlotAddress(tier, period);
+    if (used > 0 && (addr != pageAddr + used || addr % EXT_EEPROM_PAGE_SIZE == 0)) {
+      writeExternal(pageAddr, page, used);
+      used = 0;
+    }
+    if (used == 0) {
+      pageAddr = addr;
+    }
+    
+    uint8_t *slot = page + used;
+    if (period != newestPeriod[tier] || newest.isEmpty()) {
+      memset(slot, 0xFF, EEPROM_RECORD_SIZE);
+    } else {
+      memcpy(slot, newest.bytes, EEPROM_COMMIT_BYTE);
+      slot[EEPROM_COMMIT_BYTE] = checkByte(historyBaseHour, slot, EEPROM_COMMIT_BYTE);
+    }
+    used += EEPROM_RECORD_SIZE;
+    if (period == last) break;
+  }
+  writeExternal(pageAddr, page, used);
+}
+
+// Writes a closed period's slot, and after an RTC rewind empties the slots
+// of the abandoned periods up to last. The chip already ACK-polls through
+// its write cycle, so a write that still fails costs only that slot.
+void DataLogger::saveExternalRecords(HistoryTier tier, uint32_t period, uint32_t last) {
+  if (!eepromImageValid) {
+    startStore();
+  }
+  if (last > period) {
+    writeExternalRange(tier, period + 1, last);  // May wrap onto period's slot
+  }
+  writeExternalRange(tier, period, period);
+}
+
+// Starts the chip's image at the internal journal's base and copies each
+// committed slot to the chip slot for its period
+void DataLogger::copyJournalToExternal(uint8_t hourlySlots) {
+  startStore();
+  for (uint8_t slot = 0; slot < hourlySlots + EEPROM_DAILY_SLOTS; slot++) {
+    JournalSlot scratch;
+    const JournalSlot *stored = journalSlot(slot, scratch);
+    uint16_t offset = committedOffset(stored, historyBaseHour);
+    if (offset == PACKED_EMPTY_OFFSET) continue;
+    HistoryTier tier = slot < hourlySlots ? TIER_HOURLY : TIER_DAILY;
+    uint32_t period = periodOf(tier, historyBaseHour + offset, 0);
+    writeExternal(externalSlotAddress(tier, period), stored->body, EEPROM_RECORD_SIZE);  // With its commit byte
+  }
+}
+
+bool DataLogger::loadFromExternal() {
+  JournalHeader header;
+  if (!externalEeprom.read(0, &header.version, sizeof(header)) ||
+      !readHeader(&header, EXT_HISTORY_LAYOUT_VERSION, historyBaseHour)) {
+    return false;  // Blank, torn, or another layout
+  }
+  eepromImageValid = true;
+  
+  findNewestExternal(TIER_HOURLY);
+  findNewestExternal(TIER_DAILY);
+  return true;
+}
+
+// Reads every slot of a tier a page at a time to find its newest period
+void DataLogger::findNewestExternal(HistoryTier tier) {
+  const uint8_t slotsPerPage = EXT_EEPROM_PAGE_SIZE / EEPROM_RECORD_SIZE;
+  uint16_t slots = externalSlots(tier);
+  uint8_t page[EXT_EEPROM_PAGE_SIZE];
+  bool any = false;
+  
+  for (uint16_t position = 0; position < slots; position++) {
+    if (position % slotsPerPage == 0 &&
+        !externalEeprom.read(externalSlotAddress(tier, position), page, sizeof(page))) {
+      break;  // Keep what was read
+    }
+    const JournalSlot *slot = (const JournalSlot*)(page + (position % slotsPerPage) * EEPROM_RECORD_SIZE);
+    uint32_t period;
+    if (!externalSlotPeriod(slot, tier, historyBaseHour, position, period)) {
+      continue;
+    }
+    if (!any || period > newestPeriod[tier]) {
+      newestPeriod[tier] = period;
+    }
+    any = true;
+  }
+}
+
+// A period's slot on the chip, through the one-page cache
+bool DataLogger::readExternalRecord(HistoryTier tier, uint32_t period, PackedRecord& packed) {
+  uint16_t addr = externalSlotAddress(tier, period);
+  uint16_t page = addr - addr % EXT_EEPROM_PAGE_SIZE;
+  if (page != cachedPage) {
+    cachedPage = EXT_EEPROM_SIZE;
+    if (!externalEeprom.read(page, pageCache, sizeof(pageCache))) {
+      return false;
+    }
+    cachedPage = page;
+  }
+  
+  const JournalSlot *slot = (const JournalSlot*)(pageCache + addr - page);
+  uint32_t held;
+  if (!externalSlotPeriod(slot, tier, historyBaseHour, period % externalSlots(tier), held) || held != period) {
+    return false;
+  }
+  packed.clear();  // Light isn't journaled
+  memcpy(packed.bytes, slot->body, EEPROM_COMMIT_BYTE);
+  return true;
+}
+
+// ============================================================================
+// HISTORY STORE IMAGE
+// ============================================================================
+
+#define INTERNAL_STORE_SIZE (EEPROM_HEADER_SIZE + (EEPROM_HOURLY_SLOTS + EEPROM_DAILY_SLOTS) * EEPROM_RECORD_SIZE)
+
+bool DataLogger::syncStore() {
+  if (!eepromImageValid) {
+    startStore();
+  }
+  return eepromImageValid;
+}
+
+uint8_t DataLogger::getStoreLayout() {
+  return externalHistory ? EXT_HISTORY_LAYOUT_VERSION : EEPROM_LAYOUT_VERSION;
+}
+
+uint16_t DataLogger::getStoreSize() {
+  return externalHistory ? EXT_EEPROM_SIZE : INTERNAL_STORE_SIZE;
+}
+
+bool DataLogger::readStore(uint16_t addr, uint8_t* data, uint8_t length) {
+  if ((uint32_t)addr + length > getStoreSize()) {
+    return false;
+  }
+  if (externalHistory) {
+    return externalEeprom.read(addr, data, length);
+  }
+  
+#ifdef MAPPED_EEPROM_START
+  memcpy(data, (const uint8_t*)(uintptr_t)(MAPPED_EEPROM_START + EEPROM_DATA_START + addr), length);
+#else
+  for (uint8_t i = 0; i < length; i++) {
+    data[i] = EEPROM.read(EEPROM_DATA_START + addr + i);
+  }
+#endif
+  return true;
+}
+
+bool DataLogger::writeStore(uint16_t addr, const uint8_t* data, uint8_t length) {
+  if ((uint32_t)addr + length > getStoreSize()) {
+    return false;
+  }
+  if (externalHistory) {
+    return writeExternal(addr, data, length);
+  }
+  
+  for (uint8_t i = 0; i < length; i++) {
+    EEPROM.update(EEPROM_DATA_START + addr + i, data[i]);
+  }
+  return true;
+}
+
+void DataLogger::invalidateStore() {
+  uint8_t uncommitted = EEPROM_UNCOMMITTED;
+  writeStore(EEPROM_HEADER_CHECK, &uncommitted, 1);
+  eepromImageValid = false;  // History reads empty; the next save starts a new image
+}
+
+bool DataLogger::reloadFromStore() {
+  periodsStarted = false;
+  memset(fiveMinuteData, 0xFF, sizeof(fiveMinuteData));  // All offsets empty
+  memset(weeklyData, 0xFF, sizeof(weeklyData));
+  memset(newestRecord, 0xFF, sizeof(newestRecord));
+  memset(newestPeriod, 0, sizeof(newestPeriod));
+  cachedPage = EXT_EEPROM_SIZE;
+  fiveMinuteBase = 0;
+  historyBaseHour = 0;
+  eepromHourlySlot = 0;
+  eepromDailySlot = 0;
+  for (uint8_t tier = 0; tier < HISTORY_TIER_COUNT; tier++) {
+    resetPending((HistoryTier)tier);
+  }
+  
+  resetFastAlerts();
+  forecastCode = FORECAST_NONE;
+  clearClosedQuantiles();
+  
+  externalDailyPending = false;
+  bool loaded = loadFromEEPROM();
+  hourlyHistoryChanged();
+  return loaded;
 }
 
 void DataLogger::clearAllData() {
-  memset(hourlyData, 0, sizeof(hourlyData));
-  memset(dailyData, 0, sizeof(dailyData));
-  currentHourlyIndex = 0;
-  currentDailyIndex = 0;
-  currentSampleIndex = 0;
+  memset(fiveMinuteData, 0xFF, sizeof(fiveMinuteData));
+  memset(weeklyData, 0xFF, sizeof(weeklyData));
+  memset(newestRecord, 0xFF, sizeof(newestRecord));
+  memset(newestPeriod, 0, sizeof(newestPeriod));
+  for (uint8_t tier = 0; tier < HISTORY_TIER_COUNT; tier++) {
+    resetPending((HistoryTier)tier);
+  }
+  
+  // Invalidate the stored journal; the next save starts an empty one
+  EEPROM.update(EEPROM_DATA_START + EEPROM_HEADER_CHECK, EEPROM_UNCOMMITTED);
+  if (externalHistory) {
+    uint8_t uncommitted = EEPROM_UNCOMMITTED;
+    writeExternal(EEPROM_HEADER_CHECK, &uncommitted, 1);
+  }
+  eepromImageValid = false;
+  
+  hourlyHistoryChanged();
+  resetFastAlerts();
+  clearClosedQuantiles();
   
   // Serial.println(F("All data cleared"));
 }
 
 bool DataLogger::isDataValid() {
-  return currentHourlyIndex > 0 || currentDailyIndex > 0;
+  return hasRecord(TIER_HOURLY, 0) || hasRecord(TIER_DAILY, 0);
 }
 
 uint8_t DataLogger::getDataAge() {
-  // Return hours since oldest valid data
-  HourlyRecord oldest = getHourlyRecord(MAX_HOURLY_RECORDS - 1);
-  if (oldest.timestamp.getYear() > 0) {
-    return MAX_HOURLY_RECORDS;
+  // Hours back to the oldest hourly record still in the tier
+  for (int16_t ago = MAX_HOURLY_RECORDS - 1; ago >= 0; ago--) {
+    if (hasRecord(TIER_HOURLY, ago)) {
+      return ago + 1;
+    }
   }
-  
-  return currentHourlyIndex;
+  return 0;
 }
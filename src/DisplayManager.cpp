@@ -26,14 +26,79 @@ static uint8_t calcDayOfWeek(int year, int month, int day) {
   return (year + year/4 - year/100 + year/400 + t[month-1] + day) % 7;
 }
 
+// Channel each rolling-current page depends on; stale pages are skipped
+static const uint8_t rollingPageChannels[] = {
+  SENSOR_VALID_TIME,      // 0: time / date / day
+  SENSOR_VALID_CLIMATE,   // 1: feels-like
+  SENSOR_VALID_CLIMATE,   // 2: temperature / humidity
+  SENSOR_VALID_PRESSURE,  // 3: pressure
+  SENSOR_VALID_LIGHT      // 4: light level
+};
+#define ROLLING_CURRENT_PAGES (sizeof(rollingPageChannels) / sizeof(rollingPageChannels[0]))
+
+#define ROLLING_TREND_PAGES 4
+
+// History pages: median and 10-90% spread of the last closed hour or day
+struct HistoryPage {
+  char label[5];
+  uint8_t tier;
+  uint8_t channel;
+};
+
+static const HistoryPage historyPages[] PROGMEM = {
+  {"TmpH", TIER_HOURLY, CHANNEL_TEMPERATURE},
+  {"TmpD", TIER_DAILY,  CHANNEL_TEMPERATURE},
+  {"PrsH", TIER_HOURLY, CHANNEL_PRESSURE},
+  {"PrsD", TIER_DAILY,  CHANNEL_PRESSURE}
+};
+#define ROLLING_HISTORY_PAGES (sizeof(historyPages) / sizeof(historyPages[0]))
+
+// Zambretti forecasts A..Z, abbreviated to fit the 12-character display
+static const char forecastText[26][13] PROGMEM = {
+  "SETTLED FINE",  // A
+  "FINE",          // B
+  "BECMG FINE",    // C
+  "FINE-UNSETL",   // D  fine, becoming less settled
+  "FINE SHOWERS",  // E  fine, possible showers
+  "FAIR IMPROVE",  // F
+  "FAIR SHWR AM",  // G  fairly fine, possible showers early
+  "FAIR SHWR PM",  // H  fairly fine, showery later
+  "SHWRS-FINE",    // I  showery early, improving
+  "CHNGBL MEND",   // J
+  "FAIR SHOWERS",  // K  fairly fine, showers likely
+  "UNSETL CLEAR",  // L  rather unsettled, clearing later
+  "UNSETL BETTR",  // M  unsettled, probably improving
+  "SHWRS BRIGHT",  // N  showery, bright intervals
+  "SHWRS WORSE",   // O  showery, becoming less settled
+  "CHNGBL RAIN",   // P  changeable, some rain
+  "UNSETL BRKS",   // Q  unsettled, short fine intervals
+  "UNSETL-RAIN",   // R  unsettled, rain later
+  "UNSETL RAIN",   // S  unsettled, some rain
+  "V UNSETTLED",   // T  mostly very unsettled
+  "RAIN WORSE",    // U  occasional rain, worsening
+  "RAIN V UNSET",  // V  rain at times, very unsettled
+  "FREQ RAIN",     // W  rain at frequent intervals
+  "RAIN UNSETTL",  // X  rain, very unsettled
+  "STORM BETTER",  // Y  stormy, may improve
+  "STORM RAIN"     // Z  stormy, much rain
+};
+
+// Signed rate with one decimal, right-justified in four display positions
+// (the decimal point shares a position with the digit before it)
+static void formatRate(float rate, char* buffer) {
+  int r = (int)(fabs(rate) * 10.0f + 0.5f);
+  if (r > 999) r = 999;
+  char digits[6];
+  sprintf(digits, "%c%d.%1d", rate < 0 && r > 0 ? '-' : '+', r / 10, r % 10);
+  sprintf(buffer, "%5s", digits);
+}
+
 bool DisplayManager::init() {
   // Initialize single display group managing all 3 displays
   // Different brightness levels needed due to LED color variations
-  byte brightnessLevels[3] = {
-    DISPLAY_GREEN_BRIGHTNESS, 
-    DISPLAY_AMBER_BRIGHTNESS, 
-    DISPLAY_RED_BRIGHTNESS
-  }; // Green, Amber, Red
+  brightnessLevels[0] = DISPLAY_GREEN_BRIGHTNESS;
+  brightnessLevels[1] = DISPLAY_AMBER_BRIGHTNESS;
+  brightnessLevels[2] = DISPLAY_RED_BRIGHTNESS;
   
   // Create single display object managing 3 displays starting at 0x70
   displayGroup = new HT16K33Disp(DISPLAY_GREEN_ADDRESS, 3);
@@ -44,17 +109,27 @@ bool DisplayManager::init() {
   lastUpdateTime = 0;
   rollingIndex = 0;
   rollingTimer = 0;
+  currentBrightness = 0;
+  brightnessOverride = 0;
+  lastSetupRefresh = millis();
+  lastErrorTotal = 0;
+  setupRetries = 0;
   
   // Initialize alert display state
   displayingAlert = false;
   currentAlertType = ALERT_NONE;
   alertDisplayStart = 0;
   
+  forecast.code = FORECAST_NONE;
+  dataLogger = NULL;
+  
   // Serial.println(F("Display manager initialized"));
   return true;
 }
 
 void DisplayManager::update(SensorData sensorData) {
+  refreshDisplaySetup();
+  
   // Check if alert display has timed out (show alert for 3 seconds)
   if (displayingAlert && (millis() - alertDisplayStart > 3000)) {
     clearAlert();
@@ -105,20 +180,45 @@ void DisplayManager::update(SensorData sensorData) {
   lastUpdateTime = millis();
 }
 
-void DisplayManager::updateSettings(SensorData sensorData, bool settingsMode, SettingItem currentSetting, 
-                                     int settingTimeComponent, int settingDateComponent, DateTime pendingDateTime,
-                                     bool editingSettingValue) {
-  if (settingsMode) {
-    if (editingSettingValue) {
-      displaySettingsInterface(currentSetting, settingTimeComponent, settingDateComponent, pendingDateTime);
-    } else {
-      displaySettingsMenu(currentSetting);
+void DisplayManager::showMenu(const char* text) {
+  displayString(text);
+  lastUpdateTime = millis();
+}
+
+void DisplayManager::refreshDisplaySetup() {
+  // A display that browned out comes back with its oscillator off and stays
+  // blank even though writes are acknowledged - re-assert its setup
+  // periodically, and immediately after a NACK. A display that stays
+  // missing keeps NACKing, so further re-asserts back off like the sensors:
+  // 1x, 2x, 4x ... the base delay, capped at the periodic interval
+  unsigned int errorTotal = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    errorTotal += displayGroup->error_count(i);
+  }
+  
+  bool nacked = errorTotal != lastErrorTotal;
+  lastErrorTotal = errorTotal;
+  if (!nacked) setupRetries = 0;
+  
+  unsigned long interval = DISPLAY_SETUP_REFRESH_INTERVAL;
+  if (nacked) {
+    interval = 0;
+    if (setupRetries > 0) {
+      uint8_t shift = setupRetries - 1;
+      interval = (shift < 8) ? (DISPLAY_SETUP_RETRY_BASE_MS << shift) : DISPLAY_SETUP_REFRESH_INTERVAL;
+      if (interval > DISPLAY_SETUP_REFRESH_INTERVAL) interval = DISPLAY_SETUP_REFRESH_INTERVAL;
     }
-  } else {
-    // Normal display update
-    update(sensorData);
   }
-  lastUpdateTime = millis();
+  
+  if (millis() - lastSetupRefresh >= interval) {
+    displayGroup->refresh_setup(brightnessLevels);
+    lastSetupRefresh = millis();
+    if (nacked && setupRetries < 255) setupRetries++;
+  }
+}
+
+unsigned int DisplayManager::getDisplayErrorCount(uint8_t display) {
+  return displayGroup->error_count(display);
 }
 
 bool DisplayManager::isTimeToUpdate() {
@@ -214,6 +314,12 @@ void DisplayManager::formatDate(DateTime time, char* buffer) {
 
 void DisplayManager::displayTemperature(SensorData data) {
   char displayText[13];
+  
+  if (!(data.validFlags & SENSOR_VALID_CLIMATE)) {
+    displayString("---- ----   ");
+    return;
+  }
+
   char tempStr[5];   // For temperature string like "75.0" 
   char feelsStr[5];  // For feels like string like "78.0"
   
@@ -254,17 +360,26 @@ void DisplayManager::displayWeatherSummary(SensorData data) {
   // Characters 8-11 (RED): Pressure (e.g. "1013")
   
   // Format temperature 
-  if(data.temperatureF < 100.0){
-    float_to_fixed(data.temperatureF, tempStr, "%2d.%1d");
+  if (!(data.validFlags & SENSOR_VALID_CLIMATE)) {
+    strcpy(tempStr, "----");
+    strcpy(humidStr, "----");
   } else {
-    float_to_fixed(data.temperatureF, tempStr, "%3d");
+    if(data.temperatureF < 100.0){
+      float_to_fixed(data.temperatureF, tempStr, "%2d.%1d");
+    } else {
+      float_to_fixed(data.temperatureF, tempStr, "%3d");
+    }
+    
+    // Format humidity (usually no decimals needed for humidity)
+    sprintf(humidStr, "%3d%%", (int)data.humidity);
   }
   
-  // Format humidity (usually no decimals needed for humidity)
-  sprintf(humidStr, "%3d%%", (int)data.humidity);
-  
   // Format pressure as integer (avoid float formatting issues)
-  sprintf(pressStr, "%4d", (int)data.pressure);
+  if (!(data.validFlags & SENSOR_VALID_PRESSURE)) {
+    strcpy(pressStr, "----");
+  } else {
+    sprintf(pressStr, "%4d", (int)data.pressure);
+  }
   
   sprintf(displayText, "%4s%4s%4s", tempStr, humidStr, pressStr);
   
@@ -274,10 +389,18 @@ void DisplayManager::displayWeatherSummary(SensorData data) {
 void DisplayManager::displayRollingCurrent(SensorData data) {
   unsigned long currentTime = millis();
   
-  // Change display every 3 seconds
-  if (currentTime - rollingTimer > 3000) {
+  // Change display every 3 seconds, or straight away if this page went stale
+  bool pageStale = !(data.validFlags & rollingPageChannels[rollingIndex]);
+  if (currentTime - rollingTimer > 3000 || pageStale) {
     rollingTimer = currentTime;
-    rollingIndex = (rollingIndex + 1) % 5;
+    
+    // Advance to the next page whose channel is fresh
+    for (uint8_t i = 0; i < ROLLING_CURRENT_PAGES; i++) {
+      rollingIndex = (rollingIndex + 1) % ROLLING_CURRENT_PAGES;
+      if (data.validFlags & rollingPageChannels[rollingIndex]) {
+        break;
+      }
+    }
   }
   
   char displayText[20];
@@ -363,116 +486,119 @@ void DisplayManager::displayRollingCurrent(SensorData data) {
 }
 
 void DisplayManager::displayRollingHistorical() {
-  // Placeholder - would display historical data using unified 12-character display
-  displayString("History");
-}
-
-void DisplayManager::displayRollingTrends() {
-  // Placeholder - would display trend data using unified 12-character display  
-  displayString("Trends");
-}
-
-void DisplayManager::displaySettings() {
-  displayString("Settings");
-}
-
-void DisplayManager::displaySettingsMenu(SettingItem currentSetting) {
-  char displayText[13];
+  // Change page every 3 seconds, skipping periods that have no percentiles yet
+  unsigned long currentTime = millis();
+  bool advance = currentTime - rollingTimer > 3000;
+  if (advance) {
+    rollingTimer = currentTime;
+  }
   
-  switch (currentSetting) {
-    case SETTING_TIME:
-      sprintf(displayText, "Set TIME    ");
-      break;
-    case SETTING_DATE:
-      sprintf(displayText, "Set DATE    ");
-      break;
-    case SETTING_CHIME_TYPE:
-      sprintf(displayText, "Chime TYPE  ");
-      break;
-    case SETTING_CHIME_INSTRUMENT:
-      sprintf(displayText, "Chime INSTR ");
-      break;
-    case SETTING_CHIME_FREQUENCY:
-      sprintf(displayText, "Chime FREQ  ");
-      break;
-    case SETTING_EXIT:
-      sprintf(displayText, "EXIT        ");
-      break;
-    default:
-      sprintf(displayText, "Setting %03d ", (int)currentSetting);
-      break;
+  HistoryPage page;
+  float median = 0, p10 = 0, p90 = 0;
+  bool found = false;
+  for (uint8_t i = 0; i < ROLLING_HISTORY_PAGES && !found; i++) {
+    if (advance || i > 0) {
+      rollingIndex++;
+    }
+    rollingIndex %= ROLLING_HISTORY_PAGES;
+    memcpy_P(&page, &historyPages[rollingIndex], sizeof(page));
+    HistoryTier tier = (HistoryTier)page.tier;
+    HistoryChannel channel = (HistoryChannel)page.channel;
+    found = dataLogger != NULL &&
+            dataLogger->getQuantile(tier, channel, QUANTILE_MEDIAN, median) &&
+            dataLogger->getQuantile(tier, channel, QUANTILE_P10, p10) &&
+            dataLogger->getQuantile(tier, channel, QUANTILE_P90, p90);
+  }
+  if (!found) {
+    displayString("Hist    ----");  // No closed hour yet
+    return;
   }
   
+  // Label (green), median (amber), "r" + 10-90% spread (red)
+  char displayText[20];
+  int si = (int)((p90 - p10) * 10.0f + 0.5f);
+  if (si > 999) si = 999;
+  char spread[7];
+  sprintf(spread, "r%2d.%1d", si / 10, si % 10);
+  
+  if (page.channel == CHANNEL_PRESSURE) {
+    sprintf(displayText, "%s%4d%s", page.label, (int)(median + 0.5f), spread);
+  } else {
+    // Sign kept apart from the digits, as in formatRate(), so -0.4 and
+    // -5.3 don't come out as " 0.-4" and "-5.-3"
+    int mi = (int)(fabs(median) * 10.0f + 0.5f);
+    const char* sign = median < 0 && mi > 0 ? "-" : "";
+    char digits[8];
+    if (mi < 1000) {
+      sprintf(digits, "%s%d.%1d", sign, mi / 10, mi % 10);
+      sprintf(displayText, "%s%5s%s", page.label, digits, spread);
+    } else {
+      sprintf(digits, "%s%d", sign, mi / 10);
+      sprintf(displayText, "%s%4s%s", page.label, digits, spread);
+    }
+  }
   displayString(displayText);
 }
 
-void DisplayManager::displaySettingsInterface(SettingItem currentSetting, int settingTimeComponent, 
-                                               int settingDateComponent, DateTime pendingDateTime) {
-  char displayText[13];
+void DisplayManager::displayRollingTrends() {
+  if (forecast.code == FORECAST_NONE) {
+    displayString("Fcst    ----");  // No closed hour yet
+    return;
+  }
+  
+  // Change page every 3 seconds
+  unsigned long currentTime = millis();
+  if (currentTime - rollingTimer > 3000) {
+    rollingTimer = currentTime;
+    rollingIndex = (rollingIndex + 1) % ROLLING_TREND_PAGES;
+  }
+  rollingIndex %= ROLLING_TREND_PAGES;
   
-  switch (currentSetting) {
-    case SETTING_TIME:
+  char displayText[20];
+  char rate[6];
+  
+  switch (rollingIndex) {
+    case 0: // Forecast text across all three displays
       {
-        char timeStr[9];  // "HH:MM:SS"
-        sprintf(timeStr, "%02d:%02d:%02d", pendingDateTime.getHour(), 
-                pendingDateTime.getMinute(), pendingDateTime.getSecond());
-        
-        // Show which component is being edited
-        switch (settingTimeComponent) {
-          case 0: // Hour
-            sprintf(displayText, "H%s", timeStr);
-            break;
-          case 1: // Minute  
-            sprintf(displayText, "M%s", timeStr);
-            break;
-          case 2: // Second
-            sprintf(displayText, "S%s", timeStr);
-            break;
-        }
+        char text[13];
+        strcpy_P(text, forecastText[forecast.code]);
+        sprintf(displayText, "%-12s", text);
       }
       break;
       
-    case SETTING_DATE:
+    case 1: // "Pres" (green), hPa per hour (amber), tendency (red)
       {
-        char dateStr[9];  // "MM/DD/YY"
-        sprintf(dateStr, "%02d/%02d/%02d", pendingDateTime.getMonth(), 
-                pendingDateTime.getDay(), pendingDateTime.getYear() % 100);
-        
-        // Show which component is being edited
-        switch (settingDateComponent) {
-          case 0: // Month
-            sprintf(displayText, "MO%s", dateStr);
-            break;
-          case 1: // Day
-            sprintf(displayText, "DY%s", dateStr);
-            break;
-          case 2: // Year
-            sprintf(displayText, "YR%s", dateStr);
-            break;
-        }
+        static const char* tendencyWords[] = {"FALL", "STDY", "RISE"};
+        formatRate(forecast.pressureTrend, rate);
+        sprintf(displayText, "Pres%s%s", rate, tendencyWords[forecast.tendency + 1]);
       }
       break;
       
-    case SETTING_CHIME_TYPE:
-      sprintf(displayText, "CHIME TYPE  ");
-      break;
-      
-    case SETTING_CHIME_INSTRUMENT:
-      sprintf(displayText, "CHIME INST  ");
-      break;
-      
-    case SETTING_CHIME_FREQUENCY:
-      sprintf(displayText, "CHIME FREQ  ");
+    case 2: // "Temp" (green), °F per hour (amber), units (red)
+      formatRate(forecast.temperatureTrend, rate);
+      sprintf(displayText, "Temp%sF/HR", rate);
       break;
       
-    default:
-      sprintf(displayText, "SETTING %03d ", (int)currentSetting);
+    case 3: // Predicted temperature FORECAST_HORIZON_HOURS ahead
+      {
+        int ti = (int)(forecast.predictedTemperature * 10.0f + 0.5f);
+        int tw = ti / 10;
+        int td = ti % 10;
+        if (tw < 100)
+          sprintf(displayText, "T+%dH %2d.%1dFCST", FORECAST_HORIZON_HOURS, tw, td);
+        else
+          sprintf(displayText, "T+%dH%4dFCST", FORECAST_HORIZON_HOURS, tw);
+      }
       break;
   }
   
   displayString(displayText);
 }
 
+void DisplayManager::displaySettings() {
+  displayString("Settings");
+}
+
 void DisplayManager::formatFloat(float value, char* buffer, uint8_t decimals) {
   if (decimals == 0) {
     sprintf(buffer, "%4.0f", value);
@@ -496,24 +622,26 @@ DisplayMode DisplayManager::getCurrentMode() {
 
 void DisplayManager::setBrightness(uint8_t baseBrightness) {
   // Apply color compensation to maintain consistent apparent brightness
-  byte compensatedBrightness[3];
-  
   // Calculate compensated brightness maintaining the ratios: Green=1, Amber=9, Red=15
   // Base ratios: Green=0.067, Amber=0.6, Red=1.0 (relative to red)
-  compensatedBrightness[0] = (baseBrightness * 1 + 7) / 15;  // Green: scale to 1/15 of red
-  compensatedBrightness[1] = (baseBrightness * 9 + 7) / 15;  // Amber: scale to 9/15 of red  
-  compensatedBrightness[2] = baseBrightness;                 // Red: unchanged
+  brightnessLevels[0] = (baseBrightness * 1 + 7) / 15;  // Green: scale to 1/15 of red
+  brightnessLevels[1] = (baseBrightness * 9 + 7) / 15;  // Amber: scale to 9/15 of red  
+  brightnessLevels[2] = baseBrightness;                 // Red: unchanged
   
   // Ensure minimum brightness of 1
-  if (compensatedBrightness[0] < 1) compensatedBrightness[0] = 1;
-  if (compensatedBrightness[1] < 1) compensatedBrightness[1] = 1;
-  if (compensatedBrightness[2] < 1) compensatedBrightness[2] = 1;
+  if (brightnessLevels[0] < 1) brightnessLevels[0] = 1;
+  if (brightnessLevels[1] < 1) brightnessLevels[1] = 1;
+  if (brightnessLevels[2] < 1) brightnessLevels[2] = 1;
   
-  // Re-initialize display group with new brightness
-  displayGroup->init(compensatedBrightness);
+  // Update brightness registers only - no re-init, so the display doesn't blank
+  // (kept in brightnessLevels so refreshDisplaySetup re-applies the same levels)
+  displayGroup->set_brightness(brightnessLevels);
 }
 
 void DisplayManager::adjustBrightnessForAmbientLight(float lightLevel) {
+  if (brightnessOverride != 0) {
+    return;
+  }
   uint8_t brightness;
   
   if (lightLevel < 10) {
@@ -528,9 +656,24 @@ void DisplayManager::adjustBrightnessForAmbientLight(float lightLevel) {
     brightness = 15; // Very bright
   }
   
+  // Called at the fast light-read rate - only touch the bus when the level changes
+  if (brightness == currentBrightness) {
+    return;
+  }
+  currentBrightness = brightness;
   setBrightness(brightness);
 }
 
+void DisplayManager::setBrightnessOverride(uint8_t brightness) {
+  brightnessOverride = brightness;
+  if (brightness != 0) {
+    currentBrightness = brightness;
+    setBrightness(brightness);
+  } else {
+    currentBrightness = 0;  // Next ambient reading applies its level
+  }
+}
+
 void DisplayManager::showStartupMessage() {
   displayString("ChronoSphere");
   delay(1000);
@@ -550,12 +693,6 @@ void DisplayManager::showInitFailure(const char* causes) {
   displayString(text);
 }
 
-void DisplayManager::showSetting(SettingItem setting, int value) {
-  char settingText[13];
-  sprintf(settingText, "SET %4d TING", value);
-  displayString(settingText);
-}
-
 void DisplayManager::showAlert(AlertType alertType) {
   char alertText[13];
   
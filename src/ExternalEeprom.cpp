@@ -0,0 +1,127 @@
+#include <Arduino.h>
+#include "ExternalEeprom.h"
+
+// Bytes one Wire transaction can carry (the core's TX/RX buffer)
+#ifdef BUFFER_LENGTH
+#define EXT_EEPROM_WIRE_BUFFER BUFFER_LENGTH
+#else
+#define EXT_EEPROM_WIRE_BUFFER 32
+#endif
+#define EXT_EEPROM_ADDRESS_BYTES 2
+
+ExternalEeprom::ExternalEeprom() {
+  address = EXT_EEPROM_ADDRESS;
+  present = false;
+  writePending = false;
+  lastWriteMillis = 0;
+  pageWrites = 0;
+}
+
+bool ExternalEeprom::begin(uint8_t address) {
+  this->address = address;
+  writePending = false;
+  pageWrites = 0;
+  
+  // An address-only transaction: the chip ACKs unless it is mid-write
+  Wire.beginTransmission(address);
+  present = Wire.endTransmission() == 0;
+  if (!present) {
+    // It may be finishing a write started just before a reset
+    writePending = true;
+    lastWriteMillis = millis();
+    present = waitReady();
+  }
+  return present;
+}
+
+bool ExternalEeprom::waitReady() {
+  if (!writePending) {
+    return true;
+  }
+  
+  writePending = false;
+  
+  // Once tWR has passed there is nothing to poll for
+  if (millis() - lastWriteMillis >= EXT_EEPROM_WRITE_TIMEOUT_MS) {
+    return true;
+  }
+  
+  do {
+    Wire.beginTransmission(address);
+    if (Wire.endTransmission() == 0) {
+      return true;
+    }
+  } while (millis() - lastWriteMillis < EXT_EEPROM_WRITE_TIMEOUT_MS);
+  return false;  // Still NACKing after the longest write cycle: gone
+}
+
+bool ExternalEeprom::read(uint16_t addr, uint8_t* data, uint16_t length) {
+  if (!present || (uint32_t)addr + length > EXT_EEPROM_SIZE || !waitReady()) {
+    return false;
+  }
+  
+  // Set the address pointer once; the chip then streams bytes, so a read
+  // larger than the Wire buffer just continues with more requestFrom calls
+  Wire.beginTransmission(address);
+  Wire.write((uint8_t)(addr >> 8));
+  Wire.write((uint8_t)(addr & 0xFF));
+  if (Wire.endTransmission(false) != 0) {
+    return false;
+  }
+  
+  while (length > 0) {
+    uint8_t chunk = length < EXT_EEPROM_WIRE_BUFFER ? length : EXT_EEPROM_WIRE_BUFFER;
+    if (Wire.requestFrom(address, chunk) != chunk) {
+      return false;
+    }
+    for (uint8_t i = 0; i < chunk; i++) {
+      *data++ = Wire.read();
+    }
+    length -= chunk;
+  }
+  return true;
+}
+
+bool ExternalEeprom::write(uint16_t addr, const uint8_t* data, uint16_t length) {
+  if (!present || (uint32_t)addr + length > EXT_EEPROM_SIZE) {
+    return false;
+  }
+  
+  while (length > 0) {
+    // Up to the end of the page, and no more than the Wire buffer allows
+    uint8_t chunk = EXT_EEPROM_PAGE_SIZE - (addr % EXT_EEPROM_PAGE_SIZE);
+    if (chunk > EXT_EEPROM_WIRE_BUFFER - EXT_EEPROM_ADDRESS_BYTES) {
+      chunk = EXT_EEPROM_WIRE_BUFFER - EXT_EEPROM_ADDRESS_BYTES;
+    }
+    if (chunk > length) {
+      chunk = length;
+    }
+    if (!writePage(addr, data, chunk)) {
+      return false;
+    }
+    addr += chunk;
+    data += chunk;
+    length -= chunk;
+  }
+  return true;
+}
+
+bool ExternalEeprom::writePage(uint16_t addr, const uint8_t* data, uint8_t length) {
+  if (!waitReady()) {
+    return false;
+  }
+  
+  Wire.beginTransmission(address);
+  Wire.write((uint8_t)(addr >> 8));
+  Wire.write((uint8_t)(addr & 0xFF));
+  Wire.write(data, length);
+  if (Wire.endTransmission() != 0) {
+    return false;
+  }
+  
+  // The write cycle runs on its own; the next access polls for it
+  writePending = true;
+  lastWriteMillis = millis();
+  pageWrites++;
+  return true;
+}
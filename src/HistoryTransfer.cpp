@@ -0,0 +1,158 @@
+#include <Arduino.h>
+#include "HistoryTransfer.h"
+
+static_assert(TELEMETRY_HISTORY_CHUNK_SIZE == EXT_EEPROM_PAGE_SIZE, "Import writes one EEPROM page per chunk");
+
+void HistoryTransfer::init(DataLogger* logger, Telemetry* telemetry) {
+  dataLogger = logger;
+  this->telemetry = telemetry;
+}
+
+static uint8_t storeKind(DataLogger* logger) {
+  return logger->hasExternalHistory() ? TELEMETRY_HISTORY_EXTERNAL : TELEMETRY_HISTORY_INTERNAL;
+}
+
+bool HistoryTransfer::exportHistory() {
+  dataLogger->syncStore();
+  
+  TelemetryHistoryInfo info;
+  info.store = storeKind(dataLogger);
+  info.layout = dataLogger->getStoreLayout();
+  info.size = dataLogger->getStoreSize();
+  telemetry->sendNow(TELEMETRY_HISTORY_INFO, TELEMETRY_HISTORY_VERSION, &info, sizeof(info));
+  
+  // Each chunk's read overlaps the previous frame still leaving the UART
+  TelemetryHistoryChunk chunk;
+  TelemetryHistoryEnd end;
+  end.crc = CRC16_INIT;
+  for (chunk.offset = 0; chunk.offset < info.size; chunk.offset += TELEMETRY_HISTORY_CHUNK_SIZE) {
+    if (!dataLogger->readStore(chunk.offset, chunk.data, TELEMETRY_HISTORY_CHUNK_SIZE)) {
+      return false;  // The host sees no END and discards what it got
+    }
+    for (uint8_t i = 0; i < TELEMETRY_HISTORY_CHUNK_SIZE; i++) {
+      end.crc = crc16Update(end.crc, chunk.data[i]);
+    }
+    telemetry->sendNow(TELEMETRY_HISTORY_CHUNK, TELEMETRY_HISTORY_VERSION, &chunk, sizeof(chunk));
+  }
+  telemetry->sendNow(TELEMETRY_HISTORY_END, TELEMETRY_HISTORY_VERSION, &end, sizeof(end));
+  return true;
+}
+
+bool HistoryTransfer::importHistory() {
+  TelemetryHistoryInfo info;
+  bool started = false;
+  uint16_t size = dataLogger->getStoreSize();
+  uint16_t next = 0;
+  uint16_t crc = CRC16_INIT;
+  uint8_t headerPage[TELEMETRY_HISTORY_CHUNK_SIZE];
+  
+  telemetry->flush();
+  acknowledge(HISTORY_OK, 0);  // Ready for INFO
+  
+  while (true) {
+    uint8_t raw[TELEMETRY_MAX_FRAME];
+    int16_t length = receiveFrame(raw);
+    if (length < 0) {
+      acknowledge(HISTORY_TIMEOUT, next);
+      return false;
+    }
+    if (length == 0 || raw[1] != TELEMETRY_HISTORY_VERSION) {
+      acknowledge(HISTORY_BAD_FRAME, next);
+      continue;
+    }
+    uint8_t type = raw[0];
+    uint8_t bodyLength = length - TELEMETRY_HEADER_SIZE;
+    const uint8_t *body = raw + TELEMETRY_HEADER_SIZE;
+    
+    if (type == TELEMETRY_HISTORY_INFO && bodyLength == sizeof(info)) {
+      memcpy(&info, body, sizeof(info));
+      if (info.store != storeKind(dataLogger) || info.layout != dataLogger->getStoreLayout() || info.size != size) {
+        acknowledge(HISTORY_INCOMPATIBLE, 0);
+        return false;
+      }
+      started = true;
+      next = 0;
+      crc = CRC16_INIT;
+      acknowledge(HISTORY_OK, 0);
+    } else if (type == TELEMETRY_HISTORY_CHUNK && bodyLength == sizeof(TelemetryHistoryChunk) && started) {
+      TelemetryHistoryChunk chunk;
+      memcpy(&chunk, body, sizeof(chunk));
+      if (chunk.offset + TELEMETRY_HISTORY_CHUNK_SIZE == next) {
+        acknowledge(HISTORY_OK, next);  // A resend after a lost ACK
+        continue;
+      }
+      if (chunk.offset != next || next >= size) {
+        acknowledge(HISTORY_OUT_OF_ORDER, next);
+        continue;
+      }
+      for (uint8_t i = 0; i < TELEMETRY_HISTORY_CHUNK_SIZE; i++) {
+        crc = crc16Update(crc, chunk.data[i]);
+      }
+      next += TELEMETRY_HISTORY_CHUNK_SIZE;
+      
+      // ACK first so the host's next frame arrives while the page is written
+      acknowledge(HISTORY_OK, next);
+      if (chunk.offset == 0) {
+        memcpy(headerPage, chunk.data, sizeof(headerPage));
+        dataLogger->invalidateStore();
+      } else if (!dataLogger->writeStore(chunk.offset, chunk.data, TELEMETRY_HISTORY_CHUNK_SIZE)) {
+        acknowledge(HISTORY_WRITE_FAILED, chunk.offset);
+        return false;
+      }
+    } else if (type == TELEMETRY_HISTORY_END && bodyLength == sizeof(TelemetryHistoryEnd) && started) {
+      TelemetryHistoryEnd end;
+      memcpy(&end, body, sizeof(end));
+      if (next != size) {
+        acknowledge(HISTORY_OUT_OF_ORDER, next);
+        continue;
+      }
+      if (crc != end.crc) {
+        acknowledge(HISTORY_CRC_MISMATCH, next);
+        return false;  // The image stays invalid; RAM history is rewritten to it
+      }
+      if (!dataLogger->writeStore(0, headerPage, sizeof(headerPage))) {
+        acknowledge(HISTORY_WRITE_FAILED, 0);
+        return false;
+      }
+      dataLogger->reloadFromStore();
+      acknowledge(HISTORY_OK, next);
+      return true;
+    } else {
+      acknowledge(HISTORY_BAD_FRAME, next);
+    }
+  }
+}
+
+// Reads Serial up to the next delimiter. Returns the frame's header and body
+// length, 0 for a malformed frame, or -1 after HISTORY_TRANSFER_TIMEOUT_MS
+// without one.
+int16_t HistoryTransfer::receiveFrame(uint8_t* raw) {
+  uint8_t encoded[TELEMETRY_MAX_FRAME];
+  uint8_t length = 0;
+  bool overflow = false;
+  unsigned long start = millis();
+  
+  while (millis() - start < HISTORY_TRANSFER_TIMEOUT_MS) {
+    if (Serial.available() <= 0) {
+      continue;
+    }
+    uint8_t c = Serial.read();
+    if (c != 0) {
+      if (length < sizeof(encoded)) {
+        encoded[length++] = c;
+      } else {
+        overflow = true;
+      }
+    } else if (length > 0) {
+      return overflow ? 0 : telemetryDecodeFrame(encoded, length, raw);
+    }
+  }
+  return -1;
+}
+
+void HistoryTransfer::acknowledge(TelemetryHistoryStatus status, uint16_t next) {
+  TelemetryHistoryAck ack;
+  ack.status = status;
+  ack.next = next;
+  telemetry->sendNow(TELEMETRY_HISTORY_ACK, TELEMETRY_HISTORY_VERSION, &ack, sizeof(ack));
+}
@@ -0,0 +1,82 @@
+#include <Arduino.h>
+#include "I2CBus.h"
+
+// Without the core's TWI timeout a slave holding SCL low hangs Wire for
+// good, and nothing outside Wire can break in
+#ifndef WIRE_HAS_TIMEOUT
+#error "I2CBus needs a Wire with setWireTimeout() (WIRE_HAS_TIMEOUT); update the Arduino core"
+#endif
+
+uint16_t I2CBus::timeoutCount = 0;
+uint16_t I2CBus::recoveryCount = 0;
+
+// 100kHz half-period for the manual clock pulses
+#define I2C_RECOVERY_HALF_PERIOD_US 5
+// A slave can be at most 8 data bits + ACK into a byte
+#define I2C_RECOVERY_CLOCKS 9
+
+void I2CBus::begin() {
+  if (isStuck()) {
+    recover();
+  } else {
+    startWire();
+  }
+}
+
+void I2CBus::startWire() {
+  Wire.begin();
+  // Abort any transaction that stalls longer than this and reset the TWI
+  Wire.setWireTimeout(I2C_TIMEOUT_US, true);
+}
+
+bool I2CBus::isStuck() {
+  // Between transactions both lines idle high; a low SDA means a slave is
+  // still driving a bit from an interrupted transfer
+  return digitalRead(SDA) == LOW;
+}
+
+bool I2CBus::service() {
+  bool timedOut = false;
+  if (Wire.getWireTimeoutFlag()) {
+    Wire.clearWireTimeoutFlag();
+    timeoutCount++;
+    timedOut = true;
+  }
+  
+  if (timedOut || isStuck()) {
+    recover();
+    return true;
+  }
+  return false;
+}
+
+bool I2CBus::recover() {
+  recoveryCount++;
+  
+  // Take the pins back from the TWI peripheral
+  Wire.end();
+  pinMode(SDA, INPUT_PULLUP);
+  pinMode(SCL, INPUT_PULLUP);
+  
+  // Clock SCL (open-drain style: drive low, release high) until the slave
+  // finishes its byte and lets go of SDA
+  for (uint8_t i = 0; i < I2C_RECOVERY_CLOCKS && digitalRead(SDA) == LOW; i++) {
+    digitalWrite(SCL, LOW);
+    pinMode(SCL, OUTPUT);
+    delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+    pinMode(SCL, INPUT_PULLUP);
+    delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+  }
+  
+  // STOP condition: SDA rises while SCL is high
+  digitalWrite(SDA, LOW);
+  pinMode(SDA, OUTPUT);
+  delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+  pinMode(SDA, INPUT_PULLUP);
+  delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+  
+  bool released = digitalRead(SDA) == HIGH;
+  
+  startWire();
+  return released;
+}
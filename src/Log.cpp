@@ -0,0 +1,31 @@
+#include <Arduino.h>
+#include "Log.h"
+
+Telemetry* Log::telemetry = NULL;
+
+// Copy of logMessageLevels for isEnabled(), kept in flash
+static const uint8_t levelTable[LOG_MESSAGE_COUNT] PROGMEM = {
+#define LOG_MESSAGE(id, level, format) level,
+#include "LogMessages.h"
+#undef LOG_MESSAGE
+};
+
+void Log::write(LogId id, int16_t a, int16_t b) {
+  int16_t args[] = {a, b};
+  send(id, args, 2);
+}
+
+void Log::write(LogId id, int16_t a, int16_t b, int16_t c) {
+  int16_t args[] = {a, b, c};
+  send(id, args, 3);
+}
+
+bool Log::isEnabled(uint8_t id) {
+  return id < LOG_MESSAGE_COUNT && pgm_read_byte(&levelTable[id]) <= LOG_LEVEL;
+}
+
+void Log::send(uint8_t id, const int16_t* args, uint8_t count) {
+  if (telemetry != NULL) {
+    telemetry->sendLog(id, args, count);
+  }
+}
@@ -1,5 +1,8 @@
 #include <Arduino.h>
 #include "Sensors.h"
+#include "I2CBus.h"
+#include "Log.h"
+#include "FeelsLikeTable.h"
 #include <math.h>
 
 Sensors::Sensors() : bmp280(&Wire, BMP::eSdoLow) {
@@ -7,114 +10,469 @@ Sensors::Sensors() : bmp280(&Wire, BMP::eSdoLow) {
 }
 
 bool Sensors::init() {
-  // Initialize DS3231 RTC
-  Wire.begin(); // DS3231 requires Wire to be initialized
+  I2CBus::begin(); // DS3231 requires Wire to be initialized
   
-  // The DS3231 library doesn't have a begin() method like RTClib
-  // We'll check if we can read from it instead
+  pressureProfile = BMP280_DEFAULT_PROFILE;
+  pressureWaitMicros = 0;
+  
+  ambientLux = 0;
+  preciseLux = 0;
+  preciseLightPending = false;
+  preciseLightFresh = false;
+  preciseMTreg = BH1750_DEFAULT_MTREG;
+  lastLightPoll = 0;
+  lightReadMicros = 0;
+  maxLightReadMicros = 0;
+  
+  currentData = SensorData();
+  strcpy(currentData.tempWord, "----");
+  memset(deviceStatus, 0, sizeof(deviceStatus));
+  
+  // A failed device no longer stops the others - it is marked degraded and
+  // retried with backoff from readSensors()
+  bool allOk = true;
+  for (uint8_t i = 0; i < SENSOR_DEVICE_COUNT; i++) {
+    SensorDevice device = (SensorDevice)i;
+    if (initDevice(device)) {
+      recordSuccess(device);
+    } else {
+      recordFailure(device);
+      allOk = false;
+    }
+  }
+  
+  lastReadTime = 0;
+  
+  if (allOk) {
+    LOG(LOG_SENSORS_READY);
+  }
+  return allOk;
+}
+
+bool Sensors::initDevice(SensorDevice device) {
+  switch (device) {
+    case SENSOR_RTC:
+      {
+        // The DS3231 library doesn't have a begin() method like RTClib
+        // We'll check if we can read from it instead
+        uint8_t year = rtc.getYear();
+        
+        if (year > 99) { // Invalid year suggests RTC not working
+          LOG(LOG_RTC_INIT_FAILED, year);
+          return false;
+        }
+        
+        LOG(LOG_RTC_READY);
+        return true;
+      }
+      
+    case SENSOR_AHT21:
+      // Initialize AHT21 temperature/humidity sensor
+      if (!aht.begin()) {
+        LOG(LOG_AHT21_INIT_FAILED);
+        return false;
+      }
+      return true;
+      
+    case SENSOR_BMP280:
+      // Initialize BMP280 pressure sensor (using exact working API)
+      bmp280.reset();
+      if (bmp280.begin() != BMP::eStatusOK) {
+        LOG(LOG_BMP280_INIT_FAILED, bmp280.lastOperateStatus);
+        return false;
+      }
+      
+      // Configure oversampling and filter from the selected profile
+      applyPressureProfile();
+      return true;
+      
+    case SENSOR_BH1750:
+      // Initialize BH1750 light sensor in fast (16ms) low-resolution mode;
+      // high-resolution one-shots are taken only for logged readings
+      preciseLightPending = false;
+      preciseLightFresh = false;
+      if (!lightMeter.begin(BH1750::CONTINUOUS_LOW_RES_MODE)) {
+        LOG(LOG_BH1750_INIT_FAILED);
+        return false;
+      }
+      
+      // A chip that kept power kept its MTreg; auto-ranging starts over
+      if (preciseMTreg != BH1750_DEFAULT_MTREG) {
+        preciseMTreg = BH1750_DEFAULT_MTREG;
+        lightMeter.setMTreg(BH1750_DEFAULT_MTREG);
+      }
+      return true;
+      
+    default:
+      return false;
+  }
+}
+
+bool Sensors::isDeviceDue(SensorDevice device) {
+  DeviceStatus& status = deviceStatus[device];
+  if (status.health == DEVICE_OK) {
+    return true;
+  }
+  return (long)(millis() - status.nextRetryTime) >= 0;
+}
+
+void Sensors::recordSuccess(SensorDevice device) {
+  DeviceStatus& status = deviceStatus[device];
+  if (status.health != DEVICE_OK) {
+    status.lastRecoveryMs = millis() - status.firstFailureTime;
+  }
+  status.health = DEVICE_OK;
+  status.consecutiveFailures = 0;
+}
+
+void Sensors::recordFailure(SensorDevice device) {
+  DeviceStatus& status = deviceStatus[device];
+  unsigned long now = millis();
+  
+  if (status.consecutiveFailures == 0) {
+    status.firstFailureTime = now;
+  }
+  if (status.consecutiveFailures < 255) {
+    status.consecutiveFailures++;
+  }
+  status.totalFailures++;
+  status.health = (status.consecutiveFailures >= SENSOR_OFFLINE_THRESHOLD) ? DEVICE_OFFLINE : DEVICE_DEGRADED;
+  
+  // Exponential backoff: 1x, 2x, 4x ... the base delay, capped
+  uint8_t shift = status.consecutiveFailures - 1;
+  unsigned long backoff = (shift < 8) ? (SENSOR_RETRY_BASE_MS << shift) : SENSOR_RETRY_MAX_MS;
+  if (backoff > SENSOR_RETRY_MAX_MS) backoff = SENSOR_RETRY_MAX_MS;
+  status.nextRetryTime = now + backoff;
+}
+
+bool Sensors::readRTC() {
   bool century = false;
   bool h12Flag;
   bool pm;
   
-  // Try to read the year as a test
-  uint8_t year = rtc.getYear();
+  // Read individual components
+  uint8_t year = rtc.getYear(); // DS3231 returns 2-digit year
+  uint8_t month = rtc.getMonth(century);
+  uint8_t day = rtc.getDate();
+  uint8_t hour = rtc.getHour(h12Flag, pm);
+  uint8_t minute = rtc.getMinute();
+  uint8_t second = rtc.getSecond();
   
-  if (year > 99) { // Invalid year suggests RTC not working
-    Serial.println(F("RTC initialization failed"));
+  // A missing or glitching RTC returns out-of-range BCD
+  if (year > 99 || month < 1 || month > 12 || day < 1 || day > 31 ||
+      hour > 23 || minute > 59 || second > 59) {
     return false;
   }
   
-  Serial.println(F("DS3231 RTC initialized successfully"));
-  
-  // Initialize AHT21 temperature/humidity sensor
-  if (!aht.begin()) {
-    Serial.println(F("AHT21 initialization failed"));
+  currentData.currentTime = DateTime(2000 + year, month, day, hour, minute, second);
+  return true;
+}
+
+bool Sensors::readClimate() {
+  // Read the AHT21 directly rather than through aht.getEvent(), whose busy
+  // poll has no limit and spins forever if the bus returns 0xFF
+  Wire.beginTransmission(AHT21_ADDRESS);
+  Wire.write(0xAC);  // Trigger measurement
+  Wire.write(0x33);
+  Wire.write(0x00);
+  if (Wire.endTransmission() != 0) {
     return false;
   }
   
-  // Initialize BMP280 pressure sensor (using exact working API)
-  bmp280.reset();
-  Serial.println("BMP280 initialization test");
-  
-  while(bmp280.begin() != BMP::eStatusOK) {
-    Serial.println("BMP280 begin failed");
-    switch(bmp280.lastOperateStatus) {
-      case BMP::eStatusOK: Serial.println("everything ok"); break;
-      case BMP::eStatusErr: Serial.println("unknown error"); break;
-      case BMP::eStatusErrDeviceNotDetected: Serial.println("device not detected"); break;
-      case BMP::eStatusErrParameter: Serial.println("parameter error"); break;
-      default: Serial.println("unknown status"); break;
+  uint8_t data[6];
+  unsigned long start = millis();
+  do {
+    delay(10);
+    if (Wire.requestFrom((uint8_t)AHT21_ADDRESS, (uint8_t)6) != 6) {
+      return false;
     }
-    Serial.println(F("DFRobot BMP280 IIC initialization failed"));
-    return false;
-  }
+    for (uint8_t i = 0; i < 6; i++) {
+      data[i] = Wire.read();
+    }
+    if (millis() - start > AHT21_MEASURE_TIMEOUT_MS) {
+      return false;
+    }
+  } while (data[0] & 0x80);  // Status bit 7 = busy
   
-  Serial.println("BMP280 begin success");
+  // 20-bit humidity and temperature, full scale 2^20
+  uint32_t rawHumidity = ((uint32_t)data[1] << 12) | ((uint32_t)data[2] << 4) | (data[3] >> 4);
+  uint32_t rawTemperature = ((uint32_t)(data[3] & 0x0F) << 16) | ((uint32_t)data[4] << 8) | data[5];
   
-  // Configure sensor exactly like working example
-  bmp280.setConfigFilter(BMP::eConfigFilter_off);
-  bmp280.setConfigTStandby(BMP::eConfigTStandby_125);
-  bmp280.setCtrlMeasSamplingTemp(BMP::eSampling_X8);
-  bmp280.setCtrlMeasSamplingPress(BMP::eSampling_X8);
-  bmp280.setCtrlMeasMode(BMP::eCtrlMeasModeNormal);
+  currentData.humidity = rawHumidity * 100.0f / 1048576.0f;
+  currentData.temperature = rawTemperature * 200.0f / 1048576.0f - 50.0f;
+  return true;
+}
+
+bool Sensors::readPressure() {
+#ifdef BMP280_FORCED_MODE
+  waitForPressureConversion();
+#endif
+  float pressure = bmp280.getPressure() / 100.0; // Convert Pa to hPa
   
-  // Initialize BH1750 light sensor
-  if (!lightMeter.begin()) {
-    Serial.println(F("BH1750 initialization failed"));
+  // Outside the BMP280's 300-1100 hPa range means a bad transfer
+  if (pressure < 300 || pressure > 1100) {
     return false;
   }
   
-  lastReadTime = 0;
+  currentData.pressure = pressure;
+  return true;
+}
+
+bool Sensors::isLightReady() {
+  if (preciseLightPending && lightMeter.measurementReady()) {
+    finishPreciseLightRead();
+  }
+  return !preciseLightPending;
+}
+
+bool Sensors::readLight() {
+  // Prefer the high-res one-shot taken just before this read
+  if (preciseLightFresh) {
+    currentData.lightLevel = preciseLux;
+    preciseLightFresh = false;
+    return true;
+  }
   
-  Serial.println(F("All sensors initialized successfully"));
+  float lux = timedLightRead();
+  if (lux < 0) {
+    return false;  // -1 no data, -2 not configured
+  }
+  ambientLux = lux;
+  currentData.lightLevel = lux;
   return true;
 }
 
+bool Sensors::readDevice(SensorDevice device) {
+  switch (device) {
+    case SENSOR_RTC:    return readRTC();
+    case SENSOR_AHT21:  return readClimate();
+    case SENSOR_BMP280: return readPressure();
+    case SENSOR_BH1750: return readLight();
+    default:            return false;
+  }
+}
+
 bool Sensors::readSensors() {
-  // Read DS3231 RTC - get current time directly
-  bool century = false;
-  bool h12Flag;
-  bool pm;
+#ifdef BMP280_FORCED_MODE
+  // Start the pressure conversion first - it completes while the RTC and
+  // AHT21 (~80ms measurement) are read, so the status poll rarely waits
+  if (deviceStatus[SENSOR_BMP280].health == DEVICE_OK) {
+    triggerPressureConversion();
+  }
+#endif
   
-  // Create DateTime from individual components
-  int year = 2000 + rtc.getYear(); // DS3231 returns 2-digit year
-  int month = rtc.getMonth(century);
-  int day = rtc.getDate();
-  int hour = rtc.getHour(h12Flag, pm);
-  int minute = rtc.getMinute();
-  int second = rtc.getSecond();
+  // Each device is read independently; a failure only invalidates its own
+  // channels. Values from the last good read are kept but flagged stale.
+  static const uint8_t validBits[SENSOR_DEVICE_COUNT] = {
+    SENSOR_VALID_TIME, SENSOR_VALID_CLIMATE, SENSOR_VALID_PRESSURE, SENSOR_VALID_LIGHT
+  };
+  uint8_t valid = 0;
   
-  currentData.currentTime = DateTime(year, month, day, hour, minute, second);
+  for (uint8_t i = 0; i < SENSOR_DEVICE_COUNT; i++) {
+    SensorDevice device = (SensorDevice)i;
+    if (!isDeviceDue(device)) {
+      continue;  // Backing off
+    }
+    
+    // Devices that failed last time get re-initialized before the retry
+    // (covers a module that reset or lost its configuration)
+    if (deviceStatus[device].health != DEVICE_OK) {
+      if (!initDevice(device)) {
+        recordFailure(device);
+        continue;
+      }
+#ifdef BMP280_FORCED_MODE
+      if (device == SENSOR_BMP280) {
+        triggerPressureConversion();
+      }
+#endif
+    }
+    
+    // A one-shot still integrating has no reading yet. That is neither a
+    // success nor a failure: the light channel just stays stale this time
+    if (device == SENSOR_BH1750 && !isLightReady()) {
+      continue;
+    }
+    
+    // One immediate retry absorbs a single glitched transfer; clear a
+    // timed-out or stuck bus before retrying
+    bool ok = false;
+    for (uint8_t attempt = 0; attempt < SENSOR_READ_ATTEMPTS && !ok; attempt++) {
+      if (attempt > 0) {
+        I2CBus::service();
+      }
+      ok = readDevice(device);
+    }
+    
+    if (ok) {
+      recordSuccess(device);
+      valid |= validBits[device];
+    } else {
+      recordFailure(device);
+    }
+  }
   
-  // Read AHT21
-  sensors_event_t humidity, temp;
-  if (!aht.getEvent(&humidity, &temp)) {
-    Serial.println(F("Failed to read AHT21"));
+  currentData.validFlags = valid;
+  
+  // Calculate derived values
+  if (valid & SENSOR_VALID_CLIMATE) {
+    currentData.temperatureF = celsiusToFahrenheit(currentData.temperature);
+    currentData.feelsLikeF = calculateFeelsLike(currentData.temperatureF, currentData.humidity);
+    
+    calculateTempWord(currentData.feelsLikeF);
+    currentData.displayColor = getDisplayColor(currentData.feelsLikeF);
+  }
+  
+  lastReadTime = millis();
+  return valid != 0;
+}
+
+bool Sensors::isTimeToRead() {
+  return (millis() - lastReadTime >= SENSOR_READ_INTERVAL);
+}
+
+// Oversampling and IIR filter settings per PressureProfile
+struct PressureProfileConfig {
+  uint8_t tempSampling;
+  uint8_t pressSampling;
+  uint8_t filter;
+  uint8_t maxConversionMs;  // Datasheet max: 1.25 + 2.3*osrs_t + 2.3*osrs_p + 0.575, rounded up
+};
+
+static const PressureProfileConfig pressureProfiles[] PROGMEM = {
+  {DFRobot_BMP280::eSampling_X1, DFRobot_BMP280::eSampling_X1,  DFRobot_BMP280::eConfigFilter_off, 7},   // FAST
+  {DFRobot_BMP280::eSampling_X1, DFRobot_BMP280::eSampling_X4,  DFRobot_BMP280::eConfigFilter_off, 14},  // STANDARD
+  {DFRobot_BMP280::eSampling_X2, DFRobot_BMP280::eSampling_X16, DFRobot_BMP280::eConfigFilter_X4,  44}   // ULTRA_LOW_NOISE
+};
+
+void Sensors::setPressureProfile(PressureProfile profile) {
+  pressureProfile = profile;
+  applyPressureProfile();
+}
+
+void Sensors::applyPressureProfile() {
+  const PressureProfileConfig* config = &pressureProfiles[pressureProfile];
+  bmp280.setConfigFilter((BMP::eConfigFilter_t)pgm_read_byte(&config->filter));
+  bmp280.setCtrlMeasSamplingTemp((BMP::eSampling_t)pgm_read_byte(&config->tempSampling));
+  bmp280.setCtrlMeasSamplingPress((BMP::eSampling_t)pgm_read_byte(&config->pressSampling));
+#ifdef BMP280_FORCED_MODE
+  // Sleep until readSensors() triggers a conversion
+  bmp280.setCtrlMeasMode(BMP::eCtrlMeasModeSleep);
+#else
+  bmp280.setConfigTStandby(BMP::eConfigTStandby_125);
+  bmp280.setCtrlMeasMode(BMP::eCtrlMeasModeNormal);
+#endif
+}
+
+void Sensors::triggerPressureConversion() {
+  // Writing forced mode starts one conversion; the chip returns to sleep afterwards
+  bmp280.setCtrlMeasMode(BMP::eCtrlMeasModeForced);
+}
+
+bool Sensors::isPressureConverting() {
+  // Status register 0xF3, bit 3 = measuring
+  Wire.beginTransmission(BMP280_I2C_ADDRESS);
+  Wire.write(0xF3);
+  if (Wire.endTransmission() != 0) {
     return false;
   }
+  if (Wire.requestFrom((uint8_t)BMP280_I2C_ADDRESS, (uint8_t)1) != 1) {
+    return false;
+  }
+  return (Wire.read() & 0x08) != 0;
+}
+
+bool Sensors::waitForPressureConversion() {
+  unsigned long timeout = pgm_read_byte(&pressureProfiles[pressureProfile].maxConversionMs) * 1000UL;
+  unsigned long start = micros();
   
-  currentData.temperature = temp.temperature;
-  currentData.humidity = humidity.relative_humidity;
+  while (isPressureConverting()) {
+    if (micros() - start > timeout) {
+      pressureWaitMicros = micros() - start;
+      return false;  // Data registers still hold the previous result
+    }
+    delayMicroseconds(250);
+  }
   
-  // Read BMP280
-  currentData.pressure = bmp280.getPressure() / 100.0; // Convert Pa to hPa
+  pressureWaitMicros = micros() - start;
+  return true;
+}
+
+bool Sensors::updateLight() {
+  // Leave an offline sensor alone until readSensors() brings it back
+  if (deviceStatus[SENSOR_BH1750].health == DEVICE_OFFLINE) {
+    return false;
+  }
   
-  // Read BH1750
-  currentData.lightLevel = lightMeter.readLightLevel();
+  if (preciseLightPending) {
+    if (lightMeter.measurementReady()) {
+      finishPreciseLightRead();
+    }
+    return false;
+  }
   
-  // Calculate derived values
-  currentData.temperatureF = celsiusToFahrenheit(currentData.temperature);
-  currentData.feelsLikeF = calculateFeelsLike(currentData.temperatureF, currentData.humidity);
+  // Kick off the high-res one-shot shortly before the next logged read
+  if (!preciseLightFresh && millis() - lastReadTime >= SENSOR_READ_INTERVAL - LIGHT_PRECISE_LEAD_TIME) {
+    startPreciseLightRead();
+    return false;
+  }
   
-  calculateTempWord(currentData.feelsLikeF);
-  currentData.displayColor = getDisplayColor(currentData.feelsLikeF);
+  unsigned long now = millis();
+  if (now - lastLightPoll < LIGHT_FAST_READ_INTERVAL) {
+    return false;
+  }
+  lastLightPoll = now;
   
-  lastReadTime = millis();
+  float lux = timedLightRead();
+  if (lux < 0) {
+    return false;  // -1 no data, -2 not configured
+  }
+  ambientLux = lux;
   return true;
 }
 
-bool Sensors::isTimeToRead() {
-  return (millis() - lastReadTime >= SENSOR_READ_INTERVAL);
+float Sensors::timedLightRead() {
+  unsigned long start = micros();
+  float lux = lightMeter.readLightLevel();
+  lightReadMicros = micros() - start;
+  if (lightReadMicros > maxLightReadMicros) {
+    maxLightReadMicros = lightReadMicros;
+  }
+  return lux;
+}
+
+void Sensors::startPreciseLightRead() {
+  lightMeter.configure(BH1750::ONE_TIME_HIGH_RES_MODE);
+  preciseLightPending = true;
+}
+
+void Sensors::finishPreciseLightRead() {
+  float lux = timedLightRead();
+  if (lux >= 0) {
+    preciseLux = lux;
+    preciseLightFresh = true;
+    
+    // Auto-range MTreg for the next one-shot: longer integration in very dark
+    // rooms, shorter in very bright ones. Raw count = lux * 1.2 * MTreg / 69.
+    // setMTreg blocks ~10 ms in the library, so it is sent only when the
+    // range changes; the fast low-res reads run at the same MTreg (the
+    // library scales lux by it, and even 254 stays under 60 ms)
+    uint32_t counts = (uint32_t)(lux * 1.2f * preciseMTreg / BH1750_DEFAULT_MTREG);
+    if (counts < LIGHT_MTREG_LOW_COUNTS || counts > LIGHT_MTREG_HIGH_COUNTS) {
+      uint32_t mtreg = counts > 0 ? (uint32_t)preciseMTreg * LIGHT_MTREG_TARGET_COUNTS / counts : BH1750_MTREG_MAX;
+      if (mtreg < BH1750_MTREG_MIN) mtreg = BH1750_MTREG_MIN;
+      if (mtreg > BH1750_MTREG_MAX) mtreg = BH1750_MTREG_MAX;
+      if (mtreg != preciseMTreg) {
+        preciseMTreg = mtreg;
+        lightMeter.setMTreg(preciseMTreg);
+      }
+    }
+  }
+  
+  // Back to fast low-res mode
+  lightMeter.configure(BH1750::CONTINUOUS_LOW_RES_MODE);
+  preciseLightPending = false;
+  lastLightPoll = millis();
 }
 
 SensorData Sensors::getCurrentData() {
@@ -125,13 +483,93 @@ float Sensors::celsiusToFahrenheit(float celsius) {
   return celsius * 9.0 / 5.0 + 32.0;
 }
 
+// Wind chill at the assumed constant 2 mph breeze collapses to a straight
+// line in temperature: 35.74 - 35.75*v^0.16 + (0.6215 + 0.4275*v^0.16)*T
+// with v^0.16 = 2^0.16 = 1.117287...
+#define WIND_CHILL_OFFSET_F -4.2030152f
+#define WIND_CHILL_SLOPE 1.0991403f
+
+// Four-letter word bands, checked in order against ceil(feelsLikeF) so the
+// integer thresholds keep the same "feelsLikeF <= MAX" semantics as before.
+struct TempWordBand {
+  int16_t maxF;
+  char word[4];
+};
+
+static const TempWordBand tempWordBands[] PROGMEM = {
+  {TEMP_FROZ_MAX, {'F','R','O','Z'}},
+  {TEMP_COLD_MAX, {'C','O','L','D'}},
+  {TEMP_CHLY_MAX, {'C','H','L','Y'}},
+  {TEMP_COOL_MAX, {'C','O','O','L'}},
+  {TEMP_NICE_MAX, {'N','I','C','E'}},
+  {TEMP_WARM_MAX, {'W','A','R','M'}},
+  {TEMP_COZY_MAX, {'C','O','Z','Y'}},
+  {TEMP_TOSY_MAX, {'T','O','S','Y'}},
+  {TEMP_HOT_MAX,  {'H','O','T',' '}},
+  {INT16_MAX,     {'S','C','O','R'}}
+};
+
+// Display colour zones: floor(feelsLikeF) >= minF && ceil(feelsLikeF) <= maxF.
+// Anything not covered is amber.
+struct ColorBand {
+  int16_t minF;
+  int16_t maxF;
+  uint8_t color;  // 0=Green, 2=Red
+};
+
+static const ColorBand colorBands[] PROGMEM = {
+  {COMFORT_GREEN_MIN, COMFORT_GREEN_MAX, 0},  // NICE
+  {INT16_MIN,         COMFORT_RED_MAX,   2},  // COLD and below
+  {TEMP_HOT_MAX,      INT16_MAX,         2}   // HOT and above
+};
+
+float Sensors::lookupHeatIndex(float tempF, float humidity) {
+  // Convert both inputs to 8.8 fixed-point grid coordinates
+  if (humidity < 0) humidity = 0;
+  if (humidity > 100) humidity = 100;
+  uint16_t tx = (uint16_t)((tempF - FEELS_LIKE_TABLE_MIN_F) * 256.0f);
+  uint16_t hx = (uint16_t)(humidity * FEELS_LIKE_TABLE_RH_SCALE);
+  
+  uint8_t row = tx >> 8;
+  uint16_t rowFrac = tx & 0xFF;
+  if (row >= FEELS_LIKE_TABLE_ROWS - 1) {
+    row = FEELS_LIKE_TABLE_ROWS - 2;
+    rowFrac = 256;
+  }
+  
+  uint8_t col = hx >> 8;
+  uint16_t colFrac = hx & 0xFF;
+  if (col >= FEELS_LIKE_TABLE_COLS - 1) {
+    col = FEELS_LIKE_TABLE_COLS - 2;
+    colFrac = 256;
+  }
+  
+  uint32_t v00 = pgm_read_word(&feelsLikeTable[row][col]);
+  uint32_t v10 = pgm_read_word(&feelsLikeTable[row + 1][col]);
+  uint32_t v01 = pgm_read_word(&feelsLikeTable[row][col + 1]);
+  uint32_t v11 = pgm_read_word(&feelsLikeTable[row + 1][col + 1]);
+  
+  // Interpolate along temperature, then humidity
+  uint32_t low = v00 * (256 - rowFrac) + v10 * rowFrac;
+  uint32_t high = v01 * (256 - rowFrac) + v11 * rowFrac;
+  uint32_t hundredths = (low * (256 - colFrac) + high * colFrac) >> 16;
+  
+  return hundredths / 100.0f;
+}
+
 float Sensors::calculateFeelsLike(float tempF, float humidity) {
   // NOAA Heat Index calculation for temperatures >= 80°F
   if (tempF >= 80.0) {
-    float hi = -42.379 + 2.04901523 * tempF + 10.14333127 * humidity
-               - 0.22475541 * tempF * humidity - 6.83783e-3 * tempF * tempF
-               - 5.481717e-2 * humidity * humidity + 1.22874e-3 * tempF * tempF * humidity
-               + 8.5282e-4 * tempF * humidity * humidity - 1.99e-6 * tempF * tempF * humidity * humidity;
+    float hi;
+    if (tempF <= FEELS_LIKE_TABLE_MAX_F) {
+      hi = lookupHeatIndex(tempF, humidity);
+    } else {
+      // Beyond the flash table - evaluate the regression directly
+      hi = -42.379 + 2.04901523 * tempF + 10.14333127 * humidity
+           - 0.22475541 * tempF * humidity - 6.83783e-3 * tempF * tempF
+           - 5.481717e-2 * humidity * humidity + 1.22874e-3 * tempF * tempF * humidity
+           + 8.5282e-4 * tempF * humidity * humidity - 1.99e-6 * tempF * tempF * humidity * humidity;
+    }
     
     // Adjustments for low humidity
     if (humidity < 13 && tempF >= 80 && tempF <= 112) {
@@ -149,8 +587,7 @@ float Sensors::calculateFeelsLike(float tempF, float humidity) {
   // For temperatures < 80°F, use wind chill approximation
   // Since we don't have wind sensor, assume light air (2 mph)
   if (tempF <= 50.0) {
-    float windSpeed = 2.0; // mph
-    return 35.74 + 0.6215 * tempF - 35.75 * pow(windSpeed, 0.16) + 0.4275 * tempF * pow(windSpeed, 0.16);
+    return WIND_CHILL_OFFSET_F + WIND_CHILL_SLOPE * tempF;
   }
   
   // For temperatures between 50-80°F, return actual temperature
@@ -158,38 +595,26 @@ float Sensors::calculateFeelsLike(float tempF, float humidity) {
 }
 
 void Sensors::calculateTempWord(float feelsLikeF) {
-  if (feelsLikeF <= TEMP_FROZ_MAX) {
-    strcpy(currentData.tempWord, "FROZ");
-  } else if (feelsLikeF <= TEMP_COLD_MAX) {
-    strcpy(currentData.tempWord, "COLD");
-  } else if (feelsLikeF <= TEMP_CHLY_MAX) {
-    strcpy(currentData.tempWord, "CHLY");
-  } else if (feelsLikeF <= TEMP_COOL_MAX) {
-    strcpy(currentData.tempWord, "COOL");
-  } else if (feelsLikeF <= TEMP_NICE_MAX) {
-    strcpy(currentData.tempWord, "NICE");
-  } else if (feelsLikeF <= TEMP_WARM_MAX) {
-    strcpy(currentData.tempWord, "WARM");
-  } else if (feelsLikeF <= TEMP_COZY_MAX) {
-    strcpy(currentData.tempWord, "COZY");
-  } else if (feelsLikeF <= TEMP_TOSY_MAX) {
-    strcpy(currentData.tempWord, "TOSY");
-  } else if (feelsLikeF <= TEMP_HOT_MAX) {
-    strcpy(currentData.tempWord, "HOT ");
-  } else {
-    strcpy(currentData.tempWord, "SCOR");
+  int16_t upper = (int16_t)ceil(feelsLikeF);
+  
+  uint8_t band = 0;
+  while (upper > (int16_t)pgm_read_word(&tempWordBands[band].maxF)) {
+    band++;  // Last band is INT16_MAX so the scan always terminates
   }
+  
+  memcpy_P(currentData.tempWord, tempWordBands[band].word, 4);
+  currentData.tempWord[4] = '\0';
 }
 
 uint8_t Sensors::getDisplayColor(float feelsLikeF) {
-  // Green for comfortable temperatures (NICE range)
-  if (feelsLikeF >= COMFORT_GREEN_MIN && feelsLikeF <= COMFORT_GREEN_MAX) {
-    return 0; // Green
-  }
+  int16_t lower = (int16_t)floor(feelsLikeF);
+  int16_t upper = (int16_t)ceil(feelsLikeF);
   
-  // Red for very uncomfortable temperatures (COLD and HOT+ ranges)
-  if (feelsLikeF <= COMFORT_RED_MAX || feelsLikeF >= TEMP_HOT_MAX) {
-    return 2; // Red
+  for (uint8_t i = 0; i < sizeof(colorBands) / sizeof(colorBands[0]); i++) {
+    if (lower >= (int16_t)pgm_read_word(&colorBands[i].minF) &&
+        upper <= (int16_t)pgm_read_word(&colorBands[i].maxF)) {
+      return pgm_read_byte(&colorBands[i].color);
+    }
   }
   
   // Amber for everything else
@@ -0,0 +1,141 @@
+#include <Arduino.h>
+#include "Settings.h"
+#include "Crc16.h"
+#include "Log.h"
+#include <string.h>
+
+#if defined(E2END)
+static_assert(SETTINGS_EEPROM_START + 2 * SETTINGS_COPY_SIZE <= E2END + 1, "Settings do not fit in EEPROM");
+#endif
+static_assert(SETTINGS_RECORD_SIZE <= SETTINGS_COPY_SIZE, "Settings record outgrew its copy");
+
+// Both copies, read in place where the EEPROM is mapped into data space
+// (ATmega4809), or else copied out with one get()
+struct SettingsBlock {
+  uint8_t bytes[2 * SETTINGS_COPY_SIZE];
+};
+
+static const uint8_t* storedBlock(SettingsBlock& scratch) {
+#ifdef MAPPED_EEPROM_START
+  (void)scratch;
+  return (const uint8_t*)(uintptr_t)(MAPPED_EEPROM_START + SETTINGS_EEPROM_START);
+#else
+  return EEPROM.get(SETTINGS_EEPROM_START, scratch).bytes;
+#endif
+}
+
+static uint16_t recordCrc(const uint8_t* bytes, uint8_t length) {
+  uint16_t crc = CRC16_INIT;
+  for (uint8_t i = 0; i < length; i++) {
+    crc = crc16Update(crc, bytes[i]);
+  }
+  return crc;
+}
+
+static void fillDefaults(SettingsData& data) {
+  data.chimeType = CHIME_WESTMINSTER;
+  data.chimeInstrument = INSTRUMENT_TUBULAR_BELLS;
+  data.chimeFrequency = CHIME_FREQUENCY_DEFAULT;
+  data.brightness = 0;
+  data.quietStart = QUIET_HOURS_START;
+  data.quietEnd = QUIET_HOURS_END;
+  data.quietBrightness = QUIET_HOURS_BRIGHTNESS;
+  data.pressureAlertRate = ALERT_PRESSURE_RATE;
+  data.temperatureAlertRate = ALERT_TEMPERATURE_RATE;
+}
+
+bool Settings::init() {
+  fillDefaults(data);
+  
+  SettingsBlock scratch;
+  const uint8_t *block = storedBlock(scratch);
+  for (uint8_t copy = 0; copy < 2; copy++) {
+    if (load(block + copy * SETTINGS_COPY_SIZE)) {
+      LOG(LOG_SETTINGS_LOADED, copy);
+      return true;
+    }
+  }
+  LOG(LOG_SETTINGS_DEFAULTS);
+  return false;
+}
+
+// Checks one copy and, if it's good, loads it over the defaults
+bool Settings::load(const uint8_t* record) {
+  uint8_t length = record[1];
+  if (length == 0 || length > SETTINGS_COPY_SIZE - SETTINGS_HEADER_SIZE - SETTINGS_CRC_SIZE) {
+    return false;  // Blank (0xFF) or not a record
+  }
+  uint8_t crcAt = SETTINGS_HEADER_SIZE + length;
+  uint16_t crc = recordCrc(record, crcAt);
+  if (record[crcAt] != (crc >> 8) || record[crcAt + 1] != (crc & 0xFF)) {
+    return false;  // Torn
+  }
+  
+  // A longer record, from newer firmware with the same schema, keeps the
+  // fields this one doesn't know to itself
+  SettingsData defaults = data;
+  memcpy(&data, record + SETTINGS_HEADER_SIZE, min((size_t)length, sizeof(data)));
+  if (!migrate(record[0])) {
+    data = defaults;
+    return false;
+  }
+  sanitize();
+  return true;
+}
+
+// Brings a record from an older schema up to date in place, one step per
+// schema falling through to the next. Schema 1 is the first, so there are
+// no steps yet; appended fields never need one.
+bool Settings::migrate(uint8_t schema) {
+  switch (schema) {
+    case SETTINGS_SCHEMA_VERSION:
+      return true;
+    default:
+      return false;  // Newer firmware's schema, or not a record at all
+  }
+}
+
+// A record that checks can still hold values this firmware can't use
+void Settings::sanitize() {
+  SettingsData defaults;
+  fillDefaults(defaults);
+  if (data.chimeType > CHIME_CUSTOM) data.chimeType = defaults.chimeType;
+  if (data.chimeInstrument > 127) data.chimeInstrument = defaults.chimeInstrument;
+  if (data.chimeFrequency != 1 && data.chimeFrequency != 2 && data.chimeFrequency != 4) {
+    data.chimeFrequency = defaults.chimeFrequency;
+  }
+  if (data.brightness > 15) data.brightness = defaults.brightness;
+  if (data.quietStart > 23 || data.quietEnd > 23) {
+    data.quietStart = defaults.quietStart;
+    data.quietEnd = defaults.quietEnd;
+  }
+  if (data.quietBrightness > 100) data.quietBrightness = defaults.quietBrightness;
+}
+
+uint8_t Settings::save() {
+  uint8_t record[SETTINGS_RECORD_SIZE];
+  record[0] = SETTINGS_SCHEMA_VERSION;
+  record[1] = sizeof(SettingsData);
+  memcpy(record + SETTINGS_HEADER_SIZE, &data, sizeof(SettingsData));
+  uint16_t crc = recordCrc(record, SETTINGS_HEADER_SIZE + sizeof(SettingsData));
+  record[SETTINGS_RECORD_SIZE - 2] = crc >> 8;
+  record[SETTINGS_RECORD_SIZE - 1] = crc & 0xFF;
+  
+  // First copy, then second, each byte only if it differs
+  SettingsBlock scratch;
+  const uint8_t *block = storedBlock(scratch);
+  uint8_t written = 0;
+  for (uint8_t copy = 0; copy < 2; copy++) {
+    uint8_t offset = copy * SETTINGS_COPY_SIZE;
+    for (uint8_t i = 0; i < SETTINGS_RECORD_SIZE; i++) {
+      if (block[offset + i] != record[i]) {
+        EEPROM.write(SETTINGS_EEPROM_START + offset + i, record[i]);
+        written++;
+      }
+    }
+  }
+  if (written > 0) {
+    LOG(LOG_SETTINGS_SAVED, written);
+  }
+  return written;
+}
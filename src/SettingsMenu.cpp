@@ -0,0 +1,198 @@
+#include <Arduino.h>
+#include "SettingsMenu.h"
+
+#define MENU_TEXT_LENGTH 12
+#define MENU_VALUE_START 4  // Values right-aligned on the amber and red displays
+
+// Step multiplier per MenuAccel curve, for detents under ACCEL_SLOW_MS,
+// ACCEL_FAST_MS and ACCEL_FASTEST_MS apart
+static const uint8_t accelCurves[][3] PROGMEM = {
+  {1, 1, 1},    // ACCEL_NONE
+  {2, 3, 5},    // ACCEL_LOW
+  {2, 5, 10}    // ACCEL_HIGH
+};
+
+void SettingsMenu::init(const MenuItem* table, uint8_t count, MenuHandler onLeave) {
+  items = table;
+  itemCount = count;
+  leave = onLeave;
+  current = 0;
+  field = 0;
+  opened = false;
+  editing = false;
+  redraw = false;
+  renderMicros = 0;
+}
+
+void SettingsMenu::readItem(uint8_t index, MenuItem& item) {
+  memcpy_P(&item, &items[index], sizeof(item));
+}
+
+// Rows in the item that starts at first
+uint8_t SettingsMenu::fieldCount(uint8_t first) {
+  uint8_t count = 1;
+  while (first + count < itemCount && (pgm_read_byte(&items[first + count].flags) & MENU_FIELD)) {
+    count++;
+  }
+  return count;
+}
+
+uint8_t SettingsMenu::multiplier(uint8_t curve, uint16_t interval) {
+  if (interval >= ACCEL_SLOW_MS) return 1;
+  uint8_t band = interval < ACCEL_FASTEST_MS ? 2 : (interval < ACCEL_FAST_MS ? 1 : 0);
+  return pgm_read_byte(&accelCurves[curve][band]);
+}
+
+void SettingsMenu::open() {
+  opened = true;
+  editing = false;
+  current = 0;
+  field = 0;
+  redraw = true;
+}
+
+void SettingsMenu::close() {
+  opened = false;
+  editing = false;
+  if (leave != NULL) leave();
+}
+
+void SettingsMenu::press() {
+  if (!opened) {
+    return;
+  }
+  redraw = true;
+  if (editing) {
+    field = (field + 1) % fieldCount(current);
+  } else if (pgm_read_byte(&items[current].format) == MENU_EXIT) {
+    close();
+  } else {
+    editing = true;
+    field = 0;
+  }
+}
+
+void SettingsMenu::back() {
+  if (!opened || !editing) {
+    return;
+  }
+  editing = false;
+  redraw = true;
+  if (leave != NULL) leave();
+}
+
+void SettingsMenu::turn(int delta, uint16_t interval) {
+  if (!opened || delta == 0) {
+    return;
+  }
+  redraw = true;
+  
+  if (!editing) {
+    // Whole items at a time, over the rows of multi-field ones
+    for (; delta > 0; delta--) {
+      current += fieldCount(current);
+      if (current >= itemCount) current = 0;
+    }
+    for (; delta < 0; delta++) {
+      if (current == 0) current = itemCount;
+      do {
+        current--;
+      } while (current > 0 && (pgm_read_byte(&items[current].flags) & MENU_FIELD));
+    }
+    return;
+  }
+  
+  MenuItem item;
+  readItem(current + field, item);
+  int32_t value = item.get(item.arg) + (int32_t)delta * item.step * multiplier(item.accel, interval);
+  if (value < item.min || value > item.max) {
+    if (item.flags & MENU_WRAP) {
+      int32_t span = (int32_t)item.max - item.min + 1;
+      value = item.min + ((value - item.min) % span + span) % span;
+    } else {
+      value = value < item.min ? item.min : item.max;
+    }
+  }
+  item.apply(item.arg, value);
+}
+
+// Writes value's digits right to left, ending just before end, with leading
+// zeros up to digits. Returns the first character written.
+static char* putDigits(char* end, uint16_t value, uint8_t digits) {
+  do {
+    *--end = '0' + value % 10;
+    value /= 10;
+    if (digits > 0) digits--;
+  } while (value > 0 || digits > 0);
+  return end;
+}
+
+void SettingsMenu::renderValue(const MenuItem& item, char* text) {
+  char *end = text + MENU_TEXT_LENGTH;
+  int16_t value = item.get(item.arg);
+  uint8_t name = 0xFF;
+  if (item.format == MENU_CHOICE) {
+    name = value - item.min;
+  } else if (value == 0 && item.names != NULL && item.format != MENU_HOUR) {
+    name = 0;  // "AUTO", "OFF" and the like
+  }
+  if (name != 0xFF) {
+    memcpy_P(end - MENU_NAME_LENGTH, item.names + name * MENU_NAME_LENGTH, MENU_NAME_LENGTH);
+    return;
+  }
+  
+  uint16_t magnitude = value < 0 ? -value : value;
+  char *first;
+  switch (item.format) {
+    case MENU_TENTHS:
+      first = putDigits(end, magnitude % 10, 1);
+      *--first = '.';
+      first = putDigits(first, magnitude / 10, 1);
+      break;
+    case MENU_HOUR:
+      first = putDigits(end, 0, 2);
+      *--first = ':';
+      first = putDigits(first, magnitude, 2);
+      break;
+    default:
+      first = putDigits(end, magnitude, 1);
+      break;
+  }
+  if (value < 0) *--first = '-';
+}
+
+// The whole item, each field two digits, after the current field's tag
+void SettingsMenu::renderFields(const MenuItem& item, char separator, char* text) {
+  uint8_t length = strlen(item.tag);
+  memcpy(text, item.tag, length);
+  char *p = text + length;
+  uint8_t fields = fieldCount(current);
+  for (uint8_t i = 0; i < fields; i++) {
+    MenuGetter get;
+    memcpy_P(&get, &items[current + i].get, sizeof(get));
+    if (i > 0) *p++ = separator;
+    putDigits(p + 2, get(pgm_read_byte(&items[current + i].arg)) % 100, 2);
+    p += 2;
+  }
+}
+
+void SettingsMenu::render(char* text) {
+  unsigned long start = micros();
+  memset(text, ' ', MENU_TEXT_LENGTH);
+  text[MENU_TEXT_LENGTH] = '\0';
+  
+  MenuItem item;
+  readItem(current + (editing ? field : 0), item);
+  if (!editing) {
+    memcpy(text, item.label, strlen(item.label));
+  } else if (item.format == MENU_TIME || item.format == MENU_DATE) {
+    renderFields(item, item.format == MENU_TIME ? ':' : '/', text);
+  } else {
+    memcpy(text, item.tag, strlen(item.tag));
+    renderValue(item, text);
+  }
+  redraw = false;
+  
+  unsigned long elapsed = micros() - start;
+  if (elapsed > renderMicros) renderMicros = elapsed;
+}
@@ -0,0 +1,245 @@
+#include <Arduino.h>
+#include "Telemetry.h"
+#include "I2CBus.h"
+
+static_assert((TELEMETRY_TX_BUFFER & (TELEMETRY_TX_BUFFER - 1)) == 0 && TELEMETRY_TX_BUFFER <= 256,
+              "TX ring size must be a power of two that fits uint8_t indices");
+#define TELEMETRY_RING_MASK (TELEMETRY_TX_BUFFER - 1)
+
+static uint32_t packTime(const DateTime& time) {
+  return telemetryPackTime(time.getYear(), time.getMonth(), time.getDay(),
+                           time.getHour(), time.getMinute(), time.getSecond());
+}
+
+static int16_t scaleTemperature(float fahrenheit) {
+  long value = lroundf(fahrenheit * TELEMETRY_TEMPERATURE_SCALE);
+  return constrain(value, -32767L, 32767L);
+}
+
+static uint16_t scaleHumidity(float humidity) {
+  long value = lroundf(humidity * TELEMETRY_HUMIDITY_SCALE);
+  return constrain(value, 0L, 65535L);
+}
+
+static uint16_t scalePressure(float hPa) {
+  long value = lroundf((hPa - TELEMETRY_PRESSURE_OFFSET) * TELEMETRY_PRESSURE_SCALE);
+  return constrain(value, 0L, 65535L);
+}
+
+static uint16_t scaleLight(float lux) {
+  long value = lroundf(lux);
+  return constrain(value, 0L, (long)TELEMETRY_NO_LIGHT - 1);
+}
+
+bool Telemetry::init() {
+  // A leading delimiter ends whatever text setup() printed, so the first
+  // frame isn't glued to it
+  ring[0] = 0;
+  head = 1;
+  tail = 0;
+  sequence = 0;
+  dropped = 0;
+  enabled = TELEMETRY_ENABLED;
+  
+  // Start from "all healthy" so devices that failed during setup are reported
+  lastHourlyTime = 0;
+  for (uint8_t i = 0; i < SENSOR_DEVICE_COUNT; i++) {
+    lastHealth[i] = DEVICE_OK;
+  }
+  lastRecoveries = 0;
+  
+  loopStart = micros();
+  profileStart = millis();
+  loops = 0;
+  loopMicrosSum = 0;
+  maxLoopMicros = 0;
+  maxServiceMicros = 0;
+  return true;
+}
+
+void Telemetry::service() {
+  if (head == tail) {
+    return;
+  }
+  unsigned long start = micros();
+  
+  // Hand Serial only what fits in its buffer, so write() never spins on the
+  // UART; the rest goes on a later pass
+  while (head != tail) {
+    int room = Serial.availableForWrite();
+    if (room <= 0) {
+      break;
+    }
+    uint8_t contiguous = (head > tail ? head : TELEMETRY_TX_BUFFER) - tail;
+    uint8_t count = room < contiguous ? room : contiguous;
+    Serial.write(ring + tail, count);
+    tail = (tail + count) & TELEMETRY_RING_MASK;
+  }
+  
+  unsigned long elapsed = micros() - start;
+  if (elapsed > maxServiceMicros) {
+    maxServiceMicros = elapsed > 65535 ? 65535 : elapsed;
+  }
+}
+
+bool Telemetry::send(uint8_t type, uint8_t version, const void* body, uint8_t length) {
+  if (!enabled) {
+    return false;
+  }
+  
+  uint8_t frame[TELEMETRY_MAX_FRAME];
+  uint8_t frameLength = telemetryEncodeFrame(type, version, sequence++, body, length, frame);
+  
+  // Whole frames only - a partial one would just fail the decoder's CRC
+  uint8_t used = (head - tail) & TELEMETRY_RING_MASK;
+  if (frameLength > TELEMETRY_TX_BUFFER - 1 - used) {
+    dropped++;
+    return false;
+  }
+  for (uint8_t i = 0; i < frameLength; i++) {
+    ring[head] = frame[i];
+    head = (head + 1) & TELEMETRY_RING_MASK;
+  }
+  return true;
+}
+
+void Telemetry::flush() {
+  while (head != tail) {
+    uint8_t contiguous = (head > tail ? head : TELEMETRY_TX_BUFFER) - tail;
+    Serial.write(ring + tail, contiguous);
+    tail = (tail + contiguous) & TELEMETRY_RING_MASK;
+  }
+}
+
+void Telemetry::endText() {
+  if (enabled) {
+    Serial.write((uint8_t)0);
+  }
+}
+
+void Telemetry::sendNow(uint8_t type, uint8_t version, const void* body, uint8_t length) {
+  flush();  // Keep frames whole and in sequence order
+  uint8_t frame[TELEMETRY_MAX_FRAME];
+  uint8_t frameLength = telemetryEncodeFrame(type, version, sequence++, body, length, frame);
+  Serial.write(frame, frameLength);
+}
+
+void Telemetry::sendSnapshot(const SensorData& data) {
+  TelemetrySnapshot message;
+  message.time = packTime(data.currentTime);
+  message.validFlags = data.validFlags;
+  message.temperature = scaleTemperature(data.temperatureF);
+  message.humidity = scaleHumidity(data.humidity);
+  message.pressure = scalePressure(data.pressure);
+  message.light = (data.validFlags & SENSOR_VALID_LIGHT) ? scaleLight(data.lightLevel) : TELEMETRY_NO_LIGHT;
+  send(TELEMETRY_SNAPSHOT, TELEMETRY_SNAPSHOT_VERSION, &message, sizeof(message));
+}
+
+void Telemetry::sendHourly(const HistoryRecord& record) {
+  if (record.timestamp.getYear() < 2000) {
+    return;  // No closed hour yet
+  }
+  uint32_t time = packTime(record.timestamp);
+  if (time == lastHourlyTime) {
+    return;
+  }
+  lastHourlyTime = time;
+  
+  TelemetryHourly message;
+  message.time = time;
+  message.avgTemperature = scaleTemperature(record.avgTemperature);
+  message.minTemperature = scaleTemperature(record.minTemperature);
+  message.maxTemperature = scaleTemperature(record.maxTemperature);
+  message.avgHumidity = scaleHumidity(record.avgHumidity);
+  message.avgPressure = scalePressure(record.avgPressure);
+  message.minPressure = scalePressure(record.minPressure);
+  message.maxPressure = scalePressure(record.maxPressure);
+  message.avgLight = record.hasLight ? scaleLight(record.avgLight) : TELEMETRY_NO_LIGHT;
+  send(TELEMETRY_HOURLY, TELEMETRY_HOURLY_VERSION, &message, sizeof(message));
+}
+
+void Telemetry::checkFaults(Sensors& sensors) {
+  TelemetryFault message;
+  message.time = 0;
+  
+  for (uint8_t device = 0; device < SENSOR_DEVICE_COUNT; device++) {
+    DeviceHealth health = sensors.getDeviceHealth((SensorDevice)device);
+    if (health == lastHealth[device]) continue;
+    
+    const DeviceStatus &status = sensors.getDeviceStatus((SensorDevice)device);
+    if (message.time == 0) {
+      message.time = packTime(sensors.getCurrentData().currentTime);
+    }
+    message.source = device;
+    message.health = health;
+    message.totalFailures = status.totalFailures;
+    message.lastRecoveryMs = status.lastRecoveryMs;
+    if (send(TELEMETRY_FAULT, TELEMETRY_FAULT_VERSION, &message, sizeof(message))) {
+      lastHealth[device] = health;  // Otherwise retried on the next pass
+    }
+  }
+  
+  uint16_t recoveries = I2CBus::getRecoveryCount();
+  if (recoveries != lastRecoveries) {
+    if (message.time == 0) {
+      message.time = packTime(sensors.getCurrentData().currentTime);
+    }
+    message.source = TELEMETRY_FAULT_I2C;
+    message.health = DEVICE_OK;
+    message.totalFailures = recoveries;
+    message.lastRecoveryMs = 0;
+    if (send(TELEMETRY_FAULT, TELEMETRY_FAULT_VERSION, &message, sizeof(message))) {
+      lastRecoveries = recoveries;
+    }
+  }
+}
+
+void Telemetry::sendLog(uint8_t id, const int16_t* args, uint8_t count) {
+  TelemetryLog message;
+  if (count > TELEMETRY_LOG_MAX_ARGS) {
+    count = TELEMETRY_LOG_MAX_ARGS;
+  }
+  message.id = id;
+  memcpy(message.args, args, count * sizeof(int16_t));
+  send(TELEMETRY_LOG, TELEMETRY_LOG_VERSION, &message, 1 + count * sizeof(int16_t));
+  
+  // Start it out now: setup() logs a burst before loop() first drains the ring
+  service();
+}
+
+void Telemetry::loopFinished() {
+  unsigned long elapsed = micros() - loopStart;
+  if (loops < 65535) {
+    loops++;
+    loopMicrosSum += elapsed;
+  }
+  if (elapsed > maxLoopMicros) {
+    maxLoopMicros = elapsed;
+  }
+  
+  if (millis() - profileStart >= TELEMETRY_PROFILE_INTERVAL) {
+    sendProfile();
+    profileStart = millis();
+    loops = 0;
+    loopMicrosSum = 0;
+    maxLoopMicros = 0;
+    maxServiceMicros = 0;
+  }
+}
+
+void Telemetry::getProfile(TelemetryProfile& profile) {
+  profile.loops = loops;
+  uint32_t mean = loops > 0 ? loopMicrosSum / loops : 0;
+  profile.meanLoopMicros = mean > 65535 ? 65535 : mean;
+  profile.maxLoopMicros = maxLoopMicros;
+  profile.maxServiceMicros = maxServiceMicros;
+  profile.dropped = dropped;
+  profile.i2cTimeouts = I2CBus::getTimeoutCount();
+  profile.i2cRecoveries = I2CBus::getRecoveryCount();
+}
+
+void Telemetry::sendProfile() {
+  TelemetryProfile message;
+  getProfile(message);
+  send(TELEMETRY_PROFILE, TELEMETRY_PROFILE_VERSION, &message, sizeof(message));
+}
@@ -1,9 +1,53 @@
 #include <Arduino.h>
 #include "UserInput.h"
+#include "Log.h"
 
-UserInput::UserInput() : rotaryEncoder(ROTARY_CLK_PIN, ROTARY_DT_PIN) {
+// Quarter steps for each pin change, indexed by new DT, new CLK, old DT,
+// old CLK (high bit first) - the Encoder library's table, so the direction
+// and the 4 counts per detent are unchanged. A skipped state counts 2.
+static const int8_t quadratureSteps[16] PROGMEM = {0, 1, -1, 2, -1, 0, -2, 1, 1, -2, 0, -1, 2, -1, 1, 0};
+
+// Interrupt state
+static volatile uint8_t* clkRegister;
+static volatile uint8_t* dtRegister;
+static uint8_t clkMask;
+static uint8_t dtMask;
+static uint8_t pinState;              // Old DT, old CLK
+static int8_t quarterSteps;           // Toward the next detent
+static int8_t lastDirection;
+static unsigned long lastDetentTime;
+static volatile int16_t detents;
+static volatile uint16_t detentInterval = ENCODER_INTERVAL_IDLE;
+
+static void encoderChanged() {
+  uint8_t state = pinState;
+  if (*clkRegister & clkMask) state |= 4;
+  if (*dtRegister & dtMask) state |= 8;
+  pinState = state >> 2;
+  
+  quarterSteps += (int8_t)pgm_read_byte(&quadratureSteps[state]);
+  if (quarterSteps > -4 && quarterSteps < 4) {
+    return;
+  }
+  int8_t direction = quarterSteps > 0 ? 1 : -1;
+  quarterSteps -= 4 * direction;
+  detents += direction;
+  
+  unsigned long now = millis();
+  unsigned long interval = now - lastDetentTime;
+  lastDetentTime = now;
+  // A reversal starts again at single steps
+  if (direction != lastDirection || interval > ENCODER_INTERVAL_IDLE) {
+    interval = ENCODER_INTERVAL_IDLE;
+  }
+  detentInterval = interval;
+  lastDirection = direction;
+}
+
+UserInput::UserInput() {
   lastEncoderPosition = 0;
   currentEncoderPosition = 0;
+  encoderInterval = ENCODER_INTERVAL_IDLE;
   buttonPin = ROTARY_SW_PIN;
   buttonState = BUTTON_IDLE;
   buttonPressTime = 0;
@@ -16,19 +60,29 @@ bool UserInput::init() {
   pinMode(buttonPin, INPUT_PULLUP);
   
   // Initialize encoder
-  rotaryEncoder.write(0);
-  lastEncoderPosition = 0;
-  currentEncoderPosition = 0;
+  pinMode(ROTARY_CLK_PIN, INPUT_PULLUP);
+  pinMode(ROTARY_DT_PIN, INPUT_PULLUP);
+  clkRegister = portInputRegister(digitalPinToPort(ROTARY_CLK_PIN));
+  dtRegister = portInputRegister(digitalPinToPort(ROTARY_DT_PIN));
+  clkMask = digitalPinToBitMask(ROTARY_CLK_PIN);
+  dtMask = digitalPinToBitMask(ROTARY_DT_PIN);
+  pinState = ((*clkRegister & clkMask) ? 1 : 0) | ((*dtRegister & dtMask) ? 2 : 0);
+  attachInterrupt(digitalPinToInterrupt(ROTARY_CLK_PIN), encoderChanged, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ROTARY_DT_PIN), encoderChanged, CHANGE);
+  resetEncoderPosition();
   
-  Serial.println(F("User input initialized"));
+  LOG(LOG_INPUT_READY);
   return true;
 }
 
 void UserInput::update() {
   unsigned long currentTime = millis();
   
-  // Update encoder reading
-  currentEncoderPosition = rotaryEncoder.read() / 4; // Divide by 4 for cleaner steps
+  // Update encoder reading (both written by the interrupt)
+  noInterrupts();
+  currentEncoderPosition = detents;
+  encoderInterval = detentInterval;
+  interrupts();
   
   // Update button state with debouncing
   if (currentTime - lastButtonCheck > DEBOUNCE_DELAY) {
@@ -66,10 +120,19 @@ int UserInput::getEncoderPosition() {
   return currentEncoderPosition;
 }
 
+uint16_t UserInput::getEncoderInterval() {
+  return encoderInterval;
+}
+
 void UserInput::resetEncoderPosition() {
-  rotaryEncoder.write(0);
+  noInterrupts();
+  detents = 0;
+  quarterSteps = 0;
+  detentInterval = ENCODER_INTERVAL_IDLE;
+  interrupts();
   lastEncoderPosition = 0;
   currentEncoderPosition = 0;
+  encoderInterval = ENCODER_INTERVAL_IDLE;
 }
 
 ButtonState UserInput::getButtonState() {
@@ -107,23 +170,3 @@ DisplayMode UserInput::handleModeChange(DisplayMode currentMode, int encoderDelt
   
   return (DisplayMode)modeInt;
 }
-
-SettingItem UserInput::handleSettingChange(SettingItem currentSetting, int encoderDelta) {
-  if (encoderDelta == 0) return currentSetting;
-  
-  int settingInt = (int)currentSetting;
-  
-  if (encoderDelta > 0) {
-    settingInt++;
-    if (settingInt > SETTING_MOTOR_SETTINGS) {
-      settingInt = SETTING_TIME;
-    }
-  } else {
-    settingInt--;
-    if (settingInt < SETTING_TIME) {
-      settingInt = SETTING_MOTOR_SETTINGS;
-    }
-  }
-  
-  return (SettingItem)settingInt;
-}
@@ -8,6 +8,13 @@
 #include "AudioManager.h"
 #include "DataLogger.h"
 #include "LightingEffects.h"
+#include "I2CBus.h"
+#include "Telemetry.h"
+#include "HistoryTransfer.h"
+#include "Console.h"
+#include "Log.h"
+#include "Settings.h"
+#include "SettingsMenu.h"
 #include <HybridClock.h>
 
 // Global objects
@@ -18,6 +25,11 @@ MotorControl motorControl;
 AudioManager audioManager;
 DataLogger dataLogger;
 LightingEffects lightingEffects;
+Telemetry telemetry;
+HistoryTransfer historyTransfer;
+Console console;
+Settings settings;
+SettingsMenu settingsMenu;
 
 // Device-specific calibration
 // #define CHRONOSPHERE_DEVICE1
@@ -45,13 +57,8 @@ Clock hybridClock(
 
 // System state
 DisplayMode currentDisplayMode = MODE_ROLLING_CURRENT;  // Start in rolling mode by default
-bool settingsMode = false;
-bool editingSettingValue = false;  // New: track if we're in a setting or editing its value
-SettingItem currentSetting = SETTING_TIME;
 
 // Time/Date setting state
-int settingTimeComponent = 0;  // 0=hour, 1=minute, 2=second
-int settingDateComponent = 0;  // 0=month, 1=day, 2=year
 DateTime pendingDateTime;      // Working copy for time/date changes
 bool hasDateTimeChanges = false;
 
@@ -66,34 +73,113 @@ const unsigned long ALERT_COOLDOWN_MS = 600000; // 10 minutes
 
 // Forward declarations
 void handleUserInput();
-void handleSettingChange(int delta);
 void checkWeatherAlerts();
+void applySettings();
+void logClockEvent(uint8_t event, const int16_t* values, uint8_t count);
+
+// Serial console commands (handlers at the end of this file)
+void commandHelp(Console& console);
+void commandTime(Console& console);
+void commandChimeType(Console& console);
+void commandInstrument(Console& console);
+void commandChimeFrequency(Console& console);
+void commandPreview(Console& console);
+void commandBrightness(Console& console);
+void commandQuietHours(Console& console);
+void commandAlerts(Console& console);
+void commandProfile(Console& console);
+void commandRead(Console& console);
+void commandFaults(Console& console);
+void commandExport(Console& console);
+void commandImport(Console& console);
+
+// Settings menu callbacks (after applySettings())
+enum DateTimeField { FIELD_HOUR, FIELD_MINUTE, FIELD_SECOND, FIELD_MONTH, FIELD_DAY, FIELD_YEAR };
+int16_t getDateTimeField(uint8_t field);
+void applyDateTimeField(uint8_t field, int16_t value);
+int16_t getSetting(uint8_t offset);
+void applySetting(uint8_t offset, int16_t value);
+int16_t getChimeFrequency(uint8_t unused);
+void applyChimeFrequency(uint8_t unused, int16_t value);
+void leaveSettings();
+
+const char chimeTypeNames[] PROGMEM = "WESTWHITSTMICUST";
+const char chimeFrequencyNames[] PROGMEM = "HOURHALFQRTR";
+const char autoName[] PROGMEM = "AUTO";
+const char offName[] PROGMEM = " OFF";
+
+#define SETTING(field) offsetof(SettingsData, field)
+
+// The settings menu, in list order. Rows with MENU_FIELD are further fields
+// of the item above; the press moves between them.
+const MenuItem menuItems[] PROGMEM = {
+  // label        tag     format       flags                   min   max           step accel       arg                            names                get                apply
+  {"Set TIME",    "H",    MENU_TIME,   MENU_WRAP,              0,    23,           1,   ACCEL_LOW,  FIELD_HOUR,                    NULL,                getDateTimeField,  applyDateTimeField},
+  {"",            "M",    MENU_TIME,   MENU_WRAP | MENU_FIELD, 0,    59,           1,   ACCEL_LOW,  FIELD_MINUTE,                  NULL,                getDateTimeField,  applyDateTimeField},
+  {"",            "S",    MENU_TIME,   MENU_WRAP | MENU_FIELD, 0,    59,           1,   ACCEL_LOW,  FIELD_SECOND,                  NULL,                getDateTimeField,  applyDateTimeField},
+  {"Set DATE",    "MO",   MENU_DATE,   MENU_WRAP,              1,    12,           1,   ACCEL_NONE, FIELD_MONTH,                   NULL,                getDateTimeField,  applyDateTimeField},
+  {"",            "DY",   MENU_DATE,   MENU_WRAP | MENU_FIELD, 1,    31,           1,   ACCEL_LOW,  FIELD_DAY,                     NULL,                getDateTimeField,  applyDateTimeField},
+  {"",            "YR",   MENU_DATE,   MENU_FIELD,             2020, 2099,         1,   ACCEL_LOW,  FIELD_YEAR,                    NULL,                getDateTimeField,  applyDateTimeField},
+  {"Chime TYPE",  "TYPE", MENU_CHOICE, MENU_WRAP,              0,    CHIME_CUSTOM, 1,   ACCEL_NONE, SETTING(chimeType),            chimeTypeNames,      getSetting,        applySetting},
+  {"Chime INSTR", "INST", MENU_NUMBER, MENU_WRAP,              0,    127,          1,   ACCEL_HIGH, SETTING(chimeInstrument),      NULL,                getSetting,        applySetting},
+  {"Chime FREQ",  "FREQ", MENU_CHOICE, MENU_WRAP,              0,    2,            1,   ACCEL_NONE, 0,                             chimeFrequencyNames, getChimeFrequency, applyChimeFrequency},
+  {"Brightness",  "BRT",  MENU_NUMBER, 0,                      0,    15,           1,   ACCEL_NONE, SETTING(brightness),           autoName,            getSetting,        applySetting},
+  {"Quiet START", "QST",  MENU_HOUR,   MENU_WRAP,              0,    23,           1,   ACCEL_NONE, SETTING(quietStart),           NULL,                getSetting,        applySetting},
+  {"Quiet END",   "QEND", MENU_HOUR,   MENU_WRAP,              0,    23,           1,   ACCEL_NONE, SETTING(quietEnd),             NULL,                getSetting,        applySetting},
+  {"Quiet LEVEL", "QLVL", MENU_NUMBER, 0,                      0,    100,          5,   ACCEL_LOW,  SETTING(quietBrightness),      NULL,                getSetting,        applySetting},
+  {"Press ALERT", "PALR", MENU_TENTHS, 0,                      0,    100,          1,   ACCEL_HIGH, SETTING(pressureAlertRate),    offName,             getSetting,        applySetting},
+  {"Temp ALERT",  "TALR", MENU_TENTHS, 0,                      0,    200,          1,   ACCEL_HIGH, SETTING(temperatureAlertRate), offName,             getSetting,        applySetting},
+  {"EXIT",        "",     MENU_EXIT,   0,                      0,    0,            0,   ACCEL_NONE, 0,                             NULL,                NULL,              NULL}
+};
+
+const ConsoleCommand consoleCommands[] PROGMEM = {
+  {"help",      0, 0, commandHelp,           "list commands"},
+  {"time",      0, 6, commandTime,           "[[Y-M-D] h:m:s] show or set"},
+  {"chimetype", 0, 1, commandChimeType,      "[0-3] Westm/Whitt/StMich/custom"},
+  {"instr",     0, 1, commandInstrument,     "[0-127] MIDI program, 14 bells"},
+  {"chimefreq", 0, 1, commandChimeFrequency, "[1|2|4] chimes per hour"},
+  {"preview",   0, 0, commandPreview,        "play the hour chime now"},
+  {"bright",    0, 1, commandBrightness,     "[1-15, 0 auto] display level"},
+  {"quiet",     0, 3, commandQuietHours,     "[start end pct] start=end: off"},
+  {"alerts",    0, 2, commandAlerts,         "[press temp] 0.1/hour, 0 off"},
+  {"prof",      0, 0, commandProfile,        "loop and I/O timing"},
+  {"read",      0, 0, commandRead,           "read sensors now (not logged)"},
+  {"faults",    0, 0, commandFaults,         "device health, bus errors"},
+  {"export",    0, 0, commandExport,         "history store out (binary)"},
+  {"import",    0, 0, commandImport,         "history store in (binary)"}
+};
 
 void setup() {
   Serial.begin(115200);
-  Serial.println(F("Weather Clock Starting..."));
   
-  // Initialize I2C
-  Wire.begin();
+  // Log through the telemetry stream from the first message on
+  telemetry.init();
+  Log::begin(&telemetry);
+  setClockLogHandler(logClockEvent);
+  LOG(LOG_STARTING, LOG_MESSAGE_COUNT);
+  
+  // Initialize I2C (frees a stuck bus and arms the transaction timeout)
+  I2CBus::begin();
   
   // Initialize all modules
   bool initSuccess = true;
+  bool sensorsDegraded = false;  // Sensor failures are not fatal - they are retried in the background
   char initFailCauses[11] = "";  // Accumulates short codes for failures, max 10 chars + NUL
   
   if (!sensors.init()) {
-    Serial.println(F("ERROR: Sensors initialization failed"));
+    LOG(LOG_SENSORS_DEGRADED);
     strncat(initFailCauses, "SENS ", sizeof(initFailCauses) - strlen(initFailCauses) - 1);
-    initSuccess = false;
+    sensorsDegraded = true;
   }
   
   if (!displayManager.init()) {
-    Serial.println(F("ERROR: Display initialization failed"));
+    LOG(LOG_DISPLAY_INIT_FAILED);
     strncat(initFailCauses, "DISP ", sizeof(initFailCauses) - strlen(initFailCauses) - 1);
     initSuccess = false;
   }
   
   if (!userInput.init()) {
-    Serial.println(F("ERROR: User input initialization failed"));
+    LOG(LOG_INPUT_INIT_FAILED);
     strncat(initFailCauses, "INP ", sizeof(initFailCauses) - strlen(initFailCauses) - 1);
     initSuccess = false;
   }
@@ -105,16 +191,22 @@ void setup() {
   // }
   
   if (!audioManager.init()) {
-    Serial.println(F("ERROR: Audio initialization failed"));
+    LOG(LOG_AUDIO_INIT_FAILED);
     strncat(initFailCauses, "AUD ", sizeof(initFailCauses) - strlen(initFailCauses) - 1);
     initSuccess = false;
   }
   
   if (!dataLogger.init()) {
-    Serial.println(F("ERROR: Data logger initialization failed"));
+    LOG(LOG_LOGGER_INIT_FAILED);
     strncat(initFailCauses, "DLOG", sizeof(initFailCauses) - strlen(initFailCauses) - 1);
     initSuccess = false;
   }
+  displayManager.setDataLogger(&dataLogger);
+  
+  historyTransfer.init(&dataLogger, &telemetry);
+  console.init(consoleCommands, sizeof(consoleCommands) / sizeof(consoleCommands[0]));
+  console.setTelemetry(&telemetry);
+  settingsMenu.init(menuItems, sizeof(menuItems) / sizeof(menuItems[0]), leaveSettings);
   
   // Lighting effects removed - NeoPixel control deprecated (future clock display will handle LEDs)
   // if (!lightingEffects.init()) {
@@ -125,28 +217,32 @@ void setup() {
   // Initialize HybridClock (analog clock mechanism)
   // Only run calibration/motor movement if other hardware is healthy
   if (initSuccess) {
-    Serial.println(F("All modules initialized successfully"));
+    LOG(LOG_MODULES_READY);
+    
+    // Stored settings over the modules' defaults, from one EEPROM read
+    settings.init();
+    applySettings();
+    
+    if (sensorsDegraded) {
+      displayManager.showInitFailure(initFailCauses);
+      delay(2000);
+    }
     displayManager.showStartupMessage();
-    Serial.println(F("Initializing HybridClock..."));
+    LOG(LOG_CLOCK_INIT_START);
     hybridClock.setCenteringAdjustment(CENTERING_ADJUSTMENT);  // Adjust for your device
     hybridClock.enableMicroCalibration(true, 4);  // Recalibrate every 4 hours
     hybridClock.enableHourChangeAnimation(false);  // Disable animations to save flash
-    hybridClock.enableQuietHours(true, QUIET_HOURS_START, QUIET_HOURS_END, QUIET_HOURS_BRIGHTNESS);  // Dim LEDs 10PM-8AM
     hybridClock.setDisplayPattern(ClockDisplay::DEFAULT_COMPLEMENT);  // Simple pattern
     hybridClock.begin();
     hybridClock.update(true);  // Force display refresh so LEDs are lit immediately after init
-    Serial.println(F("HybridClock initialized successfully"));
+    LOG(LOG_CLOCK_INIT_DONE);
   } else {
-    Serial.println(F("Skipping HybridClock init due to earlier failure"));
+    LOG(LOG_CLOCK_INIT_SKIPPED);
   }
   
   if (initSuccess) {
     // Read sensors once at startup to initialize data
     if (sensors.readSensors()) {
-      // Seed historical data with current values so trend-based alerts start
-      // from a zero-delta baseline, preventing false alerts on startup.
-      dataLogger.seedCurrentData(sensors.getCurrentData());
-
       // Sensor initialization successful - now play startup chime with current hour
       DateTime currentTime = sensors.getCurrentTime();
       uint8_t currentHour = currentTime.getHour();
@@ -154,7 +250,7 @@ void setup() {
       // Play startup chime with current hour chimes for testing
       audioManager.playStartupChime(currentHour);
     } else {
-      Serial.println(F("WARNING: Initial sensor read failed"));
+      LOG(LOG_FIRST_READ_FAILED);
       // Play basic startup chime if sensor read fails
       audioManager.playStartupChime();
     }
@@ -162,23 +258,33 @@ void setup() {
     // Set initial display mode to ensure synchronization
     displayManager.setMode(currentDisplayMode);
   } else {
-    Serial.println(F("FATAL: System initialization failed"));
+    LOG(LOG_INIT_FATAL);
+    telemetry.flush();  // loop() never runs to drain it
     displayManager.showInitFailure(initFailCauses);
     // lightingEffects.showErrorPattern();  // DEPRECATED - NeoPixel removed
     while(1) delay(1000); // Halt system
   }
   
-  Serial.println(F("Weather Clock Ready"));
+  LOG(LOG_READY);
 }
 
 void loop() {
   unsigned long currentTime = millis();
   
+  // Telemetry drains and the console takes a byte on every call, between
+  // the paced passes as well
+  telemetry.service();
+  console.service();
+  
   // Main loop timing control
   if (currentTime - lastMainLoop < MAIN_LOOP_INTERVAL) {
     return;
   }
   lastMainLoop = currentTime;
+  telemetry.loopStarted();
+  
+  // Catch I2C timeouts or a stuck SDA line before this iteration's transfers
+  I2CBus::service();
   
   // Update all input sources
   userInput.update();
@@ -186,6 +292,11 @@ void loop() {
   // Handle user input
   handleUserInput();
   
+  // Fast ambient light channel drives display dimming
+  if (sensors.updateLight()) {
+    displayManager.adjustBrightnessForAmbientLight(sensors.getAmbientLight());
+  }
+  
   // Always get current sensor data (or use last good reading)
   SensorData currentData = sensors.getCurrentData();
   
@@ -197,34 +308,39 @@ void loop() {
   SensorData realData = currentData;  // Keep a copy of real sensor data
   if (sensors.isTimeToRead()) {
     if (sensors.readSensors()) {
-      realData = sensors.getCurrentData();  // Get fresh real data
+      realData = sensors.getCurrentData();  // Get fresh real data (may be partial - see validFlags)
       
-      // Update data logger
+      // Update data logger (skips stale channels)
       dataLogger.update(realData);
+      displayManager.setForecast(dataLogger.getForecast());
+      telemetry.sendSnapshot(realData);
+      telemetry.sendHourly(dataLogger.getHourlyRecord(0));
       
       // NeoPixel updates removed - LED control deprecated
       // lightingEffects.update(realData);
       
       // Adjust lighting based on ambient light
       // lightingEffects.adjustBrightnessForAmbientLight(realData.lightLevel);
-      displayManager.adjustBrightnessForAmbientLight(realData.lightLevel);
+      // Display dimming is driven by the fast light channel above
       
       // Check for alerts
       checkWeatherAlerts();
       
     } else {
-      Serial.println(F("WARNING: Sensor read failed"));
+      LOG(LOG_SENSOR_READ_FAILED);
     }
   }
   
-  // Update display every cycle (like hardware test does)
-  if (displayManager.isTimeToUpdate()) {
-    if (settingsMode) {
-      displayManager.updateSettings(currentData, settingsMode, currentSetting, 
-                                    settingTimeComponent, settingDateComponent, pendingDateTime, editingSettingValue);
-    } else {
-      displayManager.update(currentData);
+  // Update display every cycle (like hardware test does); the menu also
+  // redraws as soon as input changes it
+  if (settingsMenu.isOpen()) {
+    if (settingsMenu.needsRedraw() || displayManager.isTimeToUpdate()) {
+      char text[13];
+      settingsMenu.render(text);
+      displayManager.showMenu(text);
     }
+  } else if (displayManager.isTimeToUpdate()) {
+    displayManager.update(currentData);
   }
   
   // Update continuous systems
@@ -233,6 +349,9 @@ void loop() {
   
   // Check for chimes
   audioManager.checkAndPlayChime(sensors.getCurrentTime());
+  
+  telemetry.checkFaults(sensors);
+  telemetry.loopFinished();
 }
 
 void handleUserInput() {
@@ -252,49 +371,11 @@ void handleUserInput() {
   }
   
   if (buttonJustPressed) {
-    if (!settingsMode) {
-      // Enter settings mode (settings menu)
-      settingsMode = true;
-      editingSettingValue = false;  // Start in menu, not editing
-      currentSetting = SETTING_TIME;
-      settingTimeComponent = 0;
-      settingDateComponent = 0;
+    if (!settingsMenu.isOpen()) {
       hasDateTimeChanges = false;
-    } else if (!editingSettingValue) {
-      // In settings menu - enter the selected setting to edit it OR exit
-      if (currentSetting == SETTING_EXIT) {
-        // EXIT option selected - leave settings mode
-        
-        // Save any pending time/date changes before exiting
-        if (hasDateTimeChanges) {
-          sensors.setDateTime(pendingDateTime);
-          
-          // Force immediate sensor read to update display with new time
-          sensors.readSensors();
-          
-          hasDateTimeChanges = false;
-        }
-        
-        settingsMode = false;
-        editingSettingValue = false;
-      } else {
-        // Regular setting selected - enter editing mode
-        editingSettingValue = true;
-        
-        // Initialize components for the selected setting
-        if (currentSetting == SETTING_TIME) {
-          settingTimeComponent = 0;  // Start with hour
-        } else if (currentSetting == SETTING_DATE) {
-          settingDateComponent = 0;  // Start with month
-        }
-      }
+      settingsMenu.open();
     } else {
-      // In setting edit mode - cycle through components
-      if (currentSetting == SETTING_TIME) {
-        settingTimeComponent = (settingTimeComponent + 1) % 3;
-      } else if (currentSetting == SETTING_DATE) {
-        settingDateComponent = (settingDateComponent + 1) % 3;
-      }
+      settingsMenu.press();
     }
   }
   
@@ -307,32 +388,13 @@ void handleUserInput() {
   
   if (buttonJustReleased && wasHeld) {
     wasHeld = false; // Reset the flag
-    
-    if (settingsMode && editingSettingValue) {
-      // Exit from editing back to settings menu (long press only works when editing)
-      if (hasDateTimeChanges) {
-        sensors.setDateTime(pendingDateTime);
-        
-        // Force immediate sensor read to update display with new time
-        sensors.readSensors();
-        
-        hasDateTimeChanges = false;
-      }
-      editingSettingValue = false;
-    }
+    settingsMenu.back();
   }
   
   // Handle encoder rotation
   if (encoderDelta != 0) {
-    if (settingsMode && !editingSettingValue) {
-      // In settings menu - navigate through settings list
-      int newSetting = (int)currentSetting + encoderDelta;
-      if (newSetting < 0) newSetting = SETTING_EXIT;  // Wrap to EXIT (last setting)
-      if (newSetting > SETTING_EXIT) newSetting = 0;   // Wrap to first setting
-      currentSetting = (SettingItem)newSetting;
-    } else if (settingsMode && editingSettingValue) {
-      // In setting edit mode - adjust the setting value
-      handleSettingChange(encoderDelta);
+    if (settingsMenu.isOpen()) {
+      settingsMenu.turn(encoderDelta, userInput.getEncoderInterval());
     } else {
       // Normal display mode - change display mode
       DisplayMode newMode = userInput.handleModeChange(currentDisplayMode, encoderDelta);
@@ -344,132 +406,6 @@ void handleUserInput() {
   }
 }
 
-void handleSettingChange(int delta) {
-  switch (currentSetting) {
-    case SETTING_TIME:
-      {
-        // Initialize pending time if first edit
-        if (!hasDateTimeChanges) {
-          pendingDateTime = sensors.getCurrentTime();
-          hasDateTimeChanges = true;
-        }
-        
-        // Adjust current time component
-        switch (settingTimeComponent) {
-          case 0: // Hour
-            {
-              int hour = pendingDateTime.getHour() + delta;
-              if (hour < 0) hour = 23;
-              if (hour > 23) hour = 0;
-              pendingDateTime = DateTime(pendingDateTime.getYear(), pendingDateTime.getMonth(), 
-                                       pendingDateTime.getDay(), hour, pendingDateTime.getMinute(), 
-                                       pendingDateTime.getSecond());
-            }
-            break;
-          case 1: // Minute
-            {
-              int minute = pendingDateTime.getMinute() + delta;
-              if (minute < 0) minute = 59;
-              if (minute > 59) minute = 0;
-              pendingDateTime = DateTime(pendingDateTime.getYear(), pendingDateTime.getMonth(), 
-                                       pendingDateTime.getDay(), pendingDateTime.getHour(), minute, 
-                                       pendingDateTime.getSecond());
-            }
-            break;
-          case 2: // Second
-            {
-              int second = pendingDateTime.getSecond() + delta;
-              if (second < 0) second = 59;
-              if (second > 59) second = 0;
-              pendingDateTime = DateTime(pendingDateTime.getYear(), pendingDateTime.getMonth(), 
-                                       pendingDateTime.getDay(), pendingDateTime.getHour(), 
-                                       pendingDateTime.getMinute(), second);
-            }
-            break;
-        }
-        
-        // // Show current time setting (minimal output)
-        // Serial.print(F("Time: "));
-        // Serial.print(pendingDateTime.getHour());
-        // Serial.print(F(":"));
-        // if (pendingDateTime.getMinute() < 10) Serial.print(F("0"));
-        // Serial.print(pendingDateTime.getMinute());
-        // Serial.print(F(":"));
-        // if (pendingDateTime.getSecond() < 10) Serial.print(F("0"));
-        // Serial.println(pendingDateTime.getSecond());
-      }
-      break;
-      
-    case SETTING_DATE:
-      {
-        // Initialize pending date if first edit
-        if (!hasDateTimeChanges) {
-          pendingDateTime = sensors.getCurrentTime();
-          hasDateTimeChanges = true;
-        }
-        
-        // Adjust current date component
-        switch (settingDateComponent) {
-          case 0: // Month
-            {
-              int month = pendingDateTime.getMonth() + delta;
-              if (month < 1) month = 12;
-              if (month > 12) month = 1;
-              pendingDateTime = DateTime(pendingDateTime.getYear(), month, pendingDateTime.getDay(), 
-                                       pendingDateTime.getHour(), pendingDateTime.getMinute(), 
-                                       pendingDateTime.getSecond());
-            }
-            break;
-          case 1: // Day
-            {
-              int day = pendingDateTime.getDay() + delta;
-              if (day < 1) day = 31;  // Simplified - doesn't account for different month lengths
-              if (day > 31) day = 1;
-              pendingDateTime = DateTime(pendingDateTime.getYear(), pendingDateTime.getMonth(), day, 
-                                       pendingDateTime.getHour(), pendingDateTime.getMinute(), 
-                                       pendingDateTime.getSecond());
-            }
-            break;
-          case 2: // Year
-            {
-              int year = pendingDateTime.getYear() + delta;
-              if (year < 2020) year = 2020;
-              if (year > 2099) year = 2099;
-              pendingDateTime = DateTime(year, pendingDateTime.getMonth(), pendingDateTime.getDay(), 
-                                       pendingDateTime.getHour(), pendingDateTime.getMinute(), 
-                                       pendingDateTime.getSecond());
-            }
-            break;
-        }
-        
-        // // Show current date setting
-        // Serial.print(F("Date: "));
-        // Serial.print(pendingDateTime.getMonth());
-        // Serial.print(F("/"));
-        // Serial.print(pendingDateTime.getDay());
-        // Serial.print(F("/"));
-        // Serial.println(pendingDateTime.getYear());
-      }
-      break;
-      
-    case SETTING_CHIME_TYPE:
-      // Serial.println(F("Adjusting chime type not implemented"));
-      break;
-      
-    case SETTING_CHIME_INSTRUMENT:
-      // Serial.println(F("Adjusting chime instrument not implemented"));
-      break;
-      
-    case SETTING_CHIME_FREQUENCY:
-      // Serial.println(F("Adjusting chime frequency not implemented"));
-      break;
-      
-    default:
-      // Serial.println(F("Setting not implemented"));
-      break;
-  }
-}
-
 void checkWeatherAlerts() {
   // Don't trigger new alerts if we're in the cooldown period
   unsigned long currentMillis = millis();
@@ -504,3 +440,343 @@ void checkWeatherAlerts() {
     alertEverFired = true;
   }
 }
+
+// Pushes the settings record to the modules that use it
+void applySettings() {
+  SettingsData& data = settings.getData();
+  audioManager.setChimeType((ChimeType)data.chimeType);
+  audioManager.setChimeInstrument((MidiInstrument)data.chimeInstrument);
+  audioManager.setChimeFrequency(data.chimeFrequency);
+  displayManager.setBrightnessOverride(data.brightness);
+  hybridClock.enableQuietHours(true, data.quietStart, data.quietEnd, data.quietBrightness);
+  dataLogger.setAlertRates(data.pressureAlertRate, data.temperatureAlertRate);
+}
+
+// ============================================================================
+// SETTINGS MENU CALLBACKS
+// ============================================================================
+// Settings change the record in RAM and take effect at once; it is saved
+// when the item is left. Time and date edit a copy of the clock, set then.
+
+int16_t getDateTimeField(uint8_t field) {
+  DateTime time = hasDateTimeChanges ? pendingDateTime : sensors.getCurrentTime();
+  switch (field) {
+    case FIELD_HOUR:   return time.getHour();
+    case FIELD_MINUTE: return time.getMinute();
+    case FIELD_SECOND: return time.getSecond();
+    case FIELD_MONTH:  return time.getMonth();
+    case FIELD_DAY:    return time.getDay();  // Any of 1-31 - doesn't account for month lengths
+    default:           return time.getYear();
+  }
+}
+
+void applyDateTimeField(uint8_t field, int16_t value) {
+  // Initialize pending time if first edit
+  if (!hasDateTimeChanges) {
+    pendingDateTime = sensors.getCurrentTime();
+    hasDateTimeChanges = true;
+  }
+  int parts[] = {pendingDateTime.getHour(), pendingDateTime.getMinute(), pendingDateTime.getSecond(),
+                 pendingDateTime.getMonth(), pendingDateTime.getDay(), pendingDateTime.getYear()};
+  parts[field] = value;
+  pendingDateTime = DateTime(parts[FIELD_YEAR], parts[FIELD_MONTH], parts[FIELD_DAY],
+                             parts[FIELD_HOUR], parts[FIELD_MINUTE], parts[FIELD_SECOND]);
+}
+
+// Byte fields of SettingsData, by offset
+int16_t getSetting(uint8_t offset) {
+  return ((uint8_t*)&settings.getData())[offset];
+}
+
+void applySetting(uint8_t offset, int16_t value) {
+  ((uint8_t*)&settings.getData())[offset] = value;
+  applySettings();
+}
+
+// 1, 2, 4 chimes per hour as choices 0-2
+int16_t getChimeFrequency(uint8_t unused) {
+  uint8_t frequency = settings.getData().chimeFrequency;
+  return frequency == 1 ? 0 : (frequency == 2 ? 1 : 2);
+}
+
+void applyChimeFrequency(uint8_t unused, int16_t value) {
+  settings.getData().chimeFrequency = 1 << value;
+  applySettings();
+}
+
+// End of editing or EXIT
+void leaveSettings() {
+  if (hasDateTimeChanges) {
+    sensors.setDateTime(pendingDateTime);
+    
+    // Force immediate sensor read to update display with new time
+    sensors.readSensors();
+    
+    hasDateTimeChanges = false;
+  }
+  settings.save();  // Only bytes that changed, if any
+}
+
+// HybridClock's log events (ClockLog.h) are the last block of the catalog
+void logClockEvent(uint8_t event, const int16_t* values, uint8_t count) {
+  uint8_t id = LOG_MESSAGE_COUNT - CLOCK_LOG_EVENT_COUNT + event;
+  if (Log::isEnabled(id)) {
+    Log::send(id, values, count);
+  }
+}
+
+// ============================================================================
+// SERIAL CONSOLE COMMANDS
+// ============================================================================
+
+const char deviceNames[SENSOR_DEVICE_COUNT][7] PROGMEM = {"RTC", "AHT21", "BMP280", "BH1750"};
+const char healthNames[3][9] PROGMEM = {"ok", "degraded", "offline"};
+
+void printTwoDigits(uint8_t value) {
+  if (value < 10) Serial.print('0');
+  Serial.print(value);
+}
+
+void printDateTime(DateTime time) {
+  Serial.print(time.getYear());
+  Serial.print('-');
+  printTwoDigits(time.getMonth());
+  Serial.print('-');
+  printTwoDigits(time.getDay());
+  Serial.print(' ');
+  printTwoDigits(time.getHour());
+  Serial.print(':');
+  printTwoDigits(time.getMinute());
+  Serial.print(':');
+  printTwoDigits(time.getSecond());
+  Serial.println();
+}
+
+void commandHelp(Console& console) {
+  console.printHelp();
+}
+
+// "time h:m:s" keeps the date, "time Y-M-D h:m:s" sets both
+void commandTime(Console& console) {
+  uint8_t count = console.getArgCount();
+  if (count > 0) {
+    DateTime now = sensors.getCurrentTime();
+    int16_t year = now.getYear();
+    int16_t month = now.getMonth();
+    int16_t day = now.getDay();
+    uint8_t first = 0;
+    if (count == 6) {
+      year = console.getArg(0);
+      month = console.getArg(1);
+      day = console.getArg(2);
+      first = 3;
+    } else if (count != 3) {
+      console.printUsage();
+      return;
+    }
+    int16_t hour = console.getArg(first);
+    int16_t minute = console.getArg(first + 1);
+    int16_t second = console.getArg(first + 2);
+    if (year < 2000 || year > 2099 || month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) {
+      Serial.println(F("? out of range"));
+      return;
+    }
+    sensors.setDateTime(DateTime(year, month, day, hour, minute, second));
+    sensors.readSensors();
+  }
+  printDateTime(sensors.getCurrentTime());
+}
+
+void commandChimeType(Console& console) {
+  if (console.getArgCount() > 0) {
+    int16_t type = console.getArg(0);
+    if (type < CHIME_WESTMINSTER || type > CHIME_CUSTOM) {
+      console.printUsage();
+      return;
+    }
+    settings.getData().chimeType = type;
+    applySettings();
+    settings.save();
+  }
+  Serial.print(F("chime type "));
+  Serial.println(audioManager.getChimeType());
+}
+
+void commandInstrument(Console& console) {
+  if (console.getArgCount() > 0) {
+    int16_t program = console.getArg(0);
+    if (program < 0 || program > 127) {
+      console.printUsage();
+      return;
+    }
+    settings.getData().chimeInstrument = program;
+    applySettings();
+    settings.save();
+  }
+  Serial.print(F("instrument "));
+  Serial.println(audioManager.getChimeInstrument());
+}
+
+void commandChimeFrequency(Console& console) {
+  if (console.getArgCount() > 0) {
+    int16_t frequency = console.getArg(0);
+    if (frequency != 1 && frequency != 2 && frequency != 4) {
+      console.printUsage();
+      return;
+    }
+    settings.getData().chimeFrequency = frequency;
+    applySettings();
+    settings.save();
+  }
+  Serial.print(F("chimes per hour "));
+  Serial.println(audioManager.getChimeFrequency());
+}
+
+void commandPreview(Console& console) {
+  Serial.println(F("chiming"));
+  audioManager.playTestChime();
+}
+
+void commandBrightness(Console& console) {
+  if (console.getArgCount() > 0) {
+    int16_t level = console.getArg(0);
+    if (level < 0 || level > 15) {
+      console.printUsage();
+      return;
+    }
+    settings.getData().brightness = level;
+    applySettings();
+    settings.save();
+  }
+  Serial.print(F("brightness "));
+  Serial.print(displayManager.getBrightness());
+  Serial.println(displayManager.getBrightnessOverride() != 0 ? F(" fixed") : F(" auto"));
+}
+
+void commandQuietHours(Console& console) {
+  SettingsData& data = settings.getData();
+  if (console.getArgCount() > 0) {
+    int16_t start = console.getArg(0);
+    int16_t end = console.getArg(1);
+    int16_t percent = console.getArg(2);
+    if (console.getArgCount() != 3 || start < 0 || start > 23 || end < 0 || end > 23 ||
+        percent < 0 || percent > 100) {
+      console.printUsage();
+      return;
+    }
+    data.quietStart = start;
+    data.quietEnd = end;
+    data.quietBrightness = percent;
+    applySettings();
+    settings.save();
+  }
+  if (data.quietStart == data.quietEnd) {
+    Serial.println(F("quiet hours off"));
+    return;
+  }
+  Serial.print(F("quiet hours "));
+  Serial.print(data.quietStart);
+  Serial.print(F(":00-"));
+  Serial.print(data.quietEnd);
+  Serial.print(F(":00 at "));
+  Serial.print(data.quietBrightness);
+  Serial.println('%');
+}
+
+// Rates in 0.1 hPa/hour (falling) and 0.1 °F/hour (either way)
+void commandAlerts(Console& console) {
+  SettingsData& data = settings.getData();
+  if (console.getArgCount() > 0) {
+    int16_t pressure = console.getArg(0);
+    int16_t temperature = console.getArg(1);
+    if (console.getArgCount() != 2 || pressure < 0 || pressure > 255 || temperature < 0 || temperature > 255) {
+      console.printUsage();
+      return;
+    }
+    data.pressureAlertRate = pressure;
+    data.temperatureAlertRate = temperature;
+    applySettings();
+    settings.save();
+  }
+  Serial.print(F("alert past "));
+  Serial.print(data.pressureAlertRate / 10.0, 1);
+  Serial.print(F(" hPa/h falling, "));
+  Serial.print(data.temperatureAlertRate / 10.0, 1);
+  Serial.println(F(" F/h (0 off)"));
+}
+
+void commandProfile(Console& console) {
+  TelemetryProfile profile;
+  telemetry.getProfile(profile);
+  Serial.print(F("loops "));
+  Serial.print(profile.loops);
+  Serial.print(F(" mean "));
+  Serial.print(profile.meanLoopMicros);
+  Serial.print(F("us max "));
+  Serial.print(profile.maxLoopMicros);
+  Serial.print(F("us, telemetry drain max "));
+  Serial.print(profile.maxServiceMicros);
+  Serial.println(F("us"));
+  
+  Serial.print(F("light read "));
+  Serial.print(sensors.getLightReadMicros());
+  Serial.print(F("us max "));
+  Serial.print(sensors.getMaxLightReadMicros());
+  Serial.print(F("us, pressure wait "));
+  Serial.print(sensors.getPressureWaitMicros());
+  Serial.print(F("us, history restore "));
+  Serial.print(dataLogger.getRestoreMicros());
+  Serial.print(F("us, menu draw max "));
+  Serial.print(settingsMenu.getRenderMicros());
+  Serial.println(F("us"));
+}
+
+// An extra read outside the schedule; the logger only takes the 30s reads
+void commandRead(Console& console) {
+  if (!sensors.readSensors()) {
+    Serial.println(F("? no sensor answered"));
+    return;
+  }
+  SensorData data = sensors.getCurrentData();
+  Serial.print(data.temperatureF, 1);
+  Serial.print(F("F "));
+  Serial.print(data.humidity, 1);
+  Serial.print(F("% "));
+  Serial.print(data.pressure, 1);
+  Serial.print(F("hPa "));
+  Serial.print(data.lightLevel, 1);
+  Serial.print(F("lx valid 0x"));
+  Serial.println(data.validFlags, HEX);
+}
+
+void commandFaults(Console& console) {
+  for (uint8_t i = 0; i < SENSOR_DEVICE_COUNT; i++) {
+    const DeviceStatus& status = sensors.getDeviceStatus((SensorDevice)i);
+    Serial.print((const __FlashStringHelper*)deviceNames[i]);
+    Serial.print(' ');
+    Serial.print((const __FlashStringHelper*)healthNames[status.health]);
+    Serial.print(F(", failures "));
+    Serial.print(status.consecutiveFailures);
+    Serial.print(F(" in a row, "));
+    Serial.print(status.totalFailures);
+    Serial.print(F(" total, last outage "));
+    Serial.print(status.lastRecoveryMs);
+    Serial.println(F("ms"));
+  }
+  Serial.print(F("I2C timeouts "));
+  Serial.print(I2CBus::getTimeoutCount());
+  Serial.print(F(", recoveries "));
+  Serial.print(I2CBus::getRecoveryCount());
+  Serial.print(F(", telemetry frames dropped "));
+  Serial.println(telemetry.getDropped());
+}
+
+// Binary transfers for tools/history_transfer.cpp
+void commandExport(Console& console) {
+  historyTransfer.exportHistory();
+}
+
+void commandImport(Console& console) {
+  historyTransfer.importHistory();
+}
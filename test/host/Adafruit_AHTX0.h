@@ -0,0 +1,26 @@
+#ifndef HOST_ADAFRUIT_AHTX0_H
+#define HOST_ADAFRUIT_AHTX0_H
+
+#include <Wire.h>
+
+// Host stand-in for Adafruit_AHTX0: begin() only, as the firmware reads
+// the sensor itself
+
+#define AHTX0_I2CADDR_DEFAULT 0x38
+
+struct sensors_event_t {
+  float temperature;
+  float relative_humidity;
+};
+
+class Adafruit_AHTX0 {
+public:
+  bool begin(TwoWire* wire = &Wire, int32_t sensorId = 0, uint8_t address = AHTX0_I2CADDR_DEFAULT);
+  uint8_t getStatus();
+
+private:
+  TwoWire* wire = &Wire;
+  uint8_t address = AHTX0_I2CADDR_DEFAULT;
+};
+
+#endif
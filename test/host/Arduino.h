@@ -0,0 +1,128 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Host stand-in for the Arduino megaAVR core: enough of the API for the
+// firmware modules to build and run on a PC under test/. Time is virtual
+// (see HostTest.h) and only moves when a test or a delay() moves it.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define HEX 16
+#define DEC 10
+
+// Flash is ordinary memory on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define PGM_P const char*
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_ptr(p) (*(void* const*)(p))
+#define pgm_read_byte_near pgm_read_byte
+#define pgm_read_word_near pgm_read_word
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strlen_P strlen
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#define SDA 18
+#define SCL 19
+#define A0 14
+#define A6 20
+#define A7 21
+
+#ifndef PI
+#define PI 3.14159265358979
+#endif
+
+template <class T, class L> auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template <class T, class L> auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+#define constrain(x, low, high) ((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+extern volatile uint8_t hostPorts[8];
+inline uint8_t digitalPinToPort(uint8_t pin) { return pin / 8; }
+inline uint8_t digitalPinToBitMask(uint8_t pin) { return 1 << (pin % 8); }
+#define portInputRegister(port) (&hostPorts[port])
+inline uint8_t digitalPinToInterrupt(uint8_t pin) { return pin; }
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode);
+
+void randomSeed(unsigned long seed);
+long random(long high);
+long random(long low, long high);
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* data, size_t length);
+  virtual int availableForWrite() { return 64; }
+  size_t write(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+  
+  size_t print(const char* text) { return write(text); }
+  size_t print(const __FlashStringHelper* text) { return write((const char*)text); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int value, int base = DEC) { return print((long)value, base); }
+  size_t print(unsigned value, int base = DEC) { return print((unsigned long)value, base); }
+  size_t print(long value, int base = DEC);
+  size_t print(unsigned long value, int base = DEC);
+  size_t print(double value, int digits = 2);
+  
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(T value) { return print(value) + println(); }
+  template <class T> size_t println(T value, int format) { return print(value, format) + println(); }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual void flush() {}
+};
+
+// Bytes written are kept in output; input is what the test queued
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int peek() override;
+  operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
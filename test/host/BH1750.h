@@ -0,0 +1,38 @@
+#ifndef HOST_BH1750_H
+#define HOST_BH1750_H
+
+#include <Wire.h>
+
+// Host stand-in for the BH1750 library, talking to the HostBh1750 model
+
+#define BH1750_DEFAULT_MTREG 69
+#define BH1750_MTREG_MIN 31
+#define BH1750_MTREG_MAX 254
+
+class BH1750 {
+public:
+  enum Mode {
+    UNCONFIGURED = 0,
+    CONTINUOUS_HIGH_RES_MODE = 0x10,
+    CONTINUOUS_HIGH_RES_MODE_2 = 0x11,
+    CONTINUOUS_LOW_RES_MODE = 0x13,
+    ONE_TIME_HIGH_RES_MODE = 0x20,
+    ONE_TIME_HIGH_RES_MODE_2 = 0x21,
+    ONE_TIME_LOW_RES_MODE = 0x23
+  };
+  
+  BH1750(uint8_t address = 0x23) : address(address) {}
+  bool begin(Mode mode = CONTINUOUS_HIGH_RES_MODE, uint8_t address = 0x23, TwoWire* wire = NULL);
+  bool configure(Mode mode);
+  bool setMTreg(uint8_t mtreg);
+  bool measurementReady(bool maxWait = false);
+  float readLightLevel();  // -1 no data, -2 not configured
+
+private:
+  uint8_t address;
+  Mode mode = UNCONFIGURED;
+  uint8_t mtreg = BH1750_DEFAULT_MTREG;
+  unsigned long lastConfigured = 0;
+};
+
+#endif
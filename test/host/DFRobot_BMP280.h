@@ -0,0 +1,43 @@
+#ifndef HOST_DFROBOT_BMP280_H
+#define HOST_DFROBOT_BMP280_H
+
+#include <Wire.h>
+
+// Host stand-in for DFRobot_BMP280. The HostBmp280 model reports pressure
+// in Pa directly in 0xF7-0xF9, so there is no compensation step.
+
+class DFRobot_BMP280 {
+public:
+  typedef enum { eStatusOK, eStatusErr, eStatusErrDeviceNotDetected, eStatusErrParameter } eStatus_t;
+  typedef enum { eSampling_no, eSampling_X1, eSampling_X2, eSampling_X4, eSampling_X8, eSampling_X16 } eSampling_t;
+  typedef enum { eConfigFilter_off, eConfigFilter_X2, eConfigFilter_X4, eConfigFilter_X8, eConfigFilter_X16 } eConfigFilter_t;
+  typedef enum { eConfigTStandby_0_5, eConfigTStandby_62_5, eConfigTStandby_125, eConfigTStandby_250,
+                 eConfigTStandby_500, eConfigTStandby_1000, eConfigTStandby_2000, eConfigTStandby_4000 } eConfigTStandby_t;
+  typedef enum { eCtrlMeasModeSleep, eCtrlMeasModeForced, eCtrlMeasModeNormal = 0x03 } eCtrlMeasMode_t;
+  
+  eStatus_t lastOperateStatus = eStatusOK;
+  
+  eStatus_t begin();
+  void reset();
+  uint32_t getPressure();
+  void setCtrlMeasMode(eCtrlMeasMode_t mode) { writeRegister(0xF4, mode); }
+  void setCtrlMeasSamplingTemp(eSampling_t) {}
+  void setCtrlMeasSamplingPress(eSampling_t) {}
+  void setConfigFilter(eConfigFilter_t) {}
+  void setConfigTStandby(eConfigTStandby_t) {}
+
+protected:
+  TwoWire* wire = &Wire;
+  uint8_t address = 0x76;
+  
+  bool writeRegister(uint8_t reg, uint8_t value);
+  bool readRegisters(uint8_t reg, uint8_t* data, uint8_t length);
+};
+
+class DFRobot_BMP280_IIC : public DFRobot_BMP280 {
+public:
+  typedef enum { eSdoLow, eSdoHigh } eSdo_t;
+  DFRobot_BMP280_IIC(TwoWire* bus, eSdo_t sdo) { wire = bus; address = sdo == eSdoLow ? 0x76 : 0x77; }
+};
+
+#endif
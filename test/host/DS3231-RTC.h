@@ -0,0 +1,55 @@
+#ifndef HOST_DS3231_RTC_H
+#define HOST_DS3231_RTC_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// Host stand-in for the DS3231-RTC library: the calls the firmware makes,
+// talking to the HostDs3231 model (HostSensors.h) over the host bus
+
+class DateTime {
+public:
+  DateTime(uint16_t year = 2000, uint8_t month = 1, uint8_t day = 1, uint8_t hour = 0, uint8_t minute = 0, uint8_t second = 0)
+    : yOff(year - 2000), m(month), d(day), hh(hour), mm(minute), ss(second) {}
+  
+  uint16_t getYear() const { return 2000 + yOff; }
+  uint8_t getMonth() const { return m; }
+  uint8_t getDay() const { return d; }
+  uint8_t getHour() const { return hh; }
+  uint8_t getMinute() const { return mm; }
+  uint8_t getSecond() const { return ss; }
+
+private:
+  uint8_t yOff, m, d, hh, mm, ss;
+};
+
+class DS3231 {
+public:
+  DS3231(TwoWire& wire = Wire) : wire(wire) {}
+  
+  uint8_t getYear() { return readBcd(6); }
+  uint8_t getMonth(bool& century) { uint8_t raw = readRaw(5); century = raw & 0x80; return bcdToBin(raw & 0x1F); }
+  uint8_t getDate() { return readBcd(4); }
+  uint8_t getHour(bool& h12, bool& pm) { h12 = false; pm = false; return readBcd(2); }
+  uint8_t getMinute() { return readBcd(1); }
+  uint8_t getSecond() { return readBcd(0); }
+  
+  void setYear(uint8_t year) { writeBcd(6, year); }
+  void setMonth(uint8_t month) { writeBcd(5, month); }
+  void setDate(uint8_t date) { writeBcd(4, date); }
+  void setHour(uint8_t hour) { writeBcd(2, hour); }
+  void setMinute(uint8_t minute) { writeBcd(1, minute); }
+  void setSecond(uint8_t second) { writeBcd(0, second); }
+  void setClockMode(bool) {}
+  bool oscillatorCheck() { return (readRaw(0x0F) & 0x80) == 0; }
+
+private:
+  TwoWire& wire;
+  
+  static uint8_t bcdToBin(uint8_t value) { return value - 6 * (value >> 4); }
+  uint8_t readBcd(uint8_t reg) { return bcdToBin(readRaw(reg)); }
+  uint8_t readRaw(uint8_t reg);  // 0xFF when the chip does not answer, as the library
+  void writeBcd(uint8_t reg, uint8_t value);
+};
+
+#endif
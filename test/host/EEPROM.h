@@ -0,0 +1,39 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+// The ATmega4809's 256 bytes of EEPROM. As on the chip they are also mapped
+// into data space (MAPPED_EEPROM_START), unless HOST_UNMAPPED is defined to
+// build the copy-out code path instead. HostTest.h can cut the power after
+// a number of byte writes.
+#define EEPROM_SIZE 256
+#define E2END (EEPROM_SIZE - 1)
+
+extern uint8_t hostEeprom[EEPROM_SIZE];
+
+#ifndef HOST_UNMAPPED
+#define MAPPED_EEPROM_START ((uintptr_t)hostEeprom)
+#endif
+
+struct EEPROMClass {
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  void update(int address, uint8_t value);
+  uint16_t length() { return EEPROM_SIZE; }
+  
+  template <class T> T& get(int address, T& value) {
+    uint8_t* bytes = (uint8_t*)&value;
+    for (size_t i = 0; i < sizeof(T); i++) bytes[i] = read(address + i);
+    return value;
+  }
+  template <class T> const T& put(int address, const T& value) {
+    const uint8_t* bytes = (const uint8_t*)&value;
+    for (size_t i = 0; i < sizeof(T); i++) update(address + i, bytes[i]);
+    return value;
+  }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
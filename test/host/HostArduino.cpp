@@ -0,0 +1,127 @@
+#include "HostTest.h"
+#include "HostBus.h"
+#include <deque>
+#include <random>
+
+// ---- Time ----
+
+static uint64_t nowMicros;
+
+void hostAdvanceMicros(uint64_t micros) { nowMicros += micros; }
+uint64_t hostMicros() { return nowMicros; }
+
+unsigned long millis() { return (unsigned long)(nowMicros / 1000); }
+unsigned long micros() { return (unsigned long)nowMicros; }
+void delay(unsigned long ms) { nowMicros += (uint64_t)ms * 1000; }
+void delayMicroseconds(unsigned int us) { nowMicros += us; }
+
+// ---- Pins (I2C lines for bus recovery, the rest idle) ----
+
+volatile uint8_t hostPorts[8];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin == SCL && mode == OUTPUT) hostBusSclPulse();
+}
+
+int digitalRead(uint8_t pin) {
+  if (pin == SDA) return hostBusSdaLow() ? LOW : HIGH;
+  return HIGH;
+}
+
+void digitalWrite(uint8_t, uint8_t) {}
+int analogRead(uint8_t) { return 0; }
+void attachInterrupt(uint8_t, void (*)(), int) {}
+
+static std::mt19937 randomSource;
+void randomSeed(unsigned long seed) { randomSource.seed(seed); }
+long random(long high) { return high > 0 ? (long)(randomSource() % high) : 0; }
+long random(long low, long high) { return low + random(high - low); }
+
+// ---- EEPROM ----
+
+uint8_t hostEeprom[EEPROM_SIZE];
+EEPROMClass EEPROM;
+static long eepromBudget = -1;
+static uint32_t eepromWrites;
+
+void hostEepromErase() { memset(hostEeprom, 0xFF, sizeof(hostEeprom)); }
+void hostEepromSetBudget(long writes) { eepromBudget = writes; }
+uint32_t hostEepromWrites() { return eepromWrites; }
+
+uint8_t EEPROMClass::read(int address) { return hostEeprom[address]; }
+void EEPROMClass::write(int address, uint8_t value) { update(address, value); }
+
+void EEPROMClass::update(int address, uint8_t value) {
+  if (hostEeprom[address] == value) return;
+  if (eepromBudget == 0) return;  // Power is off
+  if (eepromBudget > 0) eepromBudget--;
+  hostEeprom[address] = value;
+  eepromWrites++;
+}
+
+// ---- Serial ----
+
+HardwareSerial Serial;
+static std::string serialOutput;
+static std::deque<uint8_t> serialInput;
+static void (*serialHandler)(uint8_t c);
+
+std::string& hostSerialOutput() { return serialOutput; }
+void hostSerialInput(const uint8_t* data, size_t length) { serialInput.insert(serialInput.end(), data, data + length); }
+void hostSerialOnWrite(void (*handler)(uint8_t c)) { serialHandler = handler; }
+
+size_t HardwareSerial::write(uint8_t c) {
+  serialOutput.push_back((char)c);
+  if (serialHandler != NULL) serialHandler(c);
+  return 1;
+}
+
+int HardwareSerial::available() { return serialInput.size(); }
+int HardwareSerial::peek() { return serialInput.empty() ? -1 : serialInput.front(); }
+
+int HardwareSerial::read() {
+  if (serialInput.empty()) return -1;
+  uint8_t c = serialInput.front();
+  serialInput.pop_front();
+  return c;
+}
+
+// ---- Print ----
+
+size_t Print::write(const uint8_t* data, size_t length) {
+  size_t written = 0;
+  while (written < length && write(data[written])) written++;
+  return written;
+}
+
+size_t Print::print(long value, int base) {
+  if (value < 0 && base == DEC) return print('-') + print((unsigned long)-value, base);
+  return print((unsigned long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+  char text[34];
+  char* p = text + sizeof(text) - 1;
+  *p = '\0';
+  do {
+    uint8_t digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    value /= base;
+  } while (value > 0);
+  return write(p);
+}
+
+size_t Print::print(double value, int digits) {
+  char text[40];
+  snprintf(text, sizeof(text), "%.*f", digits, value);
+  return write(text);
+}
+
+// ---- Checks ----
+
+int hostCheckFailures = 0;
+
+int hostTestSummary() {
+  printf("%d failure%s\n", hostCheckFailures, hostCheckFailures == 1 ? "" : "s");
+  return hostCheckFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+#ifndef HOST_AT24C32_H
+#define HOST_AT24C32_H
+
+#include "HostBus.h"
+#include "HostTest.h"
+
+// AT24C32 on the DS3231 breakout: 4 KB, 12-bit address, 32-byte pages.
+// Like the chip, a write that runs past the end of its page wraps to the
+// page start, and the address is NACKed for tWR (5 ms) after each write.
+#define HOST_AT24C32_SIZE 4096
+#define HOST_AT24C32_PAGE 32
+#define HOST_AT24C32_WRITE_MICROS 5000
+
+class HostAt24c32 : public HostI2CDevice {
+public:
+  HostAt24c32() : HostI2CDevice(0x57) { memset(memory, 0xFF, sizeof(memory)); }
+  
+  uint8_t memory[HOST_AT24C32_SIZE];
+  uint16_t pointer = 0;
+  uint64_t busyUntil = 0;
+  uint32_t pageWrites = 0;    // Write cycles started
+  uint32_t wrapped = 0;       // Writes that wrapped inside a page (driver bug)
+  uint32_t busyNacks = 0;     // Address NACKs during tWR, i.e. ACK polls
+  
+  bool busy() override {
+    if (hostMicros() >= busyUntil) return false;
+    busyNacks++;
+    return true;
+  }
+  
+  bool receive(const uint8_t* data, size_t length) override {
+    if (length >= 2) pointer = ((data[0] << 8) | data[1]) & (HOST_AT24C32_SIZE - 1);
+    if (length <= 2) return true;
+    uint16_t page = pointer & ~(HOST_AT24C32_PAGE - 1);
+    uint8_t column = pointer & (HOST_AT24C32_PAGE - 1);
+    if (column + length - 2 > HOST_AT24C32_PAGE) wrapped++;
+    for (size_t i = 2; i < length; i++) {
+      memory[page + column] = data[i];
+      column = (column + 1) & (HOST_AT24C32_PAGE - 1);
+    }
+    pageWrites++;
+    busyUntil = hostMicros() + HOST_AT24C32_WRITE_MICROS;
+    return true;
+  }
+  
+  // Sequential read, wrapping at the end of the array
+  void send(uint8_t* data, size_t length) override {
+    for (size_t i = 0; i < length; i++) {
+      data[i] = memory[pointer];
+      pointer = (pointer + 1) & (HOST_AT24C32_SIZE - 1);
+    }
+  }
+};
+
+#endif
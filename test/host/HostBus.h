@@ -0,0 +1,50 @@
+#ifndef HOST_BUS_H
+#define HOST_BUS_H
+
+#include <Wire.h>
+
+// ============================================================================
+// HOST I2C BUS
+// ============================================================================
+// Device models attach at their address and see each Wire transaction as a
+// whole: the bytes of a write, or a read of n bytes. Faults are injected
+// here, outside the firmware:
+// - present = false: the address NACKs, as an unplugged module
+// - failNext(n): the next n transactions NACK, as a glitch or a brown-out
+// - hostBusHoldSda(n): a slave holds SDA low until n SCL pulses are clocked
+// - hostBusTimeout(): the next transaction stalls and trips the TWI timeout
+// ============================================================================
+
+class HostI2CDevice {
+public:
+  explicit HostI2CDevice(uint8_t address);
+  virtual ~HostI2CDevice();
+  
+  uint8_t address;
+  bool present;
+  uint16_t failures;         // Transactions still to fail
+  uint32_t transactions;     // Attempted, including failed ones
+  
+  void failNext(uint16_t count) { failures = count; }
+  bool answers();            // Counts the transaction; false to NACK it
+  
+  // True while the device NACKs its own address, e.g. an EEPROM write cycle
+  virtual bool busy() { return false; }
+  
+  // Master wrote length bytes (register pointer first, if any). Return
+  // false to NACK, e.g. while busy.
+  virtual bool receive(const uint8_t* data, size_t length) { (void)data; (void)length; return true; }
+  // Master reads length bytes
+  virtual void send(uint8_t* data, size_t length) { memset(data, 0xFF, length); }
+};
+
+HostI2CDevice* hostBusDevice(uint8_t address);  // NULL if nothing is attached there
+void hostBusHoldSda(uint8_t clocks);
+void hostBusTimeout();
+uint16_t hostBusWireRestarts();  // Wire.begin() calls, i.e. recoveries and boots
+
+// Line level as seen by digitalRead(SDA); pinMode(SCL, OUTPUT) pulses SCL
+bool hostBusSdaLow();
+void hostBusSclPulse();
+
+#endif
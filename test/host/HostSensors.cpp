@@ -0,0 +1,198 @@
+#include "HostSensors.h"
+#include <DS3231-RTC.h>
+#include <Adafruit_AHTX0.h>
+#include <DFRobot_BMP280.h>
+
+static uint8_t toBcd(uint8_t value) { return ((value / 10) << 4) | (value % 10); }
+
+// ---- DS3231 ----
+
+void HostDs3231::setTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
+  registers[0] = toBcd(second);
+  registers[1] = toBcd(minute);
+  registers[2] = toBcd(hour);
+  registers[4] = toBcd(day);
+  registers[5] = toBcd(month);
+  registers[6] = toBcd(year % 100);
+}
+
+bool HostDs3231::receive(const uint8_t* data, size_t length) {
+  if (length == 0) return true;
+  pointer = data[0];
+  for (size_t i = 1; i < length && pointer < sizeof(registers); i++) {
+    registers[pointer++] = data[i];
+  }
+  return true;
+}
+
+void HostDs3231::send(uint8_t* data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    data[i] = pointer < sizeof(registers) ? registers[pointer++] : 0xFF;
+  }
+}
+
+uint8_t DS3231::readRaw(uint8_t reg) {
+  wire.beginTransmission(0x68);
+  wire.write(reg);
+  if (wire.endTransmission() != 0 || wire.requestFrom((uint8_t)0x68, (uint8_t)1) != 1) {
+    return 0xFF;
+  }
+  return wire.read();
+}
+
+void DS3231::writeBcd(uint8_t reg, uint8_t value) {
+  wire.beginTransmission(0x68);
+  wire.write(reg);
+  wire.write(((value / 10) << 4) | (value % 10));
+  wire.endTransmission();
+}
+
+// ---- AHT21 ----
+
+bool HostAht21::receive(const uint8_t* data, size_t length) {
+  if (length > 0 && data[0] == 0xAC) {
+    busyUntil = millis() + 80;
+  }
+  return true;
+}
+
+void HostAht21::send(uint8_t* data, size_t length) {
+  uint32_t rawHumidity = (uint32_t)(humidity / 100.0f * 1048576.0f);
+  uint32_t rawTemperature = (uint32_t)((temperature + 50.0f) / 200.0f * 1048576.0f);
+  uint8_t frame[6] = {
+    (uint8_t)(0x08 | ((long)(millis() - busyUntil) < 0 ? 0x80 : 0)),  // Calibrated, busy
+    (uint8_t)(rawHumidity >> 12), (uint8_t)(rawHumidity >> 4),
+    (uint8_t)((rawHumidity << 4) | (rawTemperature >> 16)),
+    (uint8_t)(rawTemperature >> 8), (uint8_t)rawTemperature
+  };
+  for (size_t i = 0; i < length; i++) data[i] = i < sizeof(frame) ? frame[i] : 0xFF;
+}
+
+bool Adafruit_AHTX0::begin(TwoWire* bus, int32_t, uint8_t deviceAddress) {
+  wire = bus;
+  address = deviceAddress;
+  wire->beginTransmission(address);
+  wire->write(0xBA);  // Soft reset
+  if (wire->endTransmission() != 0) return false;
+  delay(20);
+  return (getStatus() & 0x08) != 0;  // Calibrated
+}
+
+uint8_t Adafruit_AHTX0::getStatus() {
+  if (wire->requestFrom(address, (uint8_t)1) != 1) return 0xFF;
+  return wire->read();
+}
+
+// ---- BMP280 ----
+
+bool HostBmp280::receive(const uint8_t* data, size_t length) {
+  if (length == 0) return true;
+  pointer = data[0];
+  if (pointer == 0xF4 && length > 1 && (data[1] & 0x03) == 0x01) {
+    measuringUntil = millis() + conversionMs;
+  }
+  return true;
+}
+
+void HostBmp280::send(uint8_t* data, size_t length) {
+  uint32_t pascals = (uint32_t)(pressure * 100.0f + 0.5f);
+  for (size_t i = 0; i < length; i++, pointer++) {
+    switch (pointer) {
+      case 0xD0: data[i] = 0x58; break;  // Chip ID
+      case 0xF3: data[i] = (long)(millis() - measuringUntil) < 0 ? 0x08 : 0x00; break;
+      case 0xF7: data[i] = pascals >> 16; break;
+      case 0xF8: data[i] = pascals >> 8; break;
+      case 0xF9: data[i] = pascals; break;
+      default:   data[i] = 0x00; break;
+    }
+  }
+}
+
+bool DFRobot_BMP280::writeRegister(uint8_t reg, uint8_t value) {
+  wire->beginTransmission(address);
+  wire->write(reg);
+  wire->write(value);
+  return wire->endTransmission() == 0;
+}
+
+bool DFRobot_BMP280::readRegisters(uint8_t reg, uint8_t* data, uint8_t length) {
+  wire->beginTransmission(address);
+  wire->write(reg);
+  if (wire->endTransmission() != 0 || wire->requestFrom(address, length) != length) {
+    lastOperateStatus = eStatusErr;
+    return false;
+  }
+  for (uint8_t i = 0; i < length; i++) data[i] = wire->read();
+  lastOperateStatus = eStatusOK;
+  return true;
+}
+
+DFRobot_BMP280::eStatus_t DFRobot_BMP280::begin() {
+  uint8_t id;
+  if (!readRegisters(0xD0, &id, 1) || id != 0x58) {
+    lastOperateStatus = eStatusErrDeviceNotDetected;
+  }
+  return lastOperateStatus;
+}
+
+void DFRobot_BMP280::reset() { writeRegister(0xE0, 0xB6); }
+
+uint32_t DFRobot_BMP280::getPressure() {
+  uint8_t data[3];
+  if (!readRegisters(0xF7, data, 3)) return 0;
+  return ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8) | data[2];
+}
+
+// ---- BH1750 ----
+
+bool HostBh1750::receive(const uint8_t* data, size_t length) {
+  if (length == 1 && (data[0] & 0xF8) == 0x40) {
+    mtreg = (mtreg & 0x1F) | ((data[0] & 0x07) << 5);
+  } else if (length == 1 && (data[0] & 0xE0) == 0x60) {
+    mtreg = (mtreg & 0xE0) | (data[0] & 0x1F);
+  }
+  return true;
+}
+
+void HostBh1750::send(uint8_t* data, size_t length) {
+  uint32_t counts = (uint32_t)(lux * 1.2f * mtreg / BH1750_DEFAULT_MTREG);
+  if (counts > 0xFFFF) counts = 0xFFFF;
+  if (length > 0) data[0] = counts >> 8;
+  if (length > 1) data[1] = counts;
+}
+
+static bool sendCommand(uint8_t address, uint8_t command) {
+  Wire.beginTransmission(address);
+  Wire.write(command);
+  return Wire.endTransmission() == 0;
+}
+
+bool BH1750::begin(Mode startMode, uint8_t deviceAddress, TwoWire*) {
+  address = deviceAddress;
+  return configure(startMode);
+}
+
+bool BH1750::configure(Mode newMode) {
+  if (!sendCommand(address, newMode)) return false;
+  mode = newMode;
+  lastConfigured = millis();
+  return true;
+}
+
+bool BH1750::setMTreg(uint8_t value) {
+  if (!sendCommand(address, 0x40 | (value >> 5)) || !sendCommand(address, 0x60 | (value & 0x1F))) return false;
+  mtreg = value;
+  return sendCommand(address, mode);
+}
+
+bool BH1750::measurementReady(bool) {
+  unsigned long wait = (mode == CONTINUOUS_LOW_RES_MODE || mode == ONE_TIME_LOW_RES_MODE) ? 24 : 180;
+  return millis() - lastConfigured >= wait * mtreg / BH1750_DEFAULT_MTREG;
+}
+
+float BH1750::readLightLevel() {
+  if (mode == UNCONFIGURED) return -2;
+  if (Wire.requestFrom(address, (uint8_t)2) != 2) return -1;
+  uint16_t counts = (Wire.read() << 8) | Wire.read();
+  return counts / 1.2f * BH1750_DEFAULT_MTREG / mtreg;
+}
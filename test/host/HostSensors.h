@@ -0,0 +1,67 @@
+#ifndef HOST_SENSORS_H
+#define HOST_SENSORS_H
+
+#include "HostBus.h"
+#include <BH1750.h>
+
+// ============================================================================
+// HOST SENSOR MODELS
+// ============================================================================
+// Register-level stand-ins for the clock's I2C devices. A test sets the
+// readings directly and uses the HostI2CDevice controls (present,
+// failNext) to inject faults.
+// ============================================================================
+
+class HostDs3231 : public HostI2CDevice {
+public:
+  HostDs3231() : HostI2CDevice(0x68) { memset(registers, 0, sizeof(registers)); }
+  
+  uint8_t registers[0x13];  // BCD time at 0-6
+  uint8_t pointer = 0;
+  
+  void setTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second);
+  bool receive(const uint8_t* data, size_t length) override;
+  void send(uint8_t* data, size_t length) override;
+};
+
+// AHT21: 0xAC 0x33 0x00 starts a conversion that stays busy for 80 ms
+class HostAht21 : public HostI2CDevice {
+public:
+  HostAht21() : HostI2CDevice(0x38) {}
+  
+  float temperature = 20;  // Celsius
+  float humidity = 50;     // %
+  unsigned long busyUntil = 0;
+  
+  bool receive(const uint8_t* data, size_t length) override;
+  void send(uint8_t* data, size_t length) override;
+};
+
+// BMP280: chip ID 0x58; a forced-mode write to 0xF4 sets "measuring" in
+// 0xF3 for conversionMs; 0xF7-0xF9 hold the pressure in Pa
+class HostBmp280 : public HostI2CDevice {
+public:
+  HostBmp280() : HostI2CDevice(0x76) {}
+  
+  float pressure = 1013.25;  // hPa
+  unsigned long conversionMs = 10;
+  unsigned long measuringUntil = 0;
+  uint8_t pointer = 0;
+  
+  bool receive(const uint8_t* data, size_t length) override;
+  void send(uint8_t* data, size_t length) override;
+};
+
+// BH1750: reports lux * 1.2 at the default MTreg
+class HostBh1750 : public HostI2CDevice {
+public:
+  HostBh1750() : HostI2CDevice(0x23) {}
+  
+  float lux = 100;
+  uint8_t mtreg = BH1750_DEFAULT_MTREG;
+  
+  bool receive(const uint8_t* data, size_t length) override;
+  void send(uint8_t* data, size_t length) override;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <string>
+
+// ============================================================================
+// HOST TEST SUPPORT
+// ============================================================================
+// Shared by the test/*.cpp programs: virtual time, the serial line, the
+// internal EEPROM with a power-cut switch, and a CHECK() that counts
+// failures. Each test prints one line per check and exits non-zero if any
+// failed.
+// ============================================================================
+
+// Virtual clock, in microseconds since boot; delay() advances it too
+void hostAdvanceMicros(uint64_t micros);
+inline void hostAdvanceMillis(uint64_t millis) { hostAdvanceMicros(millis * 1000); }
+uint64_t hostMicros();
+
+// Internal EEPROM. With a budget set, that many more bytes are written and
+// every later write is lost, as if the power failed there.
+void hostEepromErase();  // All 0xFF, as shipped
+void hostEepromSetBudget(long writes);  // -1 = unlimited
+uint32_t hostEepromWrites();  // Bytes actually changed since start
+
+// Serial: bytes the firmware sent, and bytes for it to read
+std::string& hostSerialOutput();
+void hostSerialInput(const uint8_t* data, size_t length);
+
+// Called on each Serial write, e.g. to answer a request as a host tool would
+void hostSerialOnWrite(void (*handler)(uint8_t c));
+
+extern int hostCheckFailures;
+
+#define CHECK(condition, description) do { \
+    bool ok_ = (condition); \
+    printf("%s  %s\n", ok_ ? "pass" : "FAIL", description); \
+    if (!ok_) hostCheckFailures++; \
+  } while (0)
+
+// Prints the total and returns main()'s exit status
+int hostTestSummary();
+
+#endif
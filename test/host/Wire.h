@@ -0,0 +1,38 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+// Host Wire: transactions go to the HostI2CDevice models on the bus
+// (HostBus.h), which can be removed or made to fail for a while
+#define BUFFER_LENGTH 128
+#define WIRE_HAS_TIMEOUT
+
+class TwoWire : public Stream {
+public:
+  void begin();
+  void end();
+  void setClock(uint32_t) {}
+  void setWireTimeout(uint32_t timeoutMicros, bool resetOnTimeout);
+  bool getWireTimeoutFlag();
+  void clearWireTimeoutFlag();
+  
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+  
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* data, size_t length) override;
+  using Print::write;
+  size_t write(int n) { return write((uint8_t)n); }
+  size_t write(unsigned int n) { return write((uint8_t)n); }
+  size_t write(long n) { return write((uint8_t)n); }
+  size_t write(unsigned long n) { return write((uint8_t)n); }
+  int available() override;
+  int read() override;
+  int peek() override;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,146 @@
+// ChannelAccumulator (Welford mean and variance, Chan merge) replayed
+// against a two-pass computation in double precision, for each channel's
+// range of values and for the hourly -> daily -> weekly roll-up.
+//
+//   g++ -std=gnu++17 -Itest/host -Iinclude -Ilib/HybridClock test/test_accumulator.cpp test/host/*.cpp -o test_accumulator
+//   ./test_accumulator
+
+#include "HostTest.h"
+#include "DataLogger.h"
+#include <random>
+#include <vector>
+
+struct TwoPass {
+  double mean;
+  double sd;
+  double minValue;
+  double maxValue;
+};
+
+// Over the float values the accumulator actually saw
+static TwoPass twoPass(const std::vector<float>& samples) {
+  TwoPass result = {0, 0, samples[0], samples[0]};
+  for (float x : samples) {
+    result.mean += x;
+    result.minValue = std::min<double>(result.minValue, x);
+    result.maxValue = std::max<double>(result.maxValue, x);
+  }
+  result.mean /= samples.size();
+  double squares = 0;
+  for (float x : samples) squares += (x - result.mean) * (x - result.mean);
+  result.sd = samples.size() > 1 ? sqrt(squares / (samples.size() - 1)) : 0;
+  return result;
+}
+
+struct Worst {
+  double mean = 0;
+  double sd = 0;
+  bool minMax = true;
+  
+  void update(const ChannelAccumulator& acc, const TwoPass& exact) {
+    mean = std::max(mean, fabs(acc.mean - exact.mean));
+    sd = std::max(sd, fabs(sqrt(acc.getVariance()) - exact.sd));
+    minMax = minMax && acc.minValue == exact.minValue && acc.maxValue == exact.maxValue;
+  }
+};
+
+// One channel: a level, a slow drift over the hour and sensor noise
+struct ChannelModel {
+  const char* name;
+  double low, high;    // Range of hourly levels
+  double drift;        // Change over one hour
+  double noise;        // Per-sample standard deviation
+  double meanLimit;    // Allowed error, in the channel's units
+  double sdLimit;
+};
+
+static const ChannelModel channels[] = {
+  {"pressure hPa",     960, 1050,  1.5,   0.05, 0.003, 0.002},
+  {"temperature F",    -10,  105,  4.0,   0.1,  0.001, 0.001},
+  {"humidity %",         5,   95,  6.0,   0.3,  0.001, 0.001},
+  {"light lux",          0, 30000, 800,  40,    0.05,  0.05}
+};
+
+#define SAMPLES_PER_HOUR 120  // One every 30 s
+
+int main() {
+  std::mt19937 random(31);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::normal_distribution<double> normal(0, 1);
+  
+  for (const ChannelModel& channel : channels) {
+    Worst hourly, daily, weekly;
+    bool mergeMatchesAdd = true;
+    
+    for (int week = 0; week < 10; week++) {
+      ChannelAccumulator weekAcc;
+      weekAcc.reset();
+      std::vector<float> weekSamples;
+      
+      for (int day = 0; day < 7; day++) {
+        ChannelAccumulator dayAcc, dayAdded;
+        dayAcc.reset();
+        dayAdded.reset();
+        std::vector<float> daySamples;
+        
+        for (int hour = 0; hour < 24; hour++) {
+          ChannelAccumulator hourAcc;
+          hourAcc.reset();
+          std::vector<float> samples;
+          double level = channel.low + (channel.high - channel.low) * uniform(random);
+          for (int i = 0; i < SAMPLES_PER_HOUR; i++) {
+            float x = level + channel.drift * i / SAMPLES_PER_HOUR + channel.noise * normal(random);
+            if (x < 0 && channel.low >= 0) x = 0;  // Lux never goes negative
+            samples.push_back(x);
+            hourAcc.add(x);
+            dayAdded.add(x);
+          }
+          hourly.update(hourAcc, twoPass(samples));
+          dayAcc.merge(hourAcc);
+          daySamples.insert(daySamples.end(), samples.begin(), samples.end());
+        }
+        
+        TwoPass exact = twoPass(daySamples);
+        daily.update(dayAcc, exact);
+        mergeMatchesAdd = mergeMatchesAdd && fabs(dayAcc.mean - dayAdded.mean) <= channel.meanLimit &&
+                          fabs(sqrt(dayAcc.getVariance()) - sqrt(dayAdded.getVariance())) <= channel.sdLimit;
+        weekAcc.merge(dayAcc);
+        weekSamples.insert(weekSamples.end(), daySamples.begin(), daySamples.end());
+      }
+      weekly.update(weekAcc, twoPass(weekSamples));
+    }
+    
+    printf("      %-14s worst |mean err| hour %.5f day %.5f week %.5f, |sd err| hour %.5f day %.5f week %.5f\n",
+           channel.name, hourly.mean, daily.mean, weekly.mean, hourly.sd, daily.sd, weekly.sd);
+    char description[100];
+    snprintf(description, sizeof(description), "%s: hourly mean and sd match two-pass", channel.name);
+    CHECK(hourly.mean <= channel.meanLimit && hourly.sd <= channel.sdLimit && hourly.minMax, description);
+    snprintf(description, sizeof(description), "%s: 24 merged hours match two-pass over the day", channel.name);
+    CHECK(daily.mean <= channel.meanLimit && daily.sd <= channel.sdLimit && daily.minMax, description);
+    snprintf(description, sizeof(description), "%s: 7 merged days match two-pass over the week", channel.name);
+    CHECK(weekly.mean <= channel.meanLimit && weekly.sd <= channel.sdLimit && weekly.minMax, description);
+    snprintf(description, sizeof(description), "%s: merging hours agrees with adding every sample", channel.name);
+    CHECK(mergeMatchesAdd, description);
+  }
+  
+  // Edge cases of merge
+  ChannelAccumulator a, b;
+  a.reset();
+  b.reset();
+  a.merge(b);
+  CHECK(a.count == 0, "empty into empty stays empty");
+  b.add(1000.5f);
+  b.add(1001.5f);
+  a.merge(b);
+  CHECK(a.count == 2 && a.mean == 1001.0f && a.minValue == 1000.5f && a.maxValue == 1001.5f, "merge into empty copies");
+  ChannelAccumulator empty;
+  empty.reset();
+  a.merge(empty);
+  CHECK(a.count == 2 && a.mean == 1001.0f && fabs(a.getVariance() - 0.5f) < 1e-6, "merging an empty one changes nothing");
+  ChannelAccumulator single;
+  single.reset();
+  single.add(42);
+  CHECK(single.getVariance() == 0 && single.getSum() == 42, "one sample: variance 0");
+  
+  return hostTestSummary();
+}
@@ -0,0 +1,108 @@
+// History across RTC changes: a power-off gap, a fast-forward of three
+// days, and a rewind of two hours (dropNewerThan), each checked again
+// after reloading from EEPROM.
+//
+//   g++ -std=gnu++17 -Itest/host -Iinclude -Ilib/HybridClock test/test_clock_jumps.cpp test/host/*.cpp src/DataLogger.cpp src/ExternalEeprom.cpp -o test_clock_jumps
+//   ./test_clock_jumps
+
+#include "HostTest.h"
+#include "DataLogger.h"
+
+static DataLogger logger;
+
+// Samples every 30 s for the given hours from 2026-01-<day> <hour>:00.
+// Pressure is p0 + slope * (hour index), so each hour is identifiable.
+static void feed(uint8_t day, uint8_t hour, uint8_t hours, float p0, float slope) {
+  for (uint8_t k = 0; k < hours; k++) {
+    uint8_t h = hour + k;
+    for (uint16_t second = 0; second < 3600; second += 30) {
+      SensorData data = {};
+      data.currentTime = DateTime(2026, 1, day + h / 24, h % 24, second / 60, second % 60);
+      data.temperatureF = 60;
+      data.humidity = 50;
+      data.pressure = p0 + slope * k;
+      data.lightLevel = 10;
+      data.validFlags = 0x0F;
+      hostAdvanceMillis(30000);
+      logger.update(data);
+    }
+  }
+}
+
+static bool at(uint8_t day, uint8_t hour, HistoryRecord& record) {
+  return logger.getRecordAt(TIER_HOURLY, DateTime(2026, 1, day, hour, 0, 0), record);
+}
+
+static HistoryRecord newest() { return logger.getRecord(TIER_HOURLY, 0); }
+
+// The internal EEPROM journal keeps the newest EEPROM_HOURLY_SLOTS hours
+// and EEPROM_DAILY_SLOTS days; those must read the same after a reload
+static const uint8_t journalSlots[HISTORY_TIER_COUNT] = {0, EEPROM_HOURLY_SLOTS, EEPROM_DAILY_SLOTS, 0};
+
+static bool reloadAgrees() {
+  HistoryRecord saved[HISTORY_TIER_COUNT][EEPROM_HOURLY_SLOTS];
+  for (uint8_t tier = TIER_HOURLY; tier <= TIER_DAILY; tier++) {
+    for (uint8_t ago = 0; ago < journalSlots[tier]; ago++) {
+      saved[tier][ago] = logger.getRecord((HistoryTier)tier, ago);
+    }
+  }
+  logger.init();
+  bool same = true;
+  for (uint8_t tier = TIER_HOURLY; tier <= TIER_DAILY; tier++) {
+    for (uint8_t ago = 0; ago < journalSlots[tier]; ago++) {
+      HistoryRecord a = saved[tier][ago];
+      HistoryRecord b = logger.getRecord((HistoryTier)tier, ago);
+      same = same && a.timestamp.getDay() == b.timestamp.getDay() && a.timestamp.getHour() == b.timestamp.getHour() &&
+             a.avgPressure == b.avgPressure && a.avgTemperature == b.avgTemperature;
+    }
+  }
+  return same;
+}
+
+int main() {
+  hostEepromErase();
+  logger.init();
+  HistoryRecord record;
+  
+  // 30 hours continuous, pressure 1000 + hour index
+  feed(1, 0, 30, 1000, 1);
+  CHECK(at(2, 4, record) && fabs(record.avgPressure - 1028) < 0.2, "O(1) lookup by timestamp finds 01-02 04:00");
+  CHECK(!at(2, 6, record), "the hour in progress is not a record");
+  
+  // Power off from 06:xx to 11:00; the reboot leaves the journal as it was
+  CHECK(reloadAgrees(), "a reboot after an outage restores the journal record for record");
+  CHECK(newest().timestamp.getHour() == 4, "after a reboot the newest is 04:00 (05:00 was still pending)");
+  feed(2, 11, 3, 1040, 0);
+  CHECK(newest().timestamp.getHour() == 12, "after resuming the newest is 12:00");
+  bool gap = true;
+  for (uint8_t hour = 5; hour <= 10; hour++) gap = gap && !at(2, hour, record);
+  CHECK(gap, "hours 05:00-10:00 read as missing");
+  CHECK(at(2, 4, record) && fabs(record.avgPressure - 1028) < 0.2, "04:00 still addressable across the gap");
+  CHECK(logger.calculateTrends().points == 2 && fabs(logger.calculateTrends().pressureTrend) < 0.05,
+        "trend uses only 11:00-12:00, no jump across the gap");
+  CHECK(fabs(logger.getAveragePressure(3) - 1040) < 0.05, "3 h average skips the missing hours");
+  
+  // RTC fast-forward three days: 01-05 12:00..14:00
+  feed(5, 12, 3, 990, 0);
+  CHECK(newest().timestamp.getDay() == 5 && newest().timestamp.getHour() == 13, "fast-forward: newest is 01-05 13:00");
+  CHECK(fabs(logger.getAveragePressure(24) - 990) < 0.05, "24 h average only sees hours after the jump");
+  CHECK(at(2, 12, record) && fabs(record.avgPressure - 1040) < 0.2, "01-02 12:00 from before the jump still addressable");
+  CHECK(logger.getDataAge() >= 72, "data age spans the jump");
+  CHECK(reloadAgrees(), "fast-forward: reload from EEPROM agrees record for record");
+  
+  // RTC set back two hours: 01-05 12:xx again
+  feed(5, 12, 2, 980, 0);
+  CHECK(newest().timestamp.getHour() == 12 && fabs(newest().avgPressure - 980) < 0.2, "after the rewind the newest is the rewritten 12:00");
+  CHECK(!at(5, 14, record), "the abandoned timeline's 14:00 is dropped");
+  CHECK(!at(5, 13, record) || fabs(record.avgPressure - 980) < 0.2, "no record from the abandoned timeline at 13:00");
+  CHECK(reloadAgrees(), "rewind: reload from EEPROM agrees record for record");
+  CHECK(newest().timestamp.getHour() == 12 && fabs(newest().avgPressure - 980) < 0.2, "the journal restores the rewritten 12:00 as newest");
+  feed(5, 13, 2, 980, 0);
+  CHECK(newest().timestamp.getHour() == 13, "logging resumes after the rewind");
+  
+  // The daily tier is gap-aware too
+  CHECK(logger.getRecordAt(TIER_DAILY, DateTime(2026, 1, 1, 0, 0, 0), record) &&
+        !logger.getRecordAt(TIER_DAILY, DateTime(2026, 1, 3, 0, 0, 0), record), "daily: 01-01 present, skipped 01-03 missing");
+  
+  return hostTestSummary();
+}
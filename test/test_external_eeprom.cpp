@@ -0,0 +1,151 @@
+// ExternalEeprom against the AT24C32 model: page splitting, ACK polling
+// through the write cycle, sequential reads, an absent chip, and the
+// logger keeping its history on the chip across a reboot and an outage.
+//
+//   g++ -std=gnu++17 -Itest/host -Iinclude -Ilib/HybridClock test/test_external_eeprom.cpp test/host/*.cpp src/ExternalEeprom.cpp src/DataLogger.cpp -o test_external_eeprom
+//   ./test_external_eeprom
+
+#include "HostTest.h"
+#include "HostAt24c32.h"
+#include "ExternalEeprom.h"
+#include "DataLogger.h"
+#include <algorithm>
+#include <random>
+
+static HostAt24c32 chip;
+
+static SensorData sample(uint32_t hour, uint8_t minute) {
+  SensorData data = {};
+  data.currentTime = DateTime(2026, 5, 1 + hour / 24, hour % 24, minute, 0);
+  data.temperatureF = 60 + hour % 24;
+  data.humidity = 50;
+  data.pressure = 1000 + hour * 0.1f;
+  data.lightLevel = 10;
+  data.validFlags = 0x0F;
+  return data;
+}
+
+// Hours 0-70 of the 72 logged, the last closed one included
+static bool restoredHours(DataLogger& logger) {
+  bool restored = true;
+  for (uint8_t hour = 0; hour < 71; hour++) {
+    HistoryRecord record;
+    restored = restored && logger.getRecordAt(TIER_HOURLY, DateTime(2026, 5, 1 + hour / 24, hour % 24, 0, 0), record) &&
+               fabs(record.avgPressure - (1000 + hour * 0.1f)) < 0.06;
+  }
+  return restored;
+}
+
+int main() {
+  Wire.begin();
+  ExternalEeprom eeprom;
+  CHECK(eeprom.begin(), "chip found at 0x57");
+  
+  // Random writes and reads of random length, most crossing pages
+  std::mt19937 random(42);
+  static uint8_t reference[HOST_AT24C32_SIZE];
+  memcpy(reference, chip.memory, sizeof(reference));
+  bool ok = true;
+  uint32_t expectedPages = 0;
+  uint32_t pagesBefore = chip.pageWrites;
+  for (uint16_t k = 0; k < 2000; k++) {
+    uint16_t addr = random() % HOST_AT24C32_SIZE;
+    uint16_t length = 1 + random() % 200;
+    if (addr + length > HOST_AT24C32_SIZE) length = HOST_AT24C32_SIZE - addr;
+    uint8_t buffer[256];
+    for (uint16_t i = 0; i < length; i++) buffer[i] = random();
+    
+    // One transaction per page touched, within the Wire buffer
+    for (uint16_t a = addr, left = length; left > 0; expectedPages++) {
+      uint16_t chunk = std::min<uint16_t>({(uint16_t)(HOST_AT24C32_PAGE - a % HOST_AT24C32_PAGE), (uint16_t)(BUFFER_LENGTH - 2), left});
+      a += chunk;
+      left -= chunk;
+    }
+    ok = ok && eeprom.write(addr, buffer, length);
+    memcpy(reference + addr, buffer, length);
+    if (random() % 3 == 0) hostAdvanceMillis(20);  // Sometimes idle past tWR
+    
+    uint16_t readAddr = random() % HOST_AT24C32_SIZE;
+    uint16_t readLength = 1 + random() % 255;
+    if (readAddr + readLength > HOST_AT24C32_SIZE) readLength = HOST_AT24C32_SIZE - readAddr;
+    uint8_t readBack[256];
+    ok = ok && eeprom.read(readAddr, readBack, readLength) && memcmp(readBack, reference + readAddr, readLength) == 0;
+  }
+  CHECK(ok && memcmp(chip.memory, reference, sizeof(reference)) == 0, "2000 random cross-page writes and reads match a reference image");
+  CHECK(chip.wrapped == 0, "no write wraps inside a page");
+  CHECK(chip.pageWrites - pagesBefore == expectedPages && eeprom.getPageWrites() == expectedPages, "one write transaction per page touched");
+  
+  // After idling, an 8-byte slot is one transaction with no poll
+  hostAdvanceMillis(100);
+  uint8_t slot[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  uint32_t transactions = chip.transactions;
+  uint32_t polls = chip.busyNacks;
+  eeprom.write(32 + 8 * 17, slot, 8);
+  CHECK(chip.transactions - transactions == 1 && chip.busyNacks == polls, "idle 8-byte slot write: one transaction, no poll");
+  
+  // Straight after it, the next write ACK-polls the write cycle out
+  unsigned long start = micros();
+  ok = eeprom.write(64, slot, 8);
+  unsigned long waited = micros() - start;
+  CHECK(ok && chip.busyNacks > polls && memcmp(chip.memory + 64, slot, 8) == 0, "back-to-back write ACK-polls through tWR");
+  // tWR plus the ~1 ms transfer of the second write itself
+  CHECK(waited >= HOST_AT24C32_WRITE_MICROS && waited < HOST_AT24C32_WRITE_MICROS + 1500, "polling ends as soon as the chip ACKs");
+  printf("      %u polls, %lu us waited for tWR\n", chip.busyNacks - polls, waited);
+  
+  // A read straight after a write polls too, then streams
+  eeprom.write(128, slot, 8);
+  uint8_t readBack[8];
+  CHECK(eeprom.read(128, readBack, 8) && memcmp(readBack, slot, 8) == 0, "read after write waits for the write cycle");
+  
+  // The whole chip in one sequential read
+  hostAdvanceMillis(100);
+  static uint8_t all[HOST_AT24C32_SIZE];
+  transactions = chip.transactions;
+  start = micros();
+  ok = eeprom.read(0, all, HOST_AT24C32_SIZE);
+  CHECK(ok && memcmp(all, chip.memory, sizeof(all)) == 0, "4 KB sequential read");
+  CHECK(chip.transactions - transactions == 1 + HOST_AT24C32_SIZE / BUFFER_LENGTH, "one address set, then Wire-buffer chunks");
+  printf("      4 KB read: %u transactions, %.0f ms at 100 kHz\n", chip.transactions - transactions, (micros() - start) / 1000.0);
+  
+  CHECK(!eeprom.write(4090, all, 8) && !eeprom.read(4095, all, 2), "out-of-range access rejected");
+  
+  // Absent chip
+  chip.present = false;
+  ExternalEeprom absent;
+  start = millis();
+  CHECK(!absent.begin() && !absent.read(0, all, 4) && !absent.write(0, all, 4), "absent chip: begin, read and write fail");
+  printf("      absent probe took %lu ms\n", millis() - start);
+  CHECK(millis() - start <= EXT_EEPROM_WRITE_TIMEOUT_MS + 1, "absent probe gives up after the longest write cycle");
+  chip.present = true;
+  
+  // The logger keeps 20 days of hours on the chip; they survive a reboot
+  memset(chip.memory, 0xFF, sizeof(chip.memory));
+  hostEepromErase();
+  static DataLogger logger;
+  logger.init();
+  CHECK(logger.hasExternalHistory(), "logger uses the AT24C32 when present");
+  for (uint32_t hour = 0; hour < 72; hour++) {
+    for (uint8_t minute = 0; minute < 60; minute += 10) {
+      SensorData data = sample(hour, minute);
+      hostAdvanceMillis(600000);
+      logger.update(data);
+    }
+  }
+  uint32_t pagesBeforeBoot = chip.pageWrites;
+  logger.init();
+  CHECK(chip.pageWrites == pagesBeforeBoot, "a reboot only reads the chip");
+  CHECK(restoredHours(logger), "all 71 closed hours restored from the chip after a reboot");
+  
+  // Five hours without power, then an hour logged: the old hours stay put
+  for (uint8_t minute = 0; minute <= 60; minute += 10) {
+    SensorData data = sample(77 + minute / 60, minute % 60);
+    hostAdvanceMillis(600000);
+    logger.update(data);
+  }
+  logger.init();
+  HistoryRecord record;
+  CHECK(restoredHours(logger) && logger.getRecordAt(TIER_HOURLY, DateTime(2026, 5, 4, 5, 0, 0), record),
+        "after a five-hour outage the chip keeps the older hours and adds the new one");
+  
+  return hostTestSummary();
+}
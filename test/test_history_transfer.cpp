@@ -0,0 +1,380 @@
+// HistoryTransfer: export an AT24C32 image, import it into a blank board and
+// compare every record; the import's resend paths (a frame corrupted in
+// transit, a chunk sent out of order, a resend after a lost ACK); an END
+// whose CRC doesn't match, after which the board starts a new image; the
+// internal journal round trip and a refused mismatched store. The host side
+// answers from the Serial write hook the way tools/history_transfer.cpp
+// does over the port.
+//
+//   g++ -std=gnu++17 -Itest/host -Iinclude -Ilib/HybridClock test/test_history_transfer.cpp test/host/*.cpp src/HistoryTransfer.cpp src/DataLogger.cpp src/ExternalEeprom.cpp src/Telemetry.cpp src/Sensors.cpp src/I2CBus.cpp src/Log.cpp -o test_history_transfer
+//   ./test_history_transfer
+
+#include "HostTest.h"
+#include "HostAt24c32.h"
+#include "HistoryTransfer.h"
+#include <vector>
+
+#define MAX_RETRIES 5  // As in the tool
+
+static HostAt24c32 chip;
+static Telemetry telemetry;
+static HistoryTransfer transfer;
+
+// Exported file: INFO, the raw image, END
+struct Image {
+  TelemetryHistoryInfo info;
+  std::vector<uint8_t> data;
+  TelemetryHistoryEnd end;
+};
+
+static uint16_t imageCrc(const std::vector<uint8_t>& data) {
+  uint16_t crc = CRC16_INIT;
+  for (size_t i = 0; i < data.size(); i++) crc = crc16Update(crc, data[i]);
+  return crc;
+}
+
+// Decodes the frames the device sent since the output was cleared. False
+// unless INFO, chunks in order and an END matching the image arrived.
+static bool receiveExport(Image& image) {
+  const std::string& output = hostSerialOutput();
+  bool started = false;
+  size_t frameStart = 0;
+  for (size_t i = 0; i < output.size(); i++) {
+    if (output[i] != 0) continue;
+    uint8_t raw[TELEMETRY_MAX_FRAME];
+    size_t length = i - frameStart;
+    size_t rawLength = length > 0 && length <= TELEMETRY_MAX_FRAME ?
+                       telemetryDecodeFrame((const uint8_t*)output.data() + frameStart, length, raw) : 0;
+    frameStart = i + 1;
+    if (rawLength < TELEMETRY_HEADER_SIZE || raw[1] != TELEMETRY_HISTORY_VERSION) continue;
+    const uint8_t* body = raw + TELEMETRY_HEADER_SIZE;
+    size_t bodyLength = rawLength - TELEMETRY_HEADER_SIZE;
+    
+    if (raw[0] == TELEMETRY_HISTORY_INFO && bodyLength == sizeof(image.info)) {
+      memcpy(&image.info, body, sizeof(image.info));
+      image.data.clear();
+      started = true;
+    } else if (raw[0] == TELEMETRY_HISTORY_CHUNK && bodyLength == sizeof(TelemetryHistoryChunk) && started) {
+      TelemetryHistoryChunk chunk;
+      memcpy(&chunk, body, sizeof(chunk));
+      if (chunk.offset != image.data.size()) return false;
+      image.data.insert(image.data.end(), chunk.data, chunk.data + sizeof(chunk.data));
+    } else if (raw[0] == TELEMETRY_HISTORY_END && bodyLength == sizeof(image.end) && started) {
+      memcpy(&image.end, body, sizeof(image.end));
+      return image.data.size() == image.info.size && imageCrc(image.data) == image.end.crc;
+    }
+  }
+  return false;
+}
+
+// ---- Host side of an import ----
+// INFO, then the chunk at whatever offset each ACK asks for, then END, as
+// the tool's import loop. Every frame is queued for the device as soon as
+// the ACK it answers is written, so the device finds it waiting. Each
+// fault fires once.
+
+static struct {
+  Image image;
+  uint32_t offset;
+  bool ready;
+  bool infoAccepted;
+  bool finished;
+  bool succeeded;
+  uint8_t sequence;
+  int retries;
+  int resends;
+  uint32_t statuses[HISTORY_TIMEOUT + 1];
+  uint8_t received[TELEMETRY_MAX_FRAME];
+  uint8_t receivedLength;
+  
+  int framesSent;
+  int corruptFrame;   // Flip a bit in this frame, counted from 0
+  long skipAt;        // Send the chunk after this offset in its place
+  long repeatAt;      // Send this chunk again after its ACK, as if the ACK was lost
+} host;
+
+static void sendNext() {
+  uint8_t frame[TELEMETRY_MAX_FRAME + 1];
+  uint8_t length;
+  frame[0] = 0;
+  if (!host.infoAccepted) {
+    length = telemetryEncodeFrame(TELEMETRY_HISTORY_INFO, TELEMETRY_HISTORY_VERSION, host.sequence++,
+                                  &host.image.info, sizeof(host.image.info), frame + 1);
+  } else if (host.offset < host.image.info.size) {
+    TelemetryHistoryChunk chunk;
+    chunk.offset = host.offset;
+    if (host.skipAt == (long)host.offset) {
+      chunk.offset += TELEMETRY_HISTORY_CHUNK_SIZE;
+      host.skipAt = -1;
+    }
+    memcpy(chunk.data, &host.image.data[chunk.offset], sizeof(chunk.data));
+    length = telemetryEncodeFrame(TELEMETRY_HISTORY_CHUNK, TELEMETRY_HISTORY_VERSION, host.sequence++,
+                                  &chunk, sizeof(chunk), frame + 1);
+  } else {
+    length = telemetryEncodeFrame(TELEMETRY_HISTORY_END, TELEMETRY_HISTORY_VERSION, host.sequence++,
+                                  &host.image.end, sizeof(host.image.end), frame + 1);
+  }
+  if (host.framesSent++ == host.corruptFrame) {
+    frame[1 + length / 2] ^= 0x04;
+  }
+  hostSerialInput(frame, length + 1);
+}
+
+static void onAck(const TelemetryHistoryAck& ack) {
+  if (!host.ready) {
+    host.ready = ack.status == HISTORY_OK;  // The answer to the import command
+    if (host.ready) sendNext();
+    return;
+  }
+  if (host.finished) return;
+  host.statuses[ack.status]++;
+  
+  if (ack.status == HISTORY_BAD_FRAME) {
+    if (++host.retries > MAX_RETRIES) {
+      host.finished = true;
+      return;
+    }
+    host.resends++;
+    sendNext();
+    return;
+  }
+  if (ack.status != HISTORY_OK && ack.status != HISTORY_OUT_OF_ORDER) {
+    host.finished = true;
+    return;
+  }
+  if (!host.infoAccepted) {
+    host.infoAccepted = true;
+  } else if (host.offset >= host.image.info.size && ack.status == HISTORY_OK) {
+    host.finished = true;
+    host.succeeded = true;
+    return;
+  }
+  
+  host.offset = ack.next;
+  if (host.repeatAt >= 0 && ack.status == HISTORY_OK && ack.next == host.repeatAt + TELEMETRY_HISTORY_CHUNK_SIZE) {
+    host.offset = host.repeatAt;
+    host.repeatAt = -1;
+    host.resends++;
+  }
+  host.retries = 0;
+  sendNext();
+}
+
+static void hostReceive(uint8_t c) {
+  if (c != 0) {
+    if (host.receivedLength < sizeof(host.received)) host.received[host.receivedLength++] = c;
+    return;
+  }
+  uint8_t raw[TELEMETRY_MAX_FRAME];
+  size_t length = host.receivedLength > 0 ? telemetryDecodeFrame(host.received, host.receivedLength, raw) : 0;
+  host.receivedLength = 0;
+  if (length == TELEMETRY_HEADER_SIZE + sizeof(TelemetryHistoryAck) &&
+      raw[0] == TELEMETRY_HISTORY_ACK && raw[1] == TELEMETRY_HISTORY_VERSION) {
+    TelemetryHistoryAck ack;
+    memcpy(&ack, raw + TELEMETRY_HEADER_SIZE, sizeof(ack));
+    onAck(ack);
+  }
+}
+
+static void startImport(const Image& image) {
+  host = {};
+  host.image = image;
+  host.corruptFrame = -1;
+  host.skipAt = -1;
+  host.repeatAt = -1;
+}
+
+static bool runImport(DataLogger& logger) {
+  transfer.init(&logger, &telemetry);
+  hostSerialOnWrite(hostReceive);
+  bool ok = transfer.importHistory();
+  hostSerialOnWrite(NULL);
+  return ok;
+}
+
+static bool runExport(DataLogger& logger, Image& image) {
+  transfer.init(&logger, &telemetry);
+  hostSerialOutput().clear();
+  return transfer.exportHistory() && receiveExport(image);
+}
+
+// ---- Boards and history ----
+
+// Samples every minute from 2026-05-01 00:00 plus the given hour
+static void feed(DataLogger& logger, uint16_t from, uint16_t hours) {
+  for (uint16_t h = from; h < from + hours; h++) {
+    for (uint8_t minute = 0; minute < 60; minute++) {
+      SensorData data = {};
+      data.currentTime = DateTime(2026, 5, 1 + h / 24, h % 24, minute, 0);
+      data.temperatureF = 50 + h % 24 + minute * 0.05f;
+      data.humidity = 40 + h % 30;
+      data.pressure = 1000 + (h % 50) * 0.3f;
+      data.lightLevel = 10 * (h % 12);
+      data.validFlags = 0x0F;
+      hostAdvanceMillis(60000);
+      logger.update(data);
+    }
+  }
+}
+
+static DateTime hourAt(uint16_t h) { return DateTime(2026, 5, 1 + h / 24, h % 24, 0, 0); }
+
+static void blankBoard(DataLogger& logger, bool withChip) {
+  memset(chip.memory, 0xFF, sizeof(chip.memory));
+  chip.present = withChip;
+  hostEepromErase();
+  hostAdvanceMillis(100);
+  logger.init();
+}
+
+// Light isn't journaled, so a reloaded record has none
+static bool sameRecord(const HistoryRecord& a, const HistoryRecord& b) {
+  return a.timestamp.getYear() == b.timestamp.getYear() && a.timestamp.getDay() == b.timestamp.getDay() &&
+         a.timestamp.getHour() == b.timestamp.getHour() && a.avgPressure == b.avgPressure &&
+         a.avgTemperature == b.avgTemperature && a.maxTemperature == b.maxTemperature &&
+         a.minTemperature == b.minTemperature && a.avgHumidity == b.avgHumidity;
+}
+
+#define FED_HOURS (22 * 24)
+
+// Every hour the board can reach by time, and every daily slot
+struct Snapshot {
+  std::vector<HistoryRecord> hours;
+  std::vector<HistoryRecord> days;
+  uint16_t present = 0;
+};
+
+static Snapshot snapshot(DataLogger& logger) {
+  Snapshot s;
+  for (uint16_t h = 0; h < FED_HOURS; h++) {
+    HistoryRecord record;
+    if (logger.getRecordAt(TIER_HOURLY, hourAt(h), record)) {
+      s.present++;
+    }
+    s.hours.push_back(record);  // Cleared when missing
+  }
+  for (uint8_t ago = 0; ago < logger.getTierSize(TIER_DAILY); ago++) {
+    s.days.push_back(logger.getDailyRecord(ago));
+  }
+  return s;
+}
+
+static bool sameSnapshot(const Snapshot& a, const Snapshot& b) {
+  if (a.present != b.present) return false;
+  for (size_t i = 0; i < a.hours.size(); i++) {
+    if (!sameRecord(a.hours[i], b.hours[i])) return false;
+  }
+  for (size_t i = 0; i < a.days.size(); i++) {
+    if (!sameRecord(a.days[i], b.days[i])) return false;
+  }
+  return true;
+}
+
+static bool cleanRun() {
+  for (uint8_t status = HISTORY_BAD_FRAME; status <= HISTORY_TIMEOUT; status++) {
+    if (host.statuses[status] != 0) return false;
+  }
+  return host.succeeded && host.resends == 0;
+}
+
+static DataLogger source, target, internal, internalTarget;
+
+int main() {
+  Wire.begin();
+  telemetry.init();
+  
+  // Source board: 22 days on the AT24C32
+  blankBoard(source, true);
+  CHECK(source.hasExternalHistory(), "source board keeps history on the AT24C32");
+  feed(source, 0, FED_HOURS);
+  Image image;
+  CHECK(runExport(source, image), "export: INFO, chunks in order, END with a matching CRC");
+  CHECK(image.info.store == TELEMETRY_HISTORY_EXTERNAL && image.data.size() == HOST_AT24C32_SIZE &&
+        memcmp(image.data.data(), chip.memory, HOST_AT24C32_SIZE) == 0, "exported image is the whole chip");
+  Snapshot sourceHistory = snapshot(source);
+  printf("      %u of %u hours and %u days on the source\n", sourceHistory.present, FED_HOURS,
+         (unsigned)sourceHistory.days.size());
+  
+  // Blank board, clean import
+  blankBoard(target, true);
+  startImport(image);
+  uint32_t pageWrites = chip.pageWrites;
+  bool ok = runImport(target);
+  CHECK(ok && cleanRun(), "import into a blank board: every frame ACKed first time");
+  CHECK(memcmp(chip.memory, image.data.data(), HOST_AT24C32_SIZE) == 0, "imported chip image identical to the export");
+  uint32_t importPageWrites = chip.pageWrites - pageWrites;
+  printf("      %u page writes for %u chunks\n", importPageWrites, image.info.size / TELEMETRY_HISTORY_CHUNK_SIZE);
+  CHECK(sameSnapshot(snapshot(target), sourceHistory), "every hour and day reads back as on the source, without a reboot");
+  target.init();
+  CHECK(sameSnapshot(snapshot(target), sourceHistory), "and again after a reboot");
+  
+  // A frame corrupted in transit is NAKed and resent
+  blankBoard(target, true);
+  startImport(image);
+  host.corruptFrame = 20;
+  ok = runImport(target);
+  CHECK(ok && host.succeeded && host.statuses[HISTORY_BAD_FRAME] >= 1 && host.resends >= 1,
+        "corrupted chunk: BAD_FRAME, resent, import completes");
+  CHECK(memcmp(chip.memory, image.data.data(), HOST_AT24C32_SIZE) == 0, "image still identical");
+  
+  // A chunk ahead of the device's offset is refused; the host goes back to it
+  blankBoard(target, true);
+  startImport(image);
+  host.skipAt = 40 * TELEMETRY_HISTORY_CHUNK_SIZE;
+  ok = runImport(target);
+  CHECK(ok && host.succeeded && host.statuses[HISTORY_OUT_OF_ORDER] == 1,
+        "chunk sent out of order: OUT_OF_ORDER with the wanted offset, import completes");
+  CHECK(memcmp(chip.memory, image.data.data(), HOST_AT24C32_SIZE) == 0, "image still identical");
+  
+  // The previous chunk again, as after a lost ACK, is ACKed and not rewritten
+  blankBoard(target, true);
+  startImport(image);
+  host.repeatAt = 70 * TELEMETRY_HISTORY_CHUNK_SIZE;
+  pageWrites = chip.pageWrites;
+  ok = runImport(target);
+  CHECK(ok && host.succeeded && host.resends == 1 && host.statuses[HISTORY_OUT_OF_ORDER] == 0 &&
+        host.statuses[HISTORY_BAD_FRAME] == 0, "chunk resent after a lost ACK: ACKed OK, import completes");
+  CHECK(chip.pageWrites - pageWrites == importPageWrites, "the resent chunk is not written twice");
+  CHECK(sameSnapshot(snapshot(target), sourceHistory), "history identical after the resend paths");
+  
+  // END's CRC doesn't match what arrived: nothing is committed. The chip
+  // was overwritten on the way, so history reads empty and the next save
+  // starts a new image
+  startImport(image);
+  host.image.data[1000] ^= 0x01;
+  ok = runImport(target);
+  CHECK(!ok && host.finished && !host.succeeded && host.statuses[HISTORY_CRC_MISMATCH] == 1,
+        "image altered after its CRC: CRC_MISMATCH, import refused");
+  CHECK(target.getRecord(TIER_HOURLY, 0).timestamp.getMonth() == 0 && target.getRecord(TIER_DAILY, 0).timestamp.getMonth() == 0,
+        "no half-imported history after the refused import");
+  feed(target, FED_HOURS, 2);
+  target.init();
+  HistoryRecord record;
+  CHECK(!target.getRecordAt(TIER_HOURLY, hourAt(300), record) && target.getRecordAt(TIER_HOURLY, hourAt(FED_HOURS), record),
+        "next save starts a new image; after a reboot only the new hours are there");
+  
+  // Internal journal: round trip, and an AT24C32 image refused
+  blankBoard(internal, false);
+  CHECK(!internal.hasExternalHistory(), "board without the chip keeps history in the internal EEPROM");
+  feed(internal, 0, 30);
+  Image internalImage;
+  CHECK(runExport(internal, internalImage) && internalImage.info.store == TELEMETRY_HISTORY_INTERNAL,
+        "internal journal export");
+  HistoryRecord internalNewest = internal.getRecord(TIER_HOURLY, 0);
+  
+  blankBoard(internalTarget, false);
+  startImport(image);
+  ok = runImport(internalTarget);
+  CHECK(!ok && host.statuses[HISTORY_INCOMPATIBLE] == 1, "AT24C32 image refused as incompatible");
+  
+  startImport(internalImage);
+  ok = runImport(internalTarget);
+  std::vector<uint8_t> readBack(internalImage.info.size);
+  for (uint16_t addr = 0; addr < readBack.size(); addr += TELEMETRY_HISTORY_CHUNK_SIZE) {
+    internalTarget.readStore(addr, &readBack[addr], TELEMETRY_HISTORY_CHUNK_SIZE);
+  }
+  CHECK(ok && cleanRun() && readBack == internalImage.data, "internal journal round trip identical");
+  CHECK(sameRecord(internalTarget.getRecord(TIER_HOURLY, 0), internalNewest), "internal import reloaded into RAM");
+  
+  return hostTestSummary();
+}
@@ -0,0 +1,97 @@
+// Periods that close with a channel missing, on every tier: light-only
+// periods, and periods without pressure or temperature. A missing
+// channel carries the previous record forward; with no previous record
+// the period is not stored at all, since zeros would read as 0°F and
+// 800 hPa.
+//
+//   g++ -std=gnu++17 -Itest/host -Iinclude -Ilib/HybridClock test/test_missing_channels.cpp test/host/*.cpp src/DataLogger.cpp src/ExternalEeprom.cpp -o test_missing_channels
+//   ./test_missing_channels
+
+#include "HostTest.h"
+#include "DataLogger.h"
+
+static DataLogger logger;
+
+static const char* tierNames[HISTORY_TIER_COUNT] = {"5-minute", "hourly", "daily", "weekly"};
+
+// Samples every 30 s for the given hours from the current position
+static uint32_t clockMinutes;  // Since 2026-03-02 00:00 (a Monday); stays within March
+
+static void feed(uint32_t hours, uint8_t validFlags, float temperatureF, float pressure) {
+  for (uint32_t sample = 0; sample < hours * 120; sample++) {
+    uint32_t minutes = clockMinutes + sample / 2;
+    uint32_t day = minutes / 1440;
+    SensorData data = {};
+    data.currentTime = DateTime(2026, 3, 2 + day, minutes / 60 % 24, minutes % 60, sample % 2 * 30);
+    data.temperatureF = temperatureF;
+    data.temperature = (temperatureF - 32) * 5 / 9;
+    data.humidity = 45;
+    data.pressure = pressure;
+    data.lightLevel = 120;
+    data.validFlags = validFlags;
+    hostAdvanceMillis(30000);
+    logger.update(data);
+  }
+  clockMinutes += hours * 60;
+}
+
+// A missing period reads back with a zero timestamp
+static bool hasRecord(HistoryTier tier, uint8_t ago = 0) {
+  return logger.getRecord(tier, ago).timestamp.getMonth() != 0;
+}
+
+int main() {
+  hostEepromErase();
+  Wire.begin();
+  logger.init();
+  
+  // Nine days of light only: nothing can be stored on any tier
+  feed(9 * 24, SENSOR_VALID_TIME | SENSOR_VALID_LIGHT, 0, 0);
+  for (uint8_t tier = 0; tier < HISTORY_TIER_COUNT; tier++) {
+    char description[80];
+    snprintf(description, sizeof(description), "light-only periods leave no %s record", tierNames[tier]);
+    CHECK(!hasRecord((HistoryTier)tier), description);
+  }
+  
+  // Climate without pressure, still nothing to carry forward
+  feed(3, SENSOR_VALID_TIME | SENSOR_VALID_CLIMATE | SENSOR_VALID_LIGHT, 68, 0);
+  CHECK(!hasRecord(TIER_HOURLY) && !hasRecord(TIER_FIVE_MINUTE), "no pressure and no previous record: not stored");
+  
+  // Full readings from here: the first real records are the first records
+  feed(8 * 24, 0x0F, 68, 1012);
+  bool realValues = true;
+  for (uint8_t tier = 0; tier < HISTORY_TIER_COUNT; tier++) {
+    HistoryRecord record = logger.getRecord((HistoryTier)tier, 0);
+    realValues = realValues && hasRecord((HistoryTier)tier) && fabs(record.avgPressure - 1012) < 0.2 && record.minPressure > 1011;
+    printf("      %-8s newest %02u-%02u %02u:%02u  %.1f F  %.1f hPa (%.1f-%.1f)\n", tierNames[tier],
+           record.timestamp.getMonth(), record.timestamp.getDay(), record.timestamp.getHour(), record.timestamp.getMinute(),
+           record.avgTemperature, record.avgPressure, record.minPressure, record.maxPressure);
+  }
+  CHECK(realValues, "every tier's newest record holds the measured pressure, not 800 hPa");
+  
+  bool noZeros = true;
+  for (uint8_t tier = 0; tier < HISTORY_TIER_COUNT; tier++) {
+    for (uint8_t ago = 0; ago < logger.getTierSize((HistoryTier)tier); ago++) {
+      HistoryRecord record = logger.getRecord((HistoryTier)tier, ago);
+      if (hasRecord((HistoryTier)tier, ago) && (record.avgPressure < 1000 || record.avgTemperature < 60)) {
+        noZeros = false;
+      }
+    }
+  }
+  CHECK(noZeros, "no stored record anywhere reads as 0 F or 800 hPa");
+  CHECK(!logger.checkRapidChange() && !logger.checkPressureAlert() && !logger.checkTemperatureAlert(), "no alerts from a steady pressure");
+  CHECK(fabs(logger.calculateTrends().pressureTrend) < 0.05, "pressure trend flat");
+  
+  // Pressure drops out for three hours: the previous hour is carried forward
+  feed(3, SENSOR_VALID_TIME | SENSOR_VALID_CLIMATE | SENSOR_VALID_LIGHT, 70, 0);
+  HistoryRecord carried = logger.getRecord(TIER_HOURLY, 0);
+  CHECK(fabs(carried.avgPressure - 1012) < 0.2 && fabs(carried.avgTemperature - 70) < 0.2, "missing pressure carries the previous hour, temperature is new");
+  
+  // And temperature drops out: the previous value again, not 0 F
+  feed(2, SENSOR_VALID_TIME | SENSOR_VALID_PRESSURE | SENSOR_VALID_LIGHT, 0, 1009);
+  carried = logger.getRecord(TIER_HOURLY, 0);
+  CHECK(fabs(carried.avgTemperature - 70) < 0.2 && fabs(carried.avgPressure - 1009) < 0.2, "missing temperature carries the previous hour");
+  CHECK(!logger.checkTemperatureAlert(), "no temperature alert from a dropout");
+  
+  return hostTestSummary();
+}
@@ -0,0 +1,163 @@
+// History journal power-loss safety and wear. Every hourly save is
+// replayed with the power cut after each byte it writes; the next boot
+// must restore only records that existed before or after the save, and
+// lose at most the slots being written. Then one year of logging is
+// counted per EEPROM cell.
+//
+//   g++ -std=gnu++17 -O2 -Itest/host -Iinclude -Ilib/HybridClock test/test_power_cut.cpp test/host/*.cpp src/DataLogger.cpp src/ExternalEeprom.cpp -o test_power_cut
+//   ./test_power_cut
+
+#include "HostTest.h"
+#include "DataLogger.h"
+
+static const uint8_t monthDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+// Hours and minutes from 2026-01-01 00:00
+static DateTime timeAt(uint32_t hour, uint8_t minute) {
+  uint16_t day = hour / 24;
+  uint8_t month = 0;
+  while (day >= monthDays[month]) {
+    day -= monthDays[month];
+    month = (month + 1) % 12;
+  }
+  return DateTime(2026, month + 1, day + 1, hour % 24, minute, 0);
+}
+
+static SensorData sample(uint32_t hour, uint8_t minute) {
+  SensorData data = {};
+  data.currentTime = timeAt(hour, minute);
+  double t = hour + minute / 60.0;
+  data.temperatureF = 60 + 10 * sin(t * 0.26);
+  data.humidity = 50 + 20 * cos(t * 0.1);
+  data.pressure = 1010 + 8 * sin(t * 0.03);
+  data.lightLevel = 100;
+  data.validFlags = 0x0F;
+  return data;
+}
+
+// Boot, log the last minutes of the hour and the first sample of the next,
+// which closes the hour and saves it
+static void saveHour(uint32_t hour) {
+  DataLogger logger;
+  logger.init();
+  logger.update(sample(hour - 1, 50));
+  logger.update(sample(hour, 0));
+}
+
+static bool sameValues(const HistoryRecord& a, const HistoryRecord& b) {
+  return a.avgTemperature == b.avgTemperature && a.avgHumidity == b.avgHumidity && a.avgPressure == b.avgPressure &&
+         a.minTemperature == b.minTemperature && a.maxTemperature == b.maxTemperature &&
+         a.minPressure == b.minPressure && a.maxPressure == b.maxPressure;
+}
+
+struct CutResult {
+  uint32_t corrupt;  // Restored records found in neither state
+  uint32_t dropped;  // Records of the state before the save that are gone
+  uint32_t lost;     // ...of which a clean save would have kept
+};
+
+// Each record the restored logger holds must be in one of the two states
+static CutResult compare(DataLogger& restored, DataLogger& before, DataLogger& after, HistoryTier tier) {
+  CutResult result = {0, 0, 0};
+  for (uint8_t ago = 0; ago < restored.getTierSize(tier); ago++) {
+    HistoryRecord record = restored.getRecord(tier, ago);
+    if (record.timestamp.getMonth() == 0) continue;
+    HistoryRecord expected;
+    bool inBefore = before.getRecordAt(tier, record.timestamp, expected) && sameValues(record, expected);
+    bool inAfter = after.getRecordAt(tier, record.timestamp, expected) && sameValues(record, expected);
+    if (!inBefore && !inAfter) result.corrupt++;
+  }
+  for (uint8_t ago = 0; ago < before.getTierSize(tier); ago++) {
+    HistoryRecord record = before.getRecord(tier, ago);
+    HistoryRecord found;
+    if (record.timestamp.getMonth() == 0 || restored.getRecordAt(tier, record.timestamp, found)) continue;
+    result.dropped++;
+    if (after.getRecordAt(tier, record.timestamp, found)) result.lost++;
+  }
+  return result;
+}
+
+int main() {
+  hostEepromErase();
+  
+  uint32_t saves = 0, cuts = 0, corrupt = 0, lost = 0, maxDropped = 0, torn = 0;  // maxDropped: in one ring
+  uint8_t before[EEPROM_SIZE], after[EEPROM_SIZE];
+  for (uint32_t hour = 1; hour < 24 * 20; hour++) {
+    memcpy(before, hostEeprom, EEPROM_SIZE);
+    uint32_t writesBefore = hostEepromWrites();
+    saveHour(hour);
+    uint32_t writes = hostEepromWrites() - writesBefore;
+    memcpy(after, hostEeprom, EEPROM_SIZE);
+    saves++;
+    
+    DataLogger beforeState, afterState;
+    memcpy(hostEeprom, before, EEPROM_SIZE);
+    beforeState.init();
+    memcpy(hostEeprom, after, EEPROM_SIZE);
+    afterState.init();
+    
+    // Power fails after 0, 1, ... writes - 1 bytes of the save
+    for (uint32_t cut = 0; cut < writes; cut++) {
+      memcpy(hostEeprom, before, EEPROM_SIZE);
+      hostEepromSetBudget(cut);
+      saveHour(hour);
+      hostEepromSetBudget(-1);
+      
+      DataLogger restored;
+      restored.init();
+      cuts++;
+      uint32_t dropped = 0;
+      for (uint8_t tier = TIER_HOURLY; tier <= TIER_DAILY; tier++) {
+        CutResult result = compare(restored, beforeState, afterState, (HistoryTier)tier);
+        corrupt += result.corrupt;
+        lost += result.lost;
+        dropped += result.dropped;
+        maxDropped = std::max(maxDropped, result.dropped);
+      }
+      if (dropped > 0) torn++;
+    }
+    memcpy(hostEeprom, after, EEPROM_SIZE);
+  }
+  
+  printf("      %u saves, %u cut points, %u dropped the slot being written (at most %u per ring)\n",
+         saves, cuts, torn, maxDropped);
+  CHECK(cuts > saves * 4, "every byte of every save was cut");
+  CHECK(corrupt == 0, "no cut restores a record that was never saved");
+  CHECK(lost == 0, "a cut never loses a record the save was not overwriting");
+  CHECK(maxDropped <= 1, "at most one slot per ring dropped");
+  
+  // Wear: one year at a 10-minute update rate, counted per cell
+  static uint32_t cellWrites[EEPROM_SIZE];
+  hostEepromErase();
+  DataLogger logger;
+  logger.init();
+  uint8_t previous[EEPROM_SIZE];
+  for (uint32_t hour = 0; hour < 365 * 24; hour++) {
+    for (uint8_t minute = 0; minute < 60; minute += 10) {
+      memcpy(previous, hostEeprom, EEPROM_SIZE);
+      logger.update(sample(hour, minute));
+      for (uint16_t i = 0; i < EEPROM_SIZE; i++) {
+        if (hostEeprom[i] != previous[i]) cellWrites[i]++;
+      }
+    }
+  }
+  
+  uint32_t hottest = 0, header = 0;
+  uint16_t hottestCell = 0;
+  for (uint16_t i = 0; i < EEPROM_SIZE; i++) {
+    if (cellWrites[i] > hottest) {
+      hottest = cellWrites[i];
+      hottestCell = i;
+    }
+  }
+  for (uint16_t i = EEPROM_DATA_START; i < EEPROM_DATA_START + EEPROM_HEADER_SIZE; i++) {
+    header = std::max(header, cellWrites[i]);
+  }
+  printf("      one year: hottest cell %u with %u writes, header %u; 100k cycles last %u years\n",
+         hottestCell, hottest, header, 100000 / std::max(hottest, 1u));
+  CHECK(hottest <= 2 * 365 + 1, "hottest cell written at most twice a day");
+  CHECK(header <= 2, "header written only on a rebase");
+  CHECK(100000 / hottest >= 100, "a hundred years of the rated 100k-cycle endurance");
+  
+  return hostTestSummary();
+}
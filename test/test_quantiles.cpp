@@ -0,0 +1,154 @@
+// P² percentile estimators (QuantileEstimator) against the exact 10th,
+// 50th and 90th percentiles of each sample set: 200 trials per channel
+// shape for a day (2880 samples) and an hour (120), each with 1% gross
+// glitches, plus an hour with a sustained glitch and iid/sorted input.
+//
+//   g++ -std=gnu++17 -O2 -Itest/host -Iinclude -Ilib/HybridClock test/test_quantiles.cpp test/host/*.cpp src/DataLogger.cpp src/ExternalEeprom.cpp -o test_quantiles
+//   ./test_quantiles
+
+#include "HostTest.h"
+#include "DataLogger.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define TRIALS 200
+
+static const float probabilities[QUANTILE_COUNT] = {0.1f, 0.5f, 0.9f};
+
+static std::mt19937 generator(40);
+static std::normal_distribution<double> normal(0, 1);
+static std::uniform_real_distribution<double> uniform(0, 1);
+
+// Where the estimate falls in the sorted samples, as a fraction of n - 1
+static double rankOf(const std::vector<float>& sorted, float estimate) {
+  size_t below = std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+  size_t through = std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+  return (below + through) / 2.0 / (sorted.size() - 1);
+}
+
+// Worst and mean rank error of the three quantiles over one sample set
+struct RankError {
+  double worst = 0;
+  double sum = 0;
+  uint32_t count = 0;
+  
+  void add(const std::vector<float>& samples) {
+    QuantileEstimator estimator;
+    estimator.reset();
+    for (float x : samples) estimator.add(x);
+    std::vector<float> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    for (uint8_t q = 0; q < QUANTILE_COUNT; q++) {
+      double error = fabs(rankOf(sorted, estimator.get((Quantile)q)) - probabilities[q]);
+      worst = std::max(worst, error);
+      sum += error;
+      count++;
+    }
+  }
+  double mean() const { return sum / count; }
+};
+
+// One period of 30 s samples for a channel; 1% of samples are gross
+// glitches (a flash on the light sensor, a bad pressure transfer)
+static std::vector<float> period(HistoryChannel channel, uint16_t n) {
+  std::vector<float> samples;
+  bool day = n > 200;
+  for (uint16_t i = 0; i < n; i++) {
+    double t = (double)i / n;
+    double x;
+    switch (channel) {
+      case CHANNEL_TEMPERATURE:
+        x = 68 + (day ? 10 * sin(2 * PI * t) : 2 * t) + 0.3 * normal(generator);
+        break;
+      case CHANNEL_PRESSURE:
+        x = 1010 + (day ? 4 * t : 0.5 * t) + 0.1 * normal(generator);
+        break;
+      default:
+        // Night, then daylight rising to 20000 lux and back: bimodal
+        x = t > 0.3 && t < 0.75 ? 20000 * sin((t - 0.3) / 0.45 * PI) + 1 : 0.3 + 0.1 * uniform(generator);
+        break;
+    }
+    if (uniform(generator) < 0.01) {
+      x += channel == CHANNEL_PRESSURE ? -60 : (channel == CHANNEL_LIGHT ? 40000 : 40);
+    }
+    samples.push_back(x);
+  }
+  return samples;
+}
+
+int main() {
+  // A 120-sample hour leaves P² little room to converge: its mean error is
+  // what counts, the odd trial is off by up to 0.3
+  struct Case {
+    const char* name;
+    HistoryChannel channel;
+    uint16_t samples;
+    double meanLimit;
+    double worstLimit;
+  } cases[] = {
+    {"temperature hour", CHANNEL_TEMPERATURE, 120, 0.08, 0.35},
+    {"temperature day", CHANNEL_TEMPERATURE, 2880, 0.05, 0.08},
+    {"pressure hour", CHANNEL_PRESSURE, 120, 0.08, 0.35},
+    {"pressure day", CHANNEL_PRESSURE, 2880, 0.05, 0.08},
+    {"light day", CHANNEL_LIGHT, 2880, 0.06, 0.10}
+  };
+  
+  for (const Case& c : cases) {
+    RankError error;
+    for (uint16_t trial = 0; trial < TRIALS; trial++) {
+      error.add(period(c.channel, c.samples));
+    }
+    char description[100];
+    snprintf(description, sizeof(description), "%s (n=%u): mean rank error %.3f, worst %.3f",
+             c.name, c.samples, error.mean(), error.worst);
+    CHECK(error.mean() <= c.meanLimit && error.worst <= c.worstLimit, description);
+  }
+  
+  // An hour at 1012 hPa with a 3-minute glitch to 900: the median holds
+  std::vector<float> hour;
+  for (uint16_t i = 0; i < 120; i++) {
+    hour.push_back(i >= 60 && i < 66 ? 900 : 1012 + 0.05 * normal(generator));
+  }
+  QuantileEstimator estimator;
+  estimator.reset();
+  ChannelAccumulator mean;
+  mean.reset();
+  for (float x : hour) {
+    estimator.add(x);
+    mean.add(x);
+  }
+  printf("      3-minute 900 hPa glitch: mean %.2f, median %.2f, p90 %.2f\n",
+         mean.mean, estimator.get(QUANTILE_MEDIAN), estimator.get(QUANTILE_P90));
+  CHECK(fabs(estimator.get(QUANTILE_MEDIAN) - 1012) < 0.2 && mean.mean < 1007, "median ignores a glitch that drags the mean");
+  
+  // iid normal input
+  RankError iid;
+  for (uint16_t trial = 0; trial < TRIALS; trial++) {
+    std::vector<float> samples;
+    for (uint16_t i = 0; i < 2880; i++) samples.push_back(normal(generator) * 10);
+    iid.add(samples);
+  }
+  char description[100];
+  snprintf(description, sizeof(description), "iid normal, n=2880: worst rank error %.3f", iid.worst);
+  CHECK(iid.worst <= 0.02, description);
+  
+  // Monotonic input, the worst case for marker adjustment
+  std::vector<float> sorted;
+  for (uint16_t i = 0; i < 2880; i++) sorted.push_back(i);
+  estimator.reset();
+  for (float x : sorted) estimator.add(x);
+  bool withinOneRank = true;
+  for (uint8_t q = 0; q < QUANTILE_COUNT; q++) {
+    withinOneRank = withinOneRank && fabs(estimator.get((Quantile)q) - probabilities[q] * 2879) <= 1.5;
+  }
+  CHECK(withinOneRank, "sorted input lands within one rank");
+  
+  // The first 9 samples are answered exactly
+  estimator.reset();
+  CHECK(isnan(estimator.get(QUANTILE_MEDIAN)), "no samples: NAN");
+  for (float x : {5.0f, 1.0f, 9.0f, 3.0f, 7.0f}) estimator.add(x);
+  CHECK(estimator.get(QUANTILE_MEDIAN) == 5, "five samples: exact median");
+  
+  return hostTestSummary();
+}
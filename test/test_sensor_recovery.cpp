@@ -0,0 +1,139 @@
+// Sensor fault recovery: devices dropping off the bus, glitched transfers,
+// a slave holding SDA and a TWI timeout, all injected by the host bus
+// models rather than by hooks in the firmware. Also a light one-shot still
+// integrating at read time, and MTreg left alone while the range holds.
+//
+//   g++ -std=gnu++17 -Itest/host -Iinclude -Ilib/HybridClock test/test_sensor_recovery.cpp test/host/*.cpp src/Sensors.cpp src/I2CBus.cpp src/Log.cpp src/Telemetry.cpp -o test_sensor_recovery
+//   ./test_sensor_recovery
+
+#include "HostTest.h"
+#include "HostSensors.h"
+#include "Sensors.h"
+#include "I2CBus.h"
+
+static HostDs3231 rtcChip;
+static HostAht21 ahtChip;
+static HostBmp280 bmpChip;
+static HostBh1750 lightChip;
+static Sensors sensors;
+
+// One scheduled read, SENSOR_READ_INTERVAL after the last, followed by the
+// bus check the main loop makes
+static uint8_t readCycle() {
+  hostAdvanceMillis(SENSOR_READ_INTERVAL);
+  sensors.readSensors();
+  I2CBus::service();
+  return sensors.getCurrentData().validFlags;
+}
+
+int main() {
+  rtcChip.setTime(2026, 3, 14, 9, 26, 53);
+  ahtChip.temperature = 21.5;
+  ahtChip.humidity = 40;
+  bmpChip.pressure = 1008.4;
+  lightChip.lux = 250;
+  
+  CHECK(sensors.init(), "all four devices initialize");
+  CHECK(readCycle() == 0x0F, "first read is valid on every channel");
+  SensorData data = sensors.getCurrentData();
+  CHECK(data.currentTime.getHour() == 9 && data.currentTime.getMinute() == 26, "RTC time read through the bus");
+  CHECK(fabs(data.temperature - 21.5) < 0.01 && fabs(data.humidity - 40) < 0.01, "AHT21 temperature and humidity decoded");
+  CHECK(fabs(data.pressure - 1008.4) < 0.01, "BMP280 pressure read after the forced conversion");
+  
+  // A single glitched transfer is absorbed by the immediate retry
+  ahtChip.failNext(1);
+  CHECK(readCycle() == 0x0F, "one NACK on the AHT21: the retry still reads it");
+  CHECK(sensors.getDeviceHealth(SENSOR_AHT21) == DEVICE_OK, "one glitch does not degrade the device");
+  
+  // Pressure module unplugged: only its channel goes stale
+  bmpChip.present = false;
+  CHECK(readCycle() == (SENSOR_VALID_TIME | SENSOR_VALID_CLIMATE | SENSOR_VALID_LIGHT), "unplugged BMP280 loses only the pressure channel");
+  CHECK(sensors.getDeviceHealth(SENSOR_BMP280) == DEVICE_DEGRADED, "BMP280 degraded after the first failed read");
+  CHECK(fabs(sensors.getCurrentData().pressure - 1008.4) < 0.01, "stale pressure keeps its last good value");
+  
+  unsigned long outageStart = millis();
+  
+  // Backoff: retried after 30 s, 60 s, 120 s ... and not touched in between
+  bool backoffOk = true;
+  for (uint8_t failure = 1; failure < 6; failure++) {
+    unsigned long backoff = SENSOR_RETRY_BASE_MS << (failure - 1);
+    if (backoff > SENSOR_RETRY_MAX_MS) backoff = SENSOR_RETRY_MAX_MS;
+    unsigned long retryAt = sensors.getDeviceStatus(SENSOR_BMP280).nextRetryTime;
+    backoffOk = backoffOk && retryAt - millis() <= backoff && retryAt - millis() > backoff - 1000;  // Less the rest of that read
+    
+    uint32_t before = bmpChip.transactions;
+    while ((long)(millis() + SENSOR_READ_INTERVAL - retryAt) < 0) {
+      readCycle();
+    }
+    backoffOk = backoffOk && bmpChip.transactions == before;
+    readCycle();
+    backoffOk = backoffOk && bmpChip.transactions > before;
+  }
+  CHECK(backoffOk, "retry delay doubles per failure and the device is left alone in between");
+  CHECK(sensors.getDeviceHealth(SENSOR_BMP280) == DEVICE_OFFLINE, "offline after SENSOR_OFFLINE_THRESHOLD failures");
+  CHECK(sensors.getDeviceStatus(SENSOR_BMP280).consecutiveFailures == 6, "every retry counted");
+  
+  // Plugged back in: re-initialized at the next retry and read again
+  bmpChip.present = true;
+  bmpChip.pressure = 1011.0;
+  unsigned long retryAt = sensors.getDeviceStatus(SENSOR_BMP280).nextRetryTime;
+  while ((long)(millis() - retryAt) < 0) {
+    readCycle();
+  }
+  CHECK(sensors.getCurrentData().validFlags == 0x0F, "replugged BMP280 recovers at its next retry");
+  CHECK(sensors.getDeviceHealth(SENSOR_BMP280) == DEVICE_OK, "health back to OK");
+  CHECK(fabs(sensors.getCurrentData().pressure - 1011.0) < 0.01, "fresh pressure after recovery");
+  unsigned long outage = sensors.getDeviceStatus(SENSOR_BMP280).lastRecoveryMs;
+  CHECK(outage >= retryAt - outageStart && outage <= millis() - outageStart + SENSOR_READ_INTERVAL, "recovery time covers the outage");
+  printf("      outage %lu s, %u failures\n", outage / 1000, sensors.getDeviceStatus(SENSOR_BMP280).totalFailures);
+  
+  // A slave stuck mid-byte holds SDA: the retry clocks it free
+  uint16_t recoveries = I2CBus::getRecoveryCount();
+  hostBusHoldSda(5);
+  CHECK(readCycle() == 0x0F, "SDA held low: bus recovered and every channel read");
+  CHECK(I2CBus::getRecoveryCount() == recoveries + 1 && !hostBusSdaLow(), "one recovery released SDA");
+  
+  // A stalled transfer trips the TWI timeout; the next attempt recovers
+  uint16_t timeouts = I2CBus::getTimeoutCount();
+  hostBusTimeout();
+  CHECK(readCycle() == 0x0F, "TWI timeout: retry after recovery reads every channel");
+  CHECK(I2CBus::getTimeoutCount() == timeouts + 1, "timeout counted");
+  CHECK(sensors.getDeviceHealth(SENSOR_RTC) == DEVICE_OK, "RTC not degraded by a recovered timeout");
+  
+  // A high-res one-shot still integrating at read time: the light channel
+  // is stale for that read, and it counts neither for nor against the BH1750
+  lightChip.lux = 30;
+  uint16_t lightFailures = sensors.getDeviceStatus(SENSOR_BH1750).totalFailures;
+  hostAdvanceMillis(SENSOR_READ_INTERVAL - LIGHT_PRECISE_LEAD_TIME);
+  sensors.updateLight();
+  sensors.readSensors();
+  CHECK(sensors.getCurrentData().validFlags == (SENSOR_VALID_TIME | SENSOR_VALID_CLIMATE | SENSOR_VALID_PRESSURE),
+        "one-shot pending: light left out of the read");
+  CHECK(sensors.getDeviceHealth(SENSOR_BH1750) == DEVICE_OK &&
+        sensors.getDeviceStatus(SENSOR_BH1750).totalFailures == lightFailures, "and not counted as a BH1750 failure");
+  hostAdvanceMillis(200);
+  sensors.readSensors();
+  CHECK((sensors.getCurrentData().validFlags & SENSOR_VALID_LIGHT) && fabs(sensors.getCurrentData().lightLevel - 30) < 0.5,
+        "one-shot done: the next read takes its lux");
+  
+  // The dark room raised MTreg; the next one-shot at the same range sends
+  // only the two mode commands and the read, and fast reads use that MTreg
+  uint32_t lightTransactions = lightChip.transactions;
+  hostAdvanceMillis(SENSOR_READ_INTERVAL - LIGHT_PRECISE_LEAD_TIME);
+  sensors.updateLight();
+  hostAdvanceMillis(LIGHT_PRECISE_LEAD_TIME);
+  sensors.updateLight();
+  CHECK(lightChip.mtreg == BH1750_MTREG_MAX && lightChip.transactions - lightTransactions == 3,
+        "steady range: no MTreg writes around the one-shot");
+  hostAdvanceMillis(LIGHT_FAST_READ_INTERVAL);
+  CHECK(sensors.updateLight() && fabs(sensors.getAmbientLight() - 30) < 0.5, "fast reads decode at the raised MTreg");
+  CHECK(readCycle() == 0x0F && fabs(sensors.getCurrentData().lightLevel - 30) < 0.5, "and the scheduled read takes the one-shot");
+  
+  // Everything gone at once: reads fail but nothing hangs
+  rtcChip.present = ahtChip.present = bmpChip.present = lightChip.present = false;
+  unsigned long start = millis();
+  CHECK(readCycle() == 0 && !sensors.readSensors(), "no devices: readSensors() reports failure");
+  CHECK(millis() - start < SENSOR_READ_INTERVAL + 1000, "a dead bus costs under a second per read");
+  
+  return hostTestSummary();
+}
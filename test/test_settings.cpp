@@ -0,0 +1,227 @@
+// Settings record: lazy saves, a power cut after every byte of a save,
+// records from older and newer firmware; and the history journal's move
+// from layout 2 (24 hourly slots, running on into today's settings area)
+// to layout 3, with settings then saved over the old daily slots.
+//
+//   g++ -std=gnu++17 -Itest/host -Iinclude -Ilib/HybridClock test/test_settings.cpp test/host/*.cpp src/Settings.cpp src/DataLogger.cpp src/ExternalEeprom.cpp src/Log.cpp src/Telemetry.cpp src/Sensors.cpp src/I2CBus.cpp -o test_settings
+//   ./test_settings
+
+#include "HostTest.h"
+#include "Settings.h"
+#include "DataLogger.h"
+#include "Crc16.h"
+#include <map>
+#include <vector>
+
+static bool same(const SettingsData& a, const SettingsData& b) { return memcmp(&a, &b, sizeof(a)) == 0; }
+
+// A record as an older or newer firmware would have stored it in copy 0
+static void storeRecord(uint8_t schema, const uint8_t* fields, uint8_t length) {
+  uint8_t record[SETTINGS_COPY_SIZE];
+  record[0] = schema;
+  record[1] = length;
+  memcpy(record + SETTINGS_HEADER_SIZE, fields, length);
+  uint16_t crc = CRC16_INIT;
+  for (uint8_t i = 0; i < SETTINGS_HEADER_SIZE + length; i++) crc = crc16Update(crc, record[i]);
+  record[SETTINGS_HEADER_SIZE + length] = crc >> 8;
+  record[SETTINGS_HEADER_SIZE + length + 1] = crc & 0xFF;
+  memcpy(hostEeprom + SETTINGS_EEPROM_START, record, SETTINGS_HEADER_SIZE + length + SETTINGS_CRC_SIZE);
+}
+
+static void testSettings() {
+  hostEepromErase();
+  Settings settings;
+  CHECK(!settings.init(), "blank EEPROM: no record, defaults");
+  SettingsData defaults = settings.getData();
+  
+  uint32_t writes = hostEepromWrites();
+  CHECK(settings.save() == 2 * SETTINGS_RECORD_SIZE && hostEepromWrites() - writes == 2 * SETTINGS_RECORD_SIZE,
+        "first save writes both copies");
+  writes = hostEepromWrites();
+  CHECK(settings.save() == 0 && hostEepromWrites() == writes, "unchanged save writes nothing");
+  bool journalUntouched = true;
+  for (uint16_t i = 0; i < SETTINGS_EEPROM_START; i++) journalUntouched = journalUntouched && hostEeprom[i] == 0xFF;
+  CHECK(journalUntouched, "journal area untouched");
+  
+  settings.getData().chimeType = CHIME_CUSTOM;
+  uint8_t written = settings.save();
+  printf("      one field changed: %u bytes written\n", written);
+  CHECK(written >= 2 && written <= 2 * (1 + SETTINGS_CRC_SIZE), "one field: the field and CRC bytes of each copy");
+  Settings reloaded;
+  CHECK(reloaded.init() && reloaded.getData().chimeType == CHIME_CUSTOM, "reboot loads the saved record");
+  
+  // Power cut after every byte of a save that changes most fields: boot
+  // finds either the old settings or the new ones, never defaults
+  SettingsData before = settings.getData();
+  SettingsData after = before;
+  after.chimeInstrument = 46;
+  after.chimeFrequency = 4;
+  after.brightness = 9;
+  after.quietStart = 23;
+  after.quietEnd = 6;
+  after.pressureAlertRate = 15;
+  uint8_t saved[EEPROM_SIZE];
+  memcpy(saved, hostEeprom, sizeof(saved));
+  settings.getData() = after;
+  uint8_t total = settings.save();
+  uint16_t oldKept = 0, newKept = 0, lost = 0;
+  for (uint8_t cut = 0; cut <= total; cut++) {
+    memcpy(hostEeprom, saved, sizeof(saved));
+    settings.getData() = after;
+    hostEepromSetBudget(cut);
+    settings.save();
+    hostEepromSetBudget(-1);
+    Settings booted;
+    bool loaded = booted.init();
+    if (loaded && same(booted.getData(), before)) {
+      oldKept++;
+    } else if (loaded && same(booted.getData(), after)) {
+      newKept++;
+    } else {
+      lost++;
+    }
+  }
+  printf("      %u cut points: %u old, %u new, %u lost\n", total + 1, oldKept, newKept, lost);
+  CHECK(lost == 0 && oldKept > 0 && newKept > 0, "power cut at any byte of a save: old or new settings, never defaults");
+  
+  // Older firmware's shorter record: its fields, defaults for the rest
+  hostEepromErase();
+  uint8_t shortFields[] = {CHIME_WESTMINSTER, 9, 4};
+  storeRecord(SETTINGS_SCHEMA_VERSION, shortFields, sizeof(shortFields));
+  Settings older;
+  CHECK(older.init() && older.getData().chimeInstrument == 9 && older.getData().chimeFrequency == 4 &&
+        older.getData().quietStart == defaults.quietStart && older.getData().pressureAlertRate == defaults.pressureAlertRate,
+        "shorter record from older firmware: appended fields take defaults");
+  
+  // A schema this firmware doesn't know, and a record with unusable values
+  storeRecord(SETTINGS_SCHEMA_VERSION + 1, shortFields, sizeof(shortFields));
+  Settings newer;
+  CHECK(!newer.init() && same(newer.getData(), defaults), "newer schema: defaults");
+  uint8_t badFields[] = {7, 200, 3, 30, 25, 1, 150, 0, 0};
+  storeRecord(SETTINGS_SCHEMA_VERSION, badFields, sizeof(badFields));
+  Settings bad;
+  bad.init();
+  CHECK(bad.getData().chimeType == defaults.chimeType && bad.getData().chimeInstrument == defaults.chimeInstrument &&
+        bad.getData().chimeFrequency == defaults.chimeFrequency && bad.getData().brightness == defaults.brightness &&
+        bad.getData().quietStart == defaults.quietStart && bad.getData().quietBrightness == defaults.quietBrightness &&
+        bad.getData().pressureAlertRate == 0, "out-of-range values fall back to defaults, a 0 alert rate is kept");
+}
+
+// ---- Journal layout 2 -> 3 ----
+
+static DataLogger logger;
+
+static float pressureAt(uint16_t h) { return 1000 + (h % 50) * 0.3f; }
+static DateTime hourAt(uint16_t h) { return DateTime(2026, 3, 1 + h / 24, h % 24, 0, 0); }
+
+static void feed(uint16_t from, uint16_t hours) {
+  for (uint16_t h = from; h < from + hours; h++) {
+    for (uint8_t minute = 0; minute < 60; minute++) {
+      SensorData data = {};
+      data.currentTime = DateTime(2026, 3, 1 + h / 24, h % 24, minute, 0);
+      data.temperatureF = 60;
+      data.humidity = 50;
+      data.pressure = pressureAt(h);
+      data.lightLevel = 10;
+      data.validFlags = 0x0F;
+      hostAdvanceMillis(60000);
+      logger.update(data);
+    }
+  }
+}
+
+#define LAYOUT_2_HOURLY_SLOTS 24
+#define JOURNAL_SLOT(slot) (EEPROM_DATA_START + EEPROM_HEADER_SIZE + (slot) * EEPROM_RECORD_SIZE)
+
+// The previous firmware's journal after 10 days: header version 2, then
+// 24 hourly and 7 daily slots filling the EEPROM to its end. Slots are the
+// same self-checking 8 bytes, so this one is assembled from today's
+// journal taken 4 hours apart.
+static void writeLayout2() {
+  hostEepromErase();
+  logger.init();
+  feed(0, 236);
+  std::map<uint16_t, std::vector<uint8_t>> hours;
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    for (uint8_t slot = 0; slot < EEPROM_HOURLY_SLOTS; slot++) {
+      const uint8_t* bytes = hostEeprom + JOURNAL_SLOT(slot);
+      if ((bytes[0] & bytes[1]) == 0xFF) continue;  // Empty
+      hours[bytes[0] | (bytes[1] << 8)] = std::vector<uint8_t>(bytes, bytes + EEPROM_RECORD_SIZE);
+    }
+    if (pass == 0) feed(236, 4);
+  }
+  
+  uint8_t image[EEPROM_SIZE];
+  memcpy(image, hostEeprom, EEPROM_HEADER_SIZE);
+  image[0] = 2;
+  uint16_t crc = CRC16_INIT;
+  for (uint8_t i = 0; i < 3; i++) crc = crc16Update(crc, 0);  // The header's check is over a zero base
+  for (uint8_t i = 0; i < 4; i++) crc = crc16Update(crc, image[i]);
+  image[4] = (crc & 0xFF) == 0xFF ? 0xFE : crc & 0xFF;
+  uint8_t slot = 0;
+  for (auto hour = hours.rbegin(); hour != hours.rend() && slot < LAYOUT_2_HOURLY_SLOTS; ++hour, slot++) {
+    memcpy(image + JOURNAL_SLOT(LAYOUT_2_HOURLY_SLOTS - 1 - slot), hour->second.data(), EEPROM_RECORD_SIZE);
+  }
+  memcpy(image + JOURNAL_SLOT(LAYOUT_2_HOURLY_SLOTS), hostEeprom + JOURNAL_SLOT(EEPROM_HOURLY_SLOTS),
+         EEPROM_DAILY_SLOTS * EEPROM_RECORD_SIZE);
+  memcpy(hostEeprom, image, sizeof(image));
+}
+
+static uint16_t hoursRestored(uint16_t newest, uint16_t count, bool& valuesOk) {
+  uint16_t restored = 0;
+  for (uint16_t h = newest + 1 - count; h <= newest; h++) {
+    HistoryRecord record;
+    if (logger.getRecordAt(TIER_HOURLY, hourAt(h), record)) {
+      restored++;
+      valuesOk = valuesOk && fabs(record.avgPressure - pressureAt(h)) < 0.06;
+    }
+  }
+  return restored;
+}
+
+static uint8_t daysRestored() {
+  uint8_t restored = 0;
+  for (uint8_t ago = 0; ago < EEPROM_DAILY_SLOTS; ago++) {
+    if (logger.getRecord(TIER_DAILY, ago).timestamp.getMonth() != 0) restored++;
+  }
+  return restored;
+}
+
+static void testLayoutMigration() {
+  writeLayout2();
+  CHECK(JOURNAL_SLOT(LAYOUT_2_HOURLY_SLOTS + EEPROM_DAILY_SLOTS) == SETTINGS_EEPROM_START + 2 * SETTINGS_COPY_SIZE,
+        "layout 2 daily slots fill what is now the settings area");
+  
+  // Newest closed hour is 238
+  uint32_t writes = hostEepromWrites();
+  logger.init();
+  uint32_t migration = hostEepromWrites() - writes;
+  bool valuesOk = true;
+  uint16_t hourly = hoursRestored(238, LAYOUT_2_HOURLY_SLOTS, valuesOk);
+  printf("      layout 2: %u hourly and %u daily restored, %u bytes rewritten\n", hourly, daysRestored(), migration);
+  CHECK(hourly == EEPROM_HOURLY_SLOTS && hoursRestored(238, EEPROM_HOURLY_SLOTS, valuesOk) == EEPROM_HOURLY_SLOTS &&
+        daysRestored() == EEPROM_DAILY_SLOTS && valuesOk, "layout 2 boot keeps the newest 20 hours and 7 days");
+  CHECK(hostEeprom[EEPROM_DATA_START] == EEPROM_LAYOUT_VERSION && migration > 0, "and rewrites the journal as layout 3 at once");
+  writes = hostEepromWrites();
+  logger.init();
+  CHECK(hostEepromWrites() == writes, "the next boot reads layout 3 and writes nothing");
+  
+  // What is left of the old daily slots isn't taken for settings; saving
+  // them over it leaves the journal whole
+  Settings settings;
+  CHECK(!settings.init(), "old daily slots in the settings area don't read as a record");
+  settings.getData().brightness = 7;
+  settings.save();
+  logger.init();
+  valuesOk = true;
+  CHECK(hoursRestored(238, EEPROM_HOURLY_SLOTS, valuesOk) == EEPROM_HOURLY_SLOTS && valuesOk &&
+        daysRestored() == EEPROM_DAILY_SLOTS, "after a settings save and reboot: 20 hours and 7 days still there");
+  Settings reloaded;
+  CHECK(reloaded.init() && reloaded.getData().brightness == 7, "and the settings load");
+}
+
+int main() {
+  testSettings();
+  testLayoutMigration();
+  return hostTestSummary();
+}
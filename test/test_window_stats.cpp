@@ -0,0 +1,127 @@
+// Windowed statistics (getAverage/getMin/getMax over the last N hours):
+// agreement with a brute-force scan of the hourly records for 1..48 h,
+// and query cost for every window from 1 to 24 h against that scan. The
+// AT24C32 is fitted, as windows past 20 h need its hours.
+//
+//   g++ -std=gnu++17 -O2 -Itest/host -Iinclude -Ilib/HybridClock test/test_window_stats.cpp test/host/*.cpp src/DataLogger.cpp src/ExternalEeprom.cpp -o test_window_stats
+//   ./test_window_stats
+
+#include "HostTest.h"
+#include "HostAt24c32.h"
+#include "DataLogger.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#define QUERIES 50000
+
+static HostAt24c32 chip;
+static DataLogger logger;
+static volatile float sink;
+
+struct Scan {
+  float avgTemperature, avgHumidity, avgPressure;
+  float minTemperature, maxTemperature, minPressure, maxPressure;
+};
+
+// What the old code did: copy each record of the window
+static Scan scan(uint8_t hours) {
+  Scan result = {0, 0, 0, INFINITY, -INFINITY, INFINITY, -INFINITY};
+  for (uint8_t i = 0; i < hours; i++) {
+    HourlyRecord record = logger.getHourlyRecord(i);
+    result.avgTemperature += record.avgTemperature;
+    result.avgHumidity += record.avgHumidity;
+    result.avgPressure += record.avgPressure;
+    result.minTemperature = std::min(result.minTemperature, record.minTemperature);
+    result.maxTemperature = std::max(result.maxTemperature, record.maxTemperature);
+    result.minPressure = std::min(result.minPressure, record.minPressure);
+    result.maxPressure = std::max(result.maxPressure, record.maxPressure);
+  }
+  result.avgTemperature /= hours;
+  result.avgHumidity /= hours;
+  result.avgPressure /= hours;
+  return result;
+}
+
+static double nanosPerQuery(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / QUERIES;
+}
+
+int main() {
+  Wire.begin();
+  hostEepromErase();
+  logger.init();
+  
+  // Ten days of 30 s samples: a diurnal temperature swing, drifting
+  // pressure, both with sensor noise
+  std::mt19937 random(5);
+  std::normal_distribution<double> noise(0, 1);
+  uint32_t n = 0;
+  for (uint8_t day = 1; day <= 10; day++) {
+    for (uint32_t second = 0; second < 86400; second += 30, n++) {
+      SensorData data = {};
+      data.currentTime = DateTime(2026, 4, day, second / 3600, second / 60 % 60, second % 60);
+      double hours = n * 30.0 / 3600;
+      data.temperatureF = 60 + 12 * sin(hours * 2 * PI / 24) + 0.5 * noise(random);
+      data.humidity = 50 + 10 * cos(hours * 0.3);
+      data.pressure = 1010 + 6 * sin(hours * 0.05) + 0.3 * noise(random);
+      data.lightLevel = 100;
+      data.validFlags = 0x0F;
+      logger.update(data);
+    }
+  }
+  
+  // Averages are 0.01 fixed point in the table, so half a step of rounding
+  double worstAverage = 0, worstExtreme = 0;
+  for (uint8_t hours = 1; hours <= 48; hours++) {
+    Scan expected = scan(hours);
+    worstAverage = std::max({worstAverage,
+                             (double)fabs(logger.getAverageTemperature(hours) - expected.avgTemperature),
+                             (double)fabs(logger.getAverageHumidity(hours) - expected.avgHumidity),
+                             (double)fabs(logger.getAveragePressure(hours) - expected.avgPressure)});
+    worstExtreme = std::max({worstExtreme,
+                             (double)fabs(logger.getMinTemperature(hours) - expected.minTemperature),
+                             (double)fabs(logger.getMaxTemperature(hours) - expected.maxTemperature),
+                             (double)fabs(logger.getMinPressure(hours) - expected.minPressure),
+                             (double)fabs(logger.getMaxPressure(hours) - expected.maxPressure)});
+  }
+  printf("      worst error vs the scan over 1..48 h: averages %.4f, extremes %.4f\n", worstAverage, worstExtreme);
+  CHECK(worstAverage <= 0.0051, "averages within half a 0.01 step of the scan, 1..48 h");
+  CHECK(worstExtreme <= 0.0051, "min and max match the scan, 1..48 h");
+  
+  printf("      hours  scan ns  table ns\n");
+  double tableFirst = 0, tableWorst = 0, scanFirst = 0, scanLast = 0;
+  for (uint8_t hours = 1; hours <= 24; hours++) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < QUERIES; i++) {
+      Scan result = scan(hours);
+      sink = result.avgTemperature + result.minTemperature;
+    }
+    double scanNanos = nanosPerQuery(start);
+    
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < QUERIES; i++) {
+      sink = logger.getAverageTemperature(hours) + logger.getMinTemperature(hours);
+    }
+    double tableNanos = nanosPerQuery(start);
+    printf("      %5u %8.1f %9.1f\n", hours, scanNanos, tableNanos);
+    
+    if (hours == 1) {
+      tableFirst = tableNanos;
+      scanFirst = scanNanos;
+    }
+    scanLast = scanNanos;
+    tableWorst = std::max(tableWorst, tableNanos);
+  }
+  CHECK(scanLast > scanFirst * 4, "the scan grows with the window (benchmark sanity)");
+  CHECK(tableWorst < tableFirst * 3 + 10, "table query cost flat from 1 to 24 h");
+  
+  // Empty history reads 0, as before
+  DataLogger empty;
+  hostEepromErase();
+  memset(chip.memory, 0xFF, sizeof(chip.memory));
+  empty.init();
+  CHECK(empty.getAverageTemperature(3) == 0 && empty.getMinPressure(3) == 0, "no history: windows read 0");
+  
+  return hostTestSummary();
+}
@@ -0,0 +1,278 @@
+// Host side of HistoryTransfer: saves the clock's history store to a file and
+// writes a saved one back, e.g. across a board swap or reflash.
+//
+//   g++ -std=c++11 -Iinclude tools/history_transfer.cpp -o history_transfer
+//   ./history_transfer /dev/ttyACM0 export history.bin
+//   ./history_transfer /dev/ttyACM0 import history.bin
+//
+// The file holds the INFO body, the raw image and the END body (its CRC), so
+// a damaged file is refused before anything is sent. Import only goes to a
+// board with the same store and journal layout. Telemetry
+// frames and text arriving during a transfer are skipped.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+#include "TelemetryProtocol.h"
+
+#define CHUNK_TIMEOUT_MS 1000
+#define END_TIMEOUT_MS 5000     // END waits for the header write and the reload
+#define MAX_RETRIES 5
+
+static const char* statusNames[] = {
+  "ok", "bad frame", "out of order", "incompatible store or layout", "write failed", "CRC mismatch", "timeout"
+};
+
+static uint8_t sequence = 0;
+
+static double seconds() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static int openPort(const char* path) {
+  int fd = open(path, O_RDWR | O_NOCTTY);
+  if (fd < 0) {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    return -1;
+  }
+  termios tty;
+  if (tcgetattr(fd, &tty) == 0) {
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, B115200);
+    cfsetospeed(&tty, B115200);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tcsetattr(fd, TCSANOW, &tty);
+  }
+  tcflush(fd, TCIFLUSH);  // Drop whatever the clock printed before
+  return fd;
+}
+
+static bool writeAll(int fd, const void* data, size_t length) {
+  const uint8_t* bytes = (const uint8_t*)data;
+  while (length > 0) {
+    ssize_t n = write(fd, bytes, length);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    bytes += n;
+    length -= n;
+  }
+  return true;
+}
+
+static bool sendFrame(int fd, uint8_t type, const void* body, uint8_t length) {
+  uint8_t frame[TELEMETRY_MAX_FRAME + 1];
+  frame[0] = 0;  // Ends any stray bytes ahead of the frame
+  uint8_t frameLength = telemetryEncodeFrame(type, TELEMETRY_HISTORY_VERSION, sequence++, body, length, frame + 1);
+  return writeAll(fd, frame, frameLength + 1);
+}
+
+// Next valid frame within timeoutMs: header and body length, or -1 on timeout.
+// Malformed frames and text are skipped.
+static int readFrame(int fd, uint8_t* raw, int timeoutMs) {
+  static uint8_t encoded[512];
+  static size_t length = 0;
+  double deadline = seconds() + timeoutMs / 1000.0;
+  while (true) {
+    int remaining = (int)((deadline - seconds()) * 1000);
+    pollfd p = {fd, POLLIN, 0};
+    if (remaining <= 0 || poll(&p, 1, remaining) <= 0) {
+      return -1;
+    }
+    uint8_t c;
+    if (read(fd, &c, 1) != 1) {
+      continue;
+    }
+    if (c != 0) {
+      if (length < sizeof(encoded)) encoded[length++] = c;
+      continue;
+    }
+    size_t rawLength = length <= TELEMETRY_MAX_FRAME ? telemetryDecodeFrame(encoded, length, raw) : 0;
+    length = 0;
+    if (rawLength > 0) {
+      return (int)rawLength;
+    }
+  }
+}
+
+// Waits for the device's next ACK; false on timeout
+static bool readAck(int fd, TelemetryHistoryAck& ack, int timeoutMs) {
+  uint8_t raw[512];
+  double deadline = seconds() + timeoutMs / 1000.0;
+  while (true) {
+    int remaining = (int)((deadline - seconds()) * 1000);
+    int length = remaining > 0 ? readFrame(fd, raw, remaining) : -1;
+    if (length < 0) return false;
+    if (raw[0] == TELEMETRY_HISTORY_ACK && raw[1] == TELEMETRY_HISTORY_VERSION &&
+        length == TELEMETRY_HEADER_SIZE + (int)sizeof(ack)) {
+      memcpy(&ack, raw + TELEMETRY_HEADER_SIZE, sizeof(ack));
+      return true;
+    }
+  }
+}
+
+static const char* statusName(uint8_t status) {
+  return status < sizeof(statusNames) / sizeof(statusNames[0]) ? statusNames[status] : "unknown status";
+}
+
+static uint16_t imageCrc(const std::vector<uint8_t>& image) {
+  uint16_t crc = CRC16_INIT;
+  for (size_t i = 0; i < image.size(); i++) crc = crc16Update(crc, image[i]);
+  return crc;
+}
+
+static int exportHistory(int fd, const char* path) {
+  double start = seconds();
+  writeAll(fd, "export\n", 7);
+
+  TelemetryHistoryInfo info;
+  bool started = false;
+  std::vector<uint8_t> image;
+  uint8_t raw[512];
+  while (true) {
+    int length = readFrame(fd, raw, CHUNK_TIMEOUT_MS * 2);
+    if (length < 0) {
+      fprintf(stderr, "export: timed out after %zu bytes\n", image.size());
+      return 1;
+    }
+    if (raw[1] != TELEMETRY_HISTORY_VERSION) continue;
+    const uint8_t* body = raw + TELEMETRY_HEADER_SIZE;
+    int bodyLength = length - TELEMETRY_HEADER_SIZE;
+
+    if (raw[0] == TELEMETRY_HISTORY_INFO && bodyLength == (int)sizeof(info)) {
+      memcpy(&info, body, sizeof(info));
+      image.clear();
+      started = true;
+    } else if (raw[0] == TELEMETRY_HISTORY_CHUNK && bodyLength == (int)sizeof(TelemetryHistoryChunk) && started) {
+      TelemetryHistoryChunk chunk;
+      memcpy(&chunk, body, sizeof(chunk));
+      if (chunk.offset != image.size()) {
+        fprintf(stderr, "export: chunk at %u, expected %zu\n", chunk.offset, image.size());
+        return 1;
+      }
+      image.insert(image.end(), chunk.data, chunk.data + sizeof(chunk.data));
+    } else if (raw[0] == TELEMETRY_HISTORY_END && bodyLength == (int)sizeof(TelemetryHistoryEnd) && started) {
+      TelemetryHistoryEnd end;
+      memcpy(&end, body, sizeof(end));
+      if (image.size() != info.size || imageCrc(image) != end.crc) {
+        fprintf(stderr, "export: image incomplete or failed its CRC\n");
+        return 1;
+      }
+      break;
+    }
+  }
+
+  TelemetryHistoryEnd end;
+  end.crc = imageCrc(image);
+  FILE* file = fopen(path, "wb");
+  if (file == NULL || fwrite(&info, sizeof(info), 1, file) != 1 ||
+      fwrite(image.data(), 1, image.size(), file) != image.size() ||
+      fwrite(&end, sizeof(end), 1, file) != 1 || fclose(file) != 0) {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    return 1;
+  }
+  printf("exported %u bytes (%s store, layout %u) in %.2f s\n", info.size,
+         info.store == TELEMETRY_HISTORY_EXTERNAL ? "AT24C32" : "internal", info.layout, seconds() - start);
+  return 0;
+}
+
+static int importHistory(int fd, const char* path) {
+  TelemetryHistoryInfo info;
+  std::vector<uint8_t> image;
+  FILE* file = fopen(path, "rb");
+  if (file == NULL || fread(&info, sizeof(info), 1, file) != 1) {
+    fprintf(stderr, "%s: not a history image\n", path);
+    return 1;
+  }
+  TelemetryHistoryEnd end;
+  image.resize(info.size);
+  bool complete = fread(image.data(), 1, image.size(), file) == image.size() &&
+                  fread(&end, sizeof(end), 1, file) == 1 && fgetc(file) == EOF;
+  fclose(file);
+  if (!complete || info.size % TELEMETRY_HISTORY_CHUNK_SIZE != 0) {
+    fprintf(stderr, "%s: truncated or wrong size\n", path);
+    return 1;
+  }
+  if (imageCrc(image) != end.crc) {
+    fprintf(stderr, "%s: image fails its CRC\n", path);
+    return 1;
+  }
+
+  double start = seconds();
+  writeAll(fd, "import\n", 7);
+  TelemetryHistoryAck ack;
+  if (!readAck(fd, ack, CHUNK_TIMEOUT_MS * 2) || ack.status != HISTORY_OK) {
+    fprintf(stderr, "import: no answer to the import command\n");
+    return 1;
+  }
+
+  // INFO, then chunks from wherever the device says it is, then END. The
+  // device reports the next offset it wants in every ACK.
+  uint32_t offset = 0;
+  bool infoAccepted = false;
+  int retries = 0;
+  unsigned resends = 0;
+  while (true) {
+    bool sent;
+    int timeout = CHUNK_TIMEOUT_MS;
+    if (!infoAccepted) {
+      sent = sendFrame(fd, TELEMETRY_HISTORY_INFO, &info, sizeof(info));
+    } else if (offset < info.size) {
+      TelemetryHistoryChunk chunk;
+      chunk.offset = offset;
+      memcpy(chunk.data, &image[offset], sizeof(chunk.data));
+      sent = sendFrame(fd, TELEMETRY_HISTORY_CHUNK, &chunk, sizeof(chunk));
+    } else {
+      sent = sendFrame(fd, TELEMETRY_HISTORY_END, &end, sizeof(end));
+      timeout = END_TIMEOUT_MS;
+    }
+    if (!sent) {
+      fprintf(stderr, "import: write failed: %s\n", strerror(errno));
+      return 1;
+    }
+
+    if (!readAck(fd, ack, timeout) || ack.status == HISTORY_BAD_FRAME) {
+      if (++retries > MAX_RETRIES) {
+        fprintf(stderr, "import: no progress at offset %u\n", offset);
+        return 1;
+      }
+      resends++;
+      continue;
+    }
+    if (ack.status != HISTORY_OK && ack.status != HISTORY_OUT_OF_ORDER) {
+      fprintf(stderr, "import: device reports %s at offset %u\n", statusName(ack.status), ack.next);
+      return 1;
+    }
+    if (!infoAccepted) {
+      infoAccepted = true;
+    } else if (offset >= info.size && ack.status == HISTORY_OK) {
+      break;  // END accepted: the image is written and loaded
+    }
+    offset = ack.next;
+    retries = 0;
+  }
+
+  printf("imported %u bytes in %.2f s (%u resends)\n", info.size, seconds() - start, resends);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 4 || (strcmp(argv[2], "export") != 0 && strcmp(argv[2], "import") != 0)) {
+    fprintf(stderr, "usage: %s <serial port> export|import <file>\n", argv[0]);
+    return 2;
+  }
+  int fd = openPort(argv[1]);
+  if (fd < 0) {
+    return 1;
+  }
+  int result = strcmp(argv[2], "export") == 0 ? exportHistory(fd, argv[3]) : importHistory(fd, argv[3]);
+  close(fd);
+  return result;
+}
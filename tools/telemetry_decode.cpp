@@ -0,0 +1,202 @@
+// Host-side decoder for the binary telemetry stream (include/TelemetryProtocol.h).
+// Reads the raw serial capture on stdin and writes one CSV row per frame:
+//
+//   g++ -std=c++11 -Iinclude -Ilib/HybridClock tools/telemetry_decode.cpp -o telemetry_decode
+//   cat /dev/ttyACM0 | ./telemetry_decode > telemetry.csv
+//   ./telemetry_decode --catalog     # the log string table, one row per ID
+//
+// The first column is the message type; each type has the fixed columns
+// listed in the header comment it prints. Log messages are expanded from
+// the catalog (LogMessages.h) compiled in here, so build the decoder from
+// the same tree as the firmware. Frames that fail COBS or the CRC (e.g.
+// console text) are skipped, and a summary goes to stderr.
+
+#include <stdio.h>
+#include <string.h>
+#include "TelemetryProtocol.h"
+
+struct LogFormat {
+  const char* name;
+  int level;
+  const char* format;
+};
+
+static const LogFormat logCatalog[] = {
+#define LOG_MESSAGE(id, level, format) {#id, level, format},
+#include "LogMessages.h"
+#undef LOG_MESSAGE
+};
+static const unsigned logCatalogSize = sizeof(logCatalog) / sizeof(logCatalog[0]);
+static const char* levelNames[] = {"none", "error", "warning", "info", "debug"};
+
+static unsigned long frames = 0, badFrames = 0, unknownFrames = 0, sequenceGaps = 0, catalogMismatches = 0;
+static int lastSequence = -1;
+
+static void printTime(uint32_t time) {
+  printf("%04u-%02u-%02uT%02u:%02u:%02u", 2000 + (time >> 26), (time >> 22) & 0x0F, (time >> 17) & 0x1F,
+         (time >> 12) & 0x1F, (time >> 6) & 0x3F, time & 0x3F);
+}
+
+static double temperature(int16_t value) { return value / (double)TELEMETRY_TEMPERATURE_SCALE; }
+static double humidity(uint16_t value) { return value / (double)TELEMETRY_HUMIDITY_SCALE; }
+static double pressure(uint16_t value) { return value / (double)TELEMETRY_PRESSURE_SCALE + TELEMETRY_PRESSURE_OFFSET; }
+
+static void printLight(uint16_t value) {
+  if (value != TELEMETRY_NO_LIGHT) printf("%u", value);
+}
+
+// Copies the body out so unaligned packed fields are read safely
+template <typename T>
+static bool body(const uint8_t* raw, size_t length, T& message) {
+  if (length != TELEMETRY_HEADER_SIZE + sizeof(T)) return false;
+  memcpy(&message, raw + TELEMETRY_HEADER_SIZE, sizeof(T));
+  return true;
+}
+
+// Conversions in a format, not counting %%
+static int countConversions(const char* format) {
+  int count = 0;
+  for (const char* p = format; *p; p++) {
+    if (*p != '%') continue;
+    if (p[1] == '%') p++;
+    else count++;
+  }
+  return count;
+}
+
+// One CSV field, quoted, with the message's arguments filled in
+static void printLogText(const LogFormat& entry, const int16_t* args, int count) {
+  char text[256];
+  if (countConversions(entry.format) == count) {
+    snprintf(text, sizeof(text), entry.format, args[0], args[1], args[2]);
+  } else {
+    // The catalog doesn't match the firmware: show what arrived
+    int n = snprintf(text, sizeof(text), "%s", entry.format);
+    for (int i = 0; i < count && n < (int)sizeof(text); i++) {
+      n += snprintf(text + n, sizeof(text) - n, " [%d]", args[i]);
+    }
+  }
+  putchar('"');
+  for (const char* p = text; *p; p++) {
+    if (*p == '"') putchar('"');
+    putchar(*p);
+  }
+  putchar('"');
+}
+
+static void decodeLog(uint8_t sequence, const uint8_t* raw, size_t length) {
+  TelemetryLog m;
+  int16_t args[TELEMETRY_LOG_MAX_ARGS] = {0, 0, 0};
+  size_t bodyLength = length - TELEMETRY_HEADER_SIZE;
+  if (bodyLength < 1 || bodyLength > sizeof(m) || (bodyLength - 1) % 2 != 0) {
+    badFrames++;
+    return;
+  }
+  memcpy(&m, raw + TELEMETRY_HEADER_SIZE, bodyLength);
+  int count = (bodyLength - 1) / 2;
+  memcpy(args, m.args, count * sizeof(int16_t));
+
+  if (m.id >= logCatalogSize) {
+    catalogMismatches++;
+    printf("log,%u,,\"unknown log message %u\"\n", sequence, m.id);
+    return;
+  }
+  const LogFormat& entry = logCatalog[m.id];
+  if (m.id == 0 && count == 1 && args[0] != (int)logCatalogSize) {
+    fprintf(stderr, "firmware has %d log messages, this decoder %u - rebuild it from the firmware's tree\n",
+            args[0], logCatalogSize);
+    catalogMismatches++;
+  }
+  printf("log,%u,%s,", sequence, levelNames[entry.level]);
+  printLogText(entry, args, count);
+  printf("\n");
+}
+
+static void decodeFrame(const uint8_t* encoded, size_t length) {
+  uint8_t raw[256];
+  if (length == 0) return;
+  size_t rawLength = length <= sizeof(raw) ? telemetryDecodeFrame(encoded, length, raw) : 0;
+  if (rawLength == 0) {
+    badFrames++;
+    return;
+  }
+  frames++;
+
+  uint8_t type = raw[0], version = raw[1], sequence = raw[2];
+  if (lastSequence >= 0 && sequence != (uint8_t)(lastSequence + 1)) sequenceGaps++;
+  lastSequence = sequence;
+
+  if (type == TELEMETRY_SNAPSHOT && version == TELEMETRY_SNAPSHOT_VERSION) {
+    TelemetrySnapshot m;
+    if (!body(raw, rawLength, m)) { badFrames++; return; }
+    printf("snapshot,%u,", sequence);
+    printTime(m.time);
+    printf(",%u,%.2f,%.2f,%.2f,", m.validFlags, temperature(m.temperature), humidity(m.humidity), pressure(m.pressure));
+    printLight(m.light);
+    printf("\n");
+  } else if (type == TELEMETRY_HOURLY && version == TELEMETRY_HOURLY_VERSION) {
+    TelemetryHourly m;
+    if (!body(raw, rawLength, m)) { badFrames++; return; }
+    printf("hourly,%u,", sequence);
+    printTime(m.time);
+    printf(",%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,", temperature(m.avgTemperature), temperature(m.minTemperature),
+           temperature(m.maxTemperature), humidity(m.avgHumidity), pressure(m.avgPressure),
+           pressure(m.minPressure), pressure(m.maxPressure));
+    printLight(m.avgLight);
+    printf("\n");
+  } else if (type == TELEMETRY_PROFILE && version == TELEMETRY_PROFILE_VERSION) {
+    TelemetryProfile m;
+    if (!body(raw, rawLength, m)) { badFrames++; return; }
+    printf("profile,%u,%u,%u,%lu,%u,%u,%u,%u\n", sequence, m.loops, m.meanLoopMicros,
+           (unsigned long)m.maxLoopMicros, m.maxServiceMicros, m.dropped, m.i2cTimeouts, m.i2cRecoveries);
+  } else if (type == TELEMETRY_FAULT && version == TELEMETRY_FAULT_VERSION) {
+    TelemetryFault m;
+    if (!body(raw, rawLength, m)) { badFrames++; return; }
+    printf("fault,%u,", sequence);
+    printTime(m.time);
+    printf(",%u,%u,%u,%lu\n", m.source, m.health, m.totalFailures, (unsigned long)m.lastRecoveryMs);
+  } else if (type == TELEMETRY_LOG && version == TELEMETRY_LOG_VERSION) {
+    decodeLog(sequence, raw, rawLength);
+  } else if (type >= TELEMETRY_HISTORY_INFO && type <= TELEMETRY_HISTORY_ACK) {
+    // History transfers are read by tools/history_transfer.cpp
+  } else {
+    unknownFrames++;
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc == 2 && strcmp(argv[1], "--catalog") == 0) {
+    for (unsigned i = 0; i < logCatalogSize; i++) {
+      printf("%u,%s,%s,%s\n", i, logCatalog[i].name, levelNames[logCatalog[i].level], logCatalog[i].format);
+    }
+    return 0;
+  }
+
+  printf("# snapshot,seq,time,valid_flags,temperature_f,humidity_pct,pressure_hpa,light_lux\n");
+  printf("# hourly,seq,time,avg_temperature_f,min_temperature_f,max_temperature_f,avg_humidity_pct,"
+         "avg_pressure_hpa,min_pressure_hpa,max_pressure_hpa,avg_light_lux\n");
+  printf("# profile,seq,loops,mean_loop_us,max_loop_us,max_tx_service_us,dropped_frames,i2c_timeouts,i2c_recoveries\n");
+  printf("# fault,seq,time,source,health,total_failures,last_recovery_ms\n");
+  printf("# log,seq,level,message\n");
+
+  uint8_t frame[1024];
+  size_t length = 0;
+  bool overflow = false;
+  int c;
+  while ((c = getchar()) != EOF) {
+    if (c == 0) {
+      if (overflow) badFrames++;
+      else decodeFrame(frame, length);
+      length = 0;
+      overflow = false;
+    } else if (length < sizeof(frame)) {
+      frame[length++] = (uint8_t)c;
+    } else {
+      overflow = true;
+    }
+  }
+
+  fprintf(stderr, "%lu frames, %lu bad, %lu unknown type/version, %lu sequence gaps, %lu log catalog mismatches\n",
+          frames, badFrames, unknownFrames, sequenceGaps, catalogMismatches);
+  return 0;
+}